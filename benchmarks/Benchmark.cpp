@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "Benchmark.h"
+
+#include "Vortex/Common/Console.h"
+
+namespace Vortex::Benchmark {
+	Result Run(const BenchmarkEntry& entry, const Options& options) {
+		for (SizeType i = 0; i < options.WarmupCount; ++i) {
+			State state{entry.ItemCount};
+			entry.Fn(state);
+		}
+
+		std::vector<double> samples;
+		samples.reserve(options.RunCount);
+		for (SizeType i = 0; i < options.RunCount; ++i) {
+			State state{entry.ItemCount};
+			entry.Fn(state);
+
+			auto elapsed_ns = std::chrono::duration<double, std::nano>(state.GetElapsed()).count();
+			samples.push_back(elapsed_ns / static_cast<double>(entry.ItemCount > 0 ? entry.ItemCount : 1));
+		}
+		std::sort(samples.begin(), samples.end());
+
+		Result result{};
+		result.Name = entry.Name;
+		result.ItemCount = entry.ItemCount;
+		result.RunCount = samples.size();
+		if (samples.empty()) {
+			return result;
+		}
+
+		auto count = static_cast<double>(samples.size());
+		auto middle = samples.size() / 2;
+
+		result.Min = samples.front();
+		result.Max = samples.back();
+		result.Median = samples.size() % 2 == 0 ? (samples[middle - 1] + samples[middle]) / 2.0 : samples[middle];
+
+		double sum{0};
+		for (auto sample : samples) { sum += sample; }
+		result.Mean = sum / count;
+
+		double squared_sum{0};
+		for (auto sample : samples) { squared_sum += (sample - result.Mean) * (sample - result.Mean); }
+		result.StandardDeviation = samples.size() > 1 ? std::sqrt(squared_sum / (count - 1.0)) : 0.0;
+
+		return result;
+	}
+
+	void WriteJson(std::ostream& ostream, const std::vector<Result>& results) {
+		char line_buffer[1024];
+
+		// one benchmark per line, so ReadJson does not need a full json parser
+		ostream << "{\"benchmarks\":[\n";
+		for (SizeType i = 0; i < results.size(); ++i) {
+			const auto& result = results[i];
+			std::snprintf(line_buffer, sizeof(line_buffer),
+						  "{\"name\":\"%s\",\"items\":%zu,\"runs\":%zu,\"min_ns\":%.6g,\"median_ns\":%.6g,\"mean_ns\":%.6g,\"stddev_ns\":%.6g,\"max_ns\":%.6g}%s\n",
+						  result.Name.c_str(),
+						  result.ItemCount,
+						  result.RunCount,
+						  result.Min,
+						  result.Median,
+						  result.Mean,
+						  result.StandardDeviation,
+						  result.Max,
+						  i + 1 < results.size() ? "," : "");
+			ostream << line_buffer;
+		}
+		ostream << "]}\n";
+	}
+
+	static bool FindNumber(const std::string& line, const char* key, double& value) {
+		auto pattern = std::string{"\""} + key + "\":";
+		auto position = line.find(pattern);
+		if (position == std::string::npos) {
+			return false;
+		}
+		value = std::strtod(line.c_str() + position + pattern.size(), nullptr);
+		return true;
+	}
+
+	bool ReadJson(const std::filesystem::path& path, std::vector<Result>& results) {
+		std::ifstream file{path};
+		if (!file.is_open()) {
+			return false;
+		}
+
+		std::string line;
+		while (std::getline(file, line)) {
+			constexpr static const char* name_pattern = "{\"name\":\"";
+			auto name_begin = line.find(name_pattern);
+			if (name_begin == std::string::npos) {
+				continue;
+			}
+			name_begin += std::strlen(name_pattern);
+			auto name_end = line.find('"', name_begin);
+
+			Result result{};
+			result.Name = line.substr(name_begin, name_end - name_begin);
+
+			double items{0}, runs{0};
+			bool out{true};
+			out &= FindNumber(line, "items", items);
+			out &= FindNumber(line, "runs", runs);
+			out &= FindNumber(line, "min_ns", result.Min);
+			out &= FindNumber(line, "median_ns", result.Median);
+			out &= FindNumber(line, "mean_ns", result.Mean);
+			out &= FindNumber(line, "stddev_ns", result.StandardDeviation);
+			out &= FindNumber(line, "max_ns", result.Max);
+			if (!out) {
+				continue;
+			}
+
+			result.ItemCount = static_cast<SizeType>(items);
+			result.RunCount = static_cast<SizeType>(runs);
+			results.push_back(result);
+		}
+		return true;
+	}
+
+	SizeType Compare(std::ostream& ostream, const std::vector<Result>& results, const std::vector<Result>& baseline, double threshold) {
+		char line_buffer[1024];
+		SizeType regression_count{0};
+
+		std::snprintf(line_buffer, sizeof(line_buffer), "%-48s | %-14s | %-14s | %-10s | %s\n",
+					  "Benchmark", "Baseline (ns)", "Current (ns)", "Change", "Status");
+		ostream << line_buffer;
+
+		for (const auto& result : results) {
+			auto it = std::find_if(baseline.begin(), baseline.end(), [&](const Result& base) { return base.Name == result.Name; });
+			if (it == baseline.end()) {
+				std::snprintf(line_buffer, sizeof(line_buffer), "%-48s | %-14s | %-14.3f | %-10s | new\n",
+							  result.Name.c_str(), "-", result.Median, "-");
+				ostream << line_buffer;
+				continue;
+			}
+
+			auto change = (result.Median - it->Median) / it->Median;
+			// a change only counts if it is above the threshold and outside both runs' noise
+			auto noise = 2.0 * std::max(result.StandardDeviation, it->StandardDeviation);
+			auto difference = result.Median - it->Median;
+
+			const char* status = "ok";
+			if (change > threshold && difference > noise) {
+				status = "REGRESSION";
+				++regression_count;
+			} else if (change < -threshold && -difference > noise) {
+				status = "improved";
+			}
+
+			std::snprintf(line_buffer, sizeof(line_buffer), "%-48s | %-14.3f | %-14.3f | %+9.1f%% | %s\n",
+						  result.Name.c_str(), it->Median, result.Median, change * 100.0, status);
+			ostream << line_buffer;
+		}
+		return regression_count;
+	}
+
+	void WriteResultTable(std::ostream& ostream, const std::vector<Result>& results) {
+		char line_buffer[1024];
+		std::snprintf(line_buffer, sizeof(line_buffer), "%-48s | %-10s | %-12s | %-12s | %-12s | %-12s | %-12s\n",
+					  "Benchmark", "Items", "Min (ns)", "Median (ns)", "Mean (ns)", "StdDev (ns)", "Max (ns)");
+		ostream << line_buffer;
+
+		for (const auto& result : results) {
+			std::snprintf(line_buffer, sizeof(line_buffer), "%-48s | %-10zu | %-12.3f | %-12.3f | %-12.3f | %-12.3f | %-12.3f\n",
+						  result.Name.c_str(),
+						  result.ItemCount,
+						  result.Min,
+						  result.Median,
+						  result.Mean,
+						  result.StandardDeviation,
+						  result.Max);
+			ostream << line_buffer;
+		}
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string argument{argv[i]};
+			bool has_value = i + 1 < argc;
+
+			if (argument == "--filter" && has_value) {
+				options.Filter = argv[++i];
+			} else if (argument == "--runs" && has_value) {
+				options.RunCount = std::strtoull(argv[++i], nullptr, 10);
+			} else if (argument == "--warmup" && has_value) {
+				options.WarmupCount = std::strtoull(argv[++i], nullptr, 10);
+			} else if (argument == "--json" && has_value) {
+				options.JsonPath = argv[++i];
+			} else if (argument == "--baseline" && has_value) {
+				options.BaselinePath = argv[++i];
+			} else if (argument == "--threshold" && has_value) {
+				options.RegressionThreshold = std::strtod(argv[++i], nullptr);
+			} else {
+				std::cerr << "Unknown argument: " << argument << "\n"
+						  << "Usage: VortexBenchmarks [--filter text] [--runs N] [--warmup N] [--json file] [--baseline file] [--threshold 0.10]\n";
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv) {
+	using namespace Vortex::Benchmark;
+
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		return 2;
+	}
+
+	// engine code logs through the global console (LineRenderer, ThreadPool)
+	Vortex::Console::Initialize();
+
+	Registry registry;
+	RegisterCommonBenchmarks(registry);
+	RegisterCoreBenchmarks(registry);
+	RegisterMathBenchmarks(registry);
+	RegisterGraphicsBenchmarks(registry);
+	RegisterIOBenchmarks(registry);
+
+	std::vector<Result> results;
+	for (const auto& entry : registry.GetEntries()) {
+		if (!options.Filter.empty() && entry.Name.find(options.Filter) == std::string::npos) {
+			continue;
+		}
+		std::cerr << "Running " << entry.Name << "\n";
+		results.push_back(Run(entry, options));
+	}
+
+	// some benchmarks write to stdout themselves (Console), so report only after all of them ran
+	Vortex::Console::Shutdown();
+
+	std::cout << "\n\nVortex Benchmarks (" << options.RunCount << " runs, " << options.WarmupCount << " warmup)\n";
+	WriteResultTable(std::cout, results);
+
+	if (!options.JsonPath.empty()) {
+		std::ofstream file{options.JsonPath};
+		WriteJson(file, results);
+	}
+
+	if (!options.BaselinePath.empty()) {
+		std::vector<Result> baseline;
+		if (!ReadJson(options.BaselinePath, baseline)) {
+			std::cerr << "Could not read baseline " << options.BaselinePath << "\n";
+			return 2;
+		}
+
+		std::cout << "\nComparison against " << options.BaselinePath.string() << " (threshold " << options.RegressionThreshold * 100.0 << "%)\n";
+		auto regression_count = Compare(std::cout, results, baseline, options.RegressionThreshold);
+		if (regression_count > 0) {
+			std::cout << regression_count << " regression(s) found.\n";
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,123 @@
+//	Benchmark.h - Vortex Engine
+//
+//	Minimal headless benchmark runner used by VortexBenchmarks.
+//	Each benchmark is a function that processes ItemCount items per run and wraps the part
+//	worth timing in State::Measure, so per-run setup is not measured:
+//
+//		registry.Add("HandleMap/Insert", 10000, [](Vortex::Benchmark::State& state) {
+//			Map map;                                   // not measured
+//			state.Measure([&]() {
+//				for (Vortex::SizeType i = 0; i < state.GetItemCount(); ++i) { map.Insert(i); }
+//			});
+//		});
+//
+//	Results are reported in nanoseconds per item.
+//
+//	Usage: VortexBenchmarks [--filter text] [--runs N] [--warmup N]
+//	                        [--json results.json] [--baseline baseline.json] [--threshold 0.10]
+//
+//	With --baseline, medians are compared against a previous --json output and the process exits
+//	with 1 if any benchmark got slower than threshold (relative) and outside of its run-to-run noise.
+
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "Vortex/Memory/Memory.h"
+
+namespace Vortex::Benchmark {
+	using ClockType = std::chrono::steady_clock;
+
+	class State {
+	public:
+		explicit State(SizeType item_count): m_ItemCount{item_count}, m_Elapsed{0} {}
+
+	public:
+		template<typename Fn>
+		inline void Measure(Fn&& fn) {
+			auto begin = ClockType::now();
+			fn();
+			m_Elapsed += ClockType::now() - begin;
+		}
+
+		inline SizeType GetItemCount() const { return m_ItemCount; }
+		inline ClockType::duration GetElapsed() const { return m_Elapsed; }
+
+	private:
+		SizeType m_ItemCount;
+		ClockType::duration m_Elapsed;
+	};
+
+	using BenchmarkFn = std::function<void(State&)>;
+
+	struct BenchmarkEntry {
+		std::string Name;
+		SizeType ItemCount;
+		BenchmarkFn Fn;
+	};
+
+	struct Result {
+		std::string Name;
+		SizeType ItemCount;
+		SizeType RunCount;
+
+		// nanoseconds per item
+		double Min;
+		double Median;
+		double Mean;
+		double StandardDeviation;
+		double Max;
+	};
+
+	class Registry {
+	public:
+		inline void Add(std::string name, SizeType item_count, BenchmarkFn fn) {
+			m_Entries.push_back(BenchmarkEntry{std::move(name), item_count, std::move(fn)});
+		}
+		inline const std::vector<BenchmarkEntry>& GetEntries() const { return m_Entries; }
+
+	private:
+		std::vector<BenchmarkEntry> m_Entries;
+	};
+
+	struct Options {
+		std::string Filter;
+		SizeType WarmupCount{2};
+		SizeType RunCount{10};
+
+		std::filesystem::path JsonPath;
+		std::filesystem::path BaselinePath;
+		double RegressionThreshold{0.10};
+	};
+
+	Result Run(const BenchmarkEntry& entry, const Options& options);
+
+	void WriteJson(std::ostream& ostream, const std::vector<Result>& results);
+	bool ReadJson(const std::filesystem::path& path, std::vector<Result>& results);
+
+	// returns number of regressions
+	SizeType Compare(std::ostream& ostream, const std::vector<Result>& results, const std::vector<Result>& baseline, double threshold);
+
+	// Keeps the optimizer from removing benchmarked work.
+	template<typename T>
+	inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+}
+
+// one per benchmark source file
+namespace Vortex::Benchmark {
+	void RegisterCommonBenchmarks(Registry& registry);
+	void RegisterCoreBenchmarks(Registry& registry);
+	void RegisterMathBenchmarks(Registry& registry);
+	void RegisterGraphicsBenchmarks(Registry& registry);
+	void RegisterIOBenchmarks(Registry& registry);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <algorithm>
+#include <tuple>
+
+#include "Null/NullRenderer.h"
+
+namespace Vortex::Benchmark {
+	// Headless renderer with access to the recorded commands, so sorting can be measured on its own.
+	class BenchmarkRenderer: public Graphics::NullRenderer {
+	public:
+		using DrawCommandContainer = std::vector<DrawCommand>;
+
+	public:
+		inline DrawCommandContainer& GetDrawCommands() { return m_DrawCommands; }
+		inline void Sort() { SortDrawCommands(); }
+		inline void MergeSubmissions() { MergeSubmitContexts(); }
+
+		// the previous std::sort over whole commands, kept as the comparison for the radix sort
+		inline void SortComparison() {
+			WriteDrawDepths(m_DrawCommands.data(), m_DrawCommands.size());
+			std::sort(
+				m_DrawCommands.begin(), m_DrawCommands.end(),
+				[](const DrawCommand& lhs, const DrawCommand& rhs) {
+					return std::tie(lhs.DrawHandle, lhs.Key) < std::tie(rhs.DrawHandle, rhs.Key);
+				}
+			);
+		}
+	};
+}
@@ -0,0 +1,329 @@
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <random>
+
+#include "Benchmark.h"
+
+#include "Vortex/Common/Console.h"
+#include "Vortex/Common/HandleMap.h"
+#include "Vortex/Common/IntegerPacker.h"
+#include "Vortex/Common/Signal.h"
+#include "Vortex/Common/StrongHandleMap.h"
+#include "Vortex/Common/ThreadPool.h"
+
+namespace Vortex::Benchmark {
+	struct BenchmarkTransform {
+		float Position[3];
+		float Rotation[4];
+		float Scale[3];
+	};
+
+	// HandleMap ids are 10 bits wide
+	constexpr static SizeType HandleMapItemCount = 1000;
+	constexpr static SizeType StrongHandleMapItemCount = 100000;
+
+	void RegisterHandleMapBenchmarks(Registry& registry) {
+		using Map = HandleMap<BenchmarkTransform, UInt64>;
+
+		registry.Add("HandleMap/Insert", HandleMapItemCount, [](State& state) {
+			Map map;
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					DoNotOptimize(map.Insert<BenchmarkTransform>(BenchmarkTransform{}));
+				}
+			});
+		});
+
+		registry.Add("HandleMap/Get", HandleMapItemCount, [](State& state) {
+			Map map;
+			std::vector<Map::Handle> handles;
+			for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+				handles.push_back(map.Insert<BenchmarkTransform>(BenchmarkTransform{}));
+			}
+			std::shuffle(handles.begin(), handles.end(), std::mt19937{42});
+
+			state.Measure([&]() {
+				float sum{0};
+				for (auto handle : handles) {
+					sum += map.Get<BenchmarkTransform>(handle).Position[0];
+				}
+				DoNotOptimize(sum);
+			});
+		});
+
+		registry.Add("HandleMap/Is", HandleMapItemCount, [](State& state) {
+			Map map;
+			std::vector<Map::Handle> handles;
+			for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+				handles.push_back(i % 2 == 0 ? map.Insert<BenchmarkTransform>(BenchmarkTransform{}) : map.Insert<UInt64>(i));
+			}
+
+			state.Measure([&]() {
+				SizeType count{0};
+				for (auto handle : handles) {
+					count += map.Is<BenchmarkTransform>(handle);
+				}
+				DoNotOptimize(count);
+			});
+		});
+
+		registry.Add("HandleMap/Destroy", HandleMapItemCount, [](State& state) {
+			Map map;
+			std::vector<Map::Handle> handles;
+			for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+				handles.push_back(map.Insert<BenchmarkTransform>(BenchmarkTransform{}));
+			}
+
+			state.Measure([&]() {
+				for (auto handle : handles) {
+					map.Destroy(handle);
+				}
+			});
+		});
+
+		registry.Add("StrongHandleMap/Insert", StrongHandleMapItemCount, [](State& state) {
+			StrongHandleMap<BenchmarkTransform> map;
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					DoNotOptimize(map.Insert(BenchmarkTransform{}));
+				}
+			});
+		});
+
+		registry.Add("StrongHandleMap/Get", StrongHandleMapItemCount, [](State& state) {
+			StrongHandleMap<BenchmarkTransform> map;
+			std::vector<StrongHandle::Handle<BenchmarkTransform>> handles;
+			for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+				handles.push_back(map.Insert(BenchmarkTransform{}));
+			}
+			std::shuffle(handles.begin(), handles.end(), std::mt19937{42});
+
+			state.Measure([&]() {
+				float sum{0};
+				for (auto handle : handles) {
+					sum += map.Get(handle).Position[0];
+				}
+				DoNotOptimize(sum);
+			});
+		});
+
+		registry.Add("StrongHandleMap/Destroy", StrongHandleMapItemCount, [](State& state) {
+			StrongHandleMap<BenchmarkTransform> map;
+			std::vector<StrongHandle::Handle<BenchmarkTransform>> handles;
+			for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+				handles.push_back(map.Insert(BenchmarkTransform{}));
+			}
+
+			state.Measure([&]() {
+				for (auto handle : handles) {
+					map.Destroy(handle);
+				}
+			});
+		});
+	}
+
+	void RegisterThreadPoolBenchmarks(Registry& registry) {
+		constexpr static SizeType task_count = 10000;
+
+		registry.Add("ThreadPool/DoTask", task_count, [](State& state) {
+			ThreadPool thread_pool;
+			std::atomic<SizeType> counter{0};
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					thread_pool.DoTask([&counter]() { ++counter; });
+				}
+				thread_pool.Dispatch().Await();
+			});
+			DoNotOptimize(counter.load());
+		});
+
+		// same work split over a growing number of threads
+		constexpr static SizeType element_count = 1 << 20;
+		for (SizeType thread_count : {1, 2, 4, 8}) {
+			auto name = "ThreadPool/Foreach/" + std::to_string(thread_count) + "Threads";
+			registry.Add(name, element_count, [thread_count](State& state) {
+				ThreadPool thread_pool{thread_count};
+				std::vector<float> values(state.GetItemCount(), 1.0f);
+
+				state.Measure([&]() {
+					thread_pool.Foreach<float>(values.data(), values.size(), [](SizeType index, float& value) {
+						value = value * 0.5f + static_cast<float>(index & 7);
+					});
+					thread_pool.Dispatch().Await();
+				});
+				DoNotOptimize(values.data());
+			});
+		}
+	}
+
+	void RegisterIntegerPackerBenchmarks(Registry& registry) {
+		constexpr static SizeType key_count = 1 << 16;
+		using Packer = IntegerPacker<UInt64, 28, 16, 2, 16, 2>; // Renderer's opaque draw key layout
+
+		registry.Add("IntegerPacker/Pack", key_count, [](State& state) {
+			std::vector<UInt64> keys(state.GetItemCount());
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < keys.size(); ++i) {
+					UInt64 key{0};
+					Packer::Pack<0>(key, i & Packer::GetMaxValue<0>());
+					Packer::Pack<1>(key, (i * 7) & Packer::GetMaxValue<1>());
+					Packer::Pack<2>(key, i & Packer::GetMaxValue<2>());
+					Packer::Pack<3>(key, (i * 13) & Packer::GetMaxValue<3>());
+					Packer::Pack<4>(key, (i >> 3) & Packer::GetMaxValue<4>());
+					keys[i] = key;
+				}
+			});
+			DoNotOptimize(keys.data());
+		});
+
+		registry.Add("IntegerPacker/Unpack", key_count, [](State& state) {
+			std::vector<UInt64> keys(state.GetItemCount());
+			std::mt19937_64 random{42};
+			for (auto& key : keys) { key = random(); }
+
+			state.Measure([&]() {
+				UInt64 sum{0};
+				for (auto key : keys) {
+					sum += Packer::Unpack<0>(key) + Packer::Unpack<1>(key) + Packer::Unpack<2>(key) + Packer::Unpack<3>(key) + Packer::Unpack<4>(key);
+				}
+				DoNotOptimize(sum);
+			});
+		});
+	}
+
+	void RegisterConsoleBenchmarks(Registry& registry) {
+		constexpr static SizeType log_count = 10000;
+
+		registry.Add("Console/WriteFormat", log_count, [](State& state) {
+			auto log_path = std::filesystem::temp_directory_path() / "VortexBenchmarkConsole.txt";
+			Console console{log_path, 100, Console::DefaultRecordCapacity, OverflowPolicy::Block};
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					console.WriteFormat(EntryType::Info, "Benchmark entry %zu value %f", i, 0.5f * static_cast<float>(i));
+				}
+				console.Flush();
+			});
+		});
+
+		// cost seen by the calling thread, the writer thread catches up outside the measured region
+		registry.Add("Console/WriteFormat/Caller", log_count, [](State& state) {
+			auto log_path = std::filesystem::temp_directory_path() / "VortexBenchmarkConsole.txt";
+			Console console{log_path, 100, 2 * state.GetItemCount(), OverflowPolicy::Block};
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					console.WriteFormat(EntryType::Info, "Benchmark entry %zu value %f", i, 0.5f * static_cast<float>(i));
+				}
+			});
+			console.Flush();
+		});
+
+		// deferred formatting as VORTEX_LOG does it, only the argument copy is on the caller.
+		// The ring holds every record like WriteFormat/Caller, so the writer thread never throttles the caller.
+		registry.Add("Console/WriteDeferred/Caller", log_count, [](State& state) {
+			auto log_path = std::filesystem::temp_directory_path() / "VortexBenchmarkConsole.txt";
+			Console console{log_path, 100, 2 * state.GetItemCount(), OverflowPolicy::Block};
+			static const UInt32 format_id = LogFormat::RegisterFormat("Benchmark entry %zu value %f");
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					if (console.IsEnabled(LogCategory::General, EntryType::Info)) {
+						console.WriteDeferred(LogCategory::General, EntryType::Info, format_id, i, 0.5f * static_cast<float>(i));
+					}
+				}
+			});
+			console.Flush();
+		});
+	}
+
+	struct BenchmarkReceiver {
+		float Sum{0};
+		void OnValue(float value) { Sum += value; }
+	};
+
+	void RegisterSignalBenchmarks(Registry& registry) {
+		constexpr static SizeType emit_count = 1000;
+
+		for (SizeType receiver_count : {1, 10, 1000}) {
+			auto suffix = std::to_string(receiver_count) + "Receivers";
+
+			// items are emits, receivers are half bound member functions, half lambdas
+			registry.Add("Signal/Emit/" + suffix, emit_count, [receiver_count](State& state) {
+				std::vector<BenchmarkReceiver> receivers(receiver_count);
+				Signal<float> signal;
+				for (SizeType i = 0; i < receiver_count; ++i) {
+					auto* receiver = &receivers[i];
+					if (i % 2 == 0) {
+						signal.Connect<&BenchmarkReceiver::OnValue>(receiver);
+					} else {
+						signal.Connect([receiver](float value) { receiver->Sum -= value; });
+					}
+				}
+
+				state.Measure([&]() {
+					for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+						signal(static_cast<float>(i));
+					}
+				});
+				DoNotOptimize(receivers.data());
+			});
+
+			// previous Signal layout: std::function slots with holes, null checked on emit
+			registry.Add("Signal/Emit/StdFunction/" + suffix, emit_count, [receiver_count](State& state) {
+				std::vector<BenchmarkReceiver> receivers(receiver_count);
+				std::vector<std::function<void(float)>> connections;
+				for (SizeType i = 0; i < receiver_count; ++i) {
+					auto* receiver = &receivers[i];
+					if (i % 2 == 0) {
+						connections.emplace_back([receiver](float value) { receiver->OnValue(value); });
+					} else {
+						connections.emplace_back([receiver](float value) { receiver->Sum -= value; });
+					}
+				}
+
+				state.Measure([&]() {
+					for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+						for (const auto& connection : connections) {
+							if (connection != nullptr) {
+								connection(static_cast<float>(i));
+							}
+						}
+					}
+				});
+				DoNotOptimize(receivers.data());
+			});
+		}
+
+		constexpr static SizeType connection_count = 10000;
+		registry.Add("Signal/ConnectDisconnect", connection_count, [](State& state) {
+			BenchmarkReceiver receiver;
+			Signal<float> signal;
+			std::vector<Signal<float>::Handle> handles(state.GetItemCount());
+			std::vector<SizeType> order(state.GetItemCount());
+			for (SizeType i = 0; i < order.size(); ++i) { order[i] = i; }
+			std::shuffle(order.begin(), order.end(), std::mt19937{42});
+
+			state.Measure([&]() {
+				for (auto& handle : handles) {
+					handle = signal.Connect<&BenchmarkReceiver::OnValue>(&receiver);
+				}
+				for (auto index : order) {
+					signal.Disconnect(handles[index]);
+				}
+			});
+			DoNotOptimize(signal.Size());
+		});
+	}
+
+	void RegisterCommonBenchmarks(Registry& registry) {
+		RegisterHandleMapBenchmarks(registry);
+		RegisterThreadPoolBenchmarks(registry);
+		RegisterIntegerPackerBenchmarks(registry);
+		RegisterConsoleBenchmarks(registry);
+		RegisterSignalBenchmarks(registry);
+	}
+}
@@ -0,0 +1,294 @@
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+
+#include "Benchmark.h"
+
+#include "Vortex/Core/EventBus.h"
+#include "Vortex/Core/EventQueue.h"
+#include "Vortex/Core/Input.h"
+
+namespace Vortex::Benchmark {
+	constexpr static SizeType EventCount = 1 << 16;
+
+	// Producers start together and retry on a full queue, the consumer drains in per-frame sized batches
+	// until every event arrived. Measures throughput from the first post to the last event handled.
+	template<typename PostFn, typename DrainFn>
+	static void RunProducers(State& state, SizeType producer_count, PostFn&& post_fn, DrainFn&& drain_fn) {
+		std::atomic<bool> start{false};
+		std::vector<std::thread> producers;
+		producers.reserve(producer_count);
+
+		auto events_per_producer = state.GetItemCount() / producer_count;
+		for (SizeType producer = 0; producer < producer_count; ++producer) {
+			producers.emplace_back([&, producer]() {
+				while (!start.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+
+				for (SizeType i = 0; i < events_per_producer; ++i) {
+					auto event = Event::CreateMouseMove(static_cast<UInt16>(producer), static_cast<float>(i), 1.0f);
+					while (!post_fn(event)) { std::this_thread::yield(); }
+				}
+			});
+		}
+
+		std::vector<Event> batch;
+		batch.reserve(EventQueue::DefaultCapacity);
+		auto total_count = events_per_producer * producer_count;
+
+		state.Measure([&]() {
+			start.store(true, std::memory_order_release);
+
+			SizeType received_count{0};
+			float sum{0};
+			while (received_count < total_count) {
+				batch.clear();
+				auto count = drain_fn(batch);
+				if (count == 0) {
+					std::this_thread::yield(); // a frame would do other work here
+					continue;
+				}
+				received_count += count;
+				for (const auto& event : batch) {
+					sum += event.MouseMove.Delta.x;
+				}
+			}
+			DoNotOptimize(sum);
+		});
+
+		for (auto& producer : producers) {
+			producer.join();
+		}
+	}
+
+	void RegisterEventQueueBenchmarks(Registry& registry) {
+		registry.Add("EventQueue/Post", EventCount, [](State& state) {
+			EventQueue queue{state.GetItemCount()};
+			std::vector<Event> batch;
+			batch.reserve(queue.GetCapacity());
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					queue.Post(Event::CreateMouseMove(0, static_cast<float>(i), 1.0f), EventSource::Window);
+				}
+			});
+			queue.Drain(batch, queue.GetCapacity());
+			DoNotOptimize(batch.data());
+		});
+
+		for (SizeType producer_count : {1, 2, 4, 8}) {
+			auto name = "EventQueue/Drain/" + std::to_string(producer_count) + "Producers";
+			registry.Add(name, EventCount, [producer_count](State& state) {
+				EventQueue queue;
+				RunProducers(
+					state, producer_count,
+					[&queue](const Event& event) { return queue.Post(event, EventSource::User); },
+					[&queue](std::vector<Event>& batch) { return queue.Drain(batch, queue.GetCapacity()); }
+				);
+			});
+
+			// previous Application queue made thread safe, for comparison
+			auto mutex_name = "EventQueue/Drain/Mutex/" + std::to_string(producer_count) + "Producers";
+			registry.Add(mutex_name, EventCount, [producer_count](State& state) {
+				std::mutex mutex;
+				std::queue<Event> queue;
+				RunProducers(
+					state, producer_count,
+					[&](const Event& event) {
+						std::unique_lock lock{mutex};
+						queue.push(event);
+						return true;
+					},
+					[&](std::vector<Event>& batch) {
+						std::unique_lock lock{mutex};
+						SizeType count{0};
+						while (!queue.empty() && count < EventQueue::DefaultCapacity) {
+							batch.push_back(queue.front());
+							queue.pop();
+							++count;
+						}
+						return count;
+					}
+				);
+			});
+		}
+	}
+
+	// One 60 Hz frame of mouse input at a given polling rate, with a click and some scrolling in between.
+	static std::vector<Event> CreateInputFrame(SizeType polling_rate) {
+		std::vector<Event> frame;
+		auto move_count = polling_rate / 60;
+		for (SizeType i = 0; i < move_count; ++i) {
+			frame.push_back(Event::CreateMouseMove(0, static_cast<float>(i), static_cast<float>(i) * 0.5f));
+			if (i % 4 == 0) {
+				frame.push_back(Event::CreateScrollChange(0, 0.0f, 1.0f));
+			}
+			if (i == move_count / 2) {
+				frame.push_back(Event::CreateMousePress(0, MouseButton::Mouse1));
+				frame.push_back(Event::CreateMouseRelease(0, MouseButton::Mouse1));
+			}
+		}
+		return frame;
+	}
+
+	void RegisterInputBenchmarks(Registry& registry) {
+		constexpr static SizeType frame_count = 1000;
+
+		// per frame, should stay flat over the polling rate with coalescing
+		for (SizeType polling_rate : {125, 1000, 4000, 8000}) {
+			// items are the events a frame dispatches after coalescing
+			auto coalesced_frame = CreateInputFrame(polling_rate);
+			EventQueue::Coalesce(coalesced_frame);
+			registry.Add("Input/Coalesce/" + std::to_string(polling_rate) + "Hz", coalesced_frame.size(), [polling_rate](State& state) {
+				auto frame = CreateInputFrame(polling_rate);
+				std::vector<Event> batch;
+				batch.reserve(frame.size());
+
+				state.Measure([&]() {
+					batch.assign(frame.begin(), frame.end());
+					EventQueue::Coalesce(batch);
+				});
+				DoNotOptimize(batch.data());
+			});
+
+			for (bool coalesce : {true, false}) {
+				auto name = "Input/Frame/" + String{coalesce ? "" : "NoCoalesce/"} + std::to_string(polling_rate) + "Hz";
+				registry.Add(name, frame_count, [polling_rate, coalesce](State& state) {
+					auto frame = CreateInputFrame(polling_rate);
+					std::vector<Event> batch;
+					batch.reserve(frame.size());
+					EventBus event_bus;
+					Input input;
+					input.Subscribe(event_bus);
+
+					state.Measure([&]() {
+						for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+							batch.assign(frame.begin(), frame.end());
+							if (coalesce) {
+								EventQueue::Coalesce(batch);
+							}
+							for (const auto& event : batch) {
+								event_bus.Publish(event);
+							}
+							DoNotOptimize(input.GetCursorDelta());
+							input.Update();
+						}
+					});
+				});
+			}
+		}
+	}
+
+	// subsystem interested in one event type
+	class BenchmarkListener {
+	public:
+		explicit BenchmarkListener(EventType::Enum type): m_Type{type} {}
+		virtual ~BenchmarkListener() = default;
+
+		// previous dispatch: every subsystem sees every event and switches on the type
+		virtual void OnEvent(const Event& event) {
+			if (event.Type == m_Type) { m_Sum += event.MouseMove.Delta.x; }
+		}
+		void OnTypedEvent(const Event& event) { m_Sum += event.MouseMove.Delta.x; }
+		void OnTypedEvents(const Event* events, SizeType count) {
+			for (SizeType i = 0; i < count; ++i) { m_Sum += events[i].MouseMove.Delta.x; }
+		}
+
+		float GetSum() const { return m_Sum; }
+
+	private:
+		EventType::Enum m_Type;
+		float m_Sum{0};
+	};
+
+	void RegisterEventBusBenchmarks(Registry& registry) {
+		constexpr static SizeType event_count = 4096;
+		constexpr static EventType::Enum types[]{
+			EventType::KeyPress, EventType::KeyRelease, EventType::CharInput, EventType::MousePress,
+			EventType::MouseRelease, EventType::MouseMove, EventType::ScrollChange, EventType::WindowResize
+		};
+		constexpr static SizeType listener_count = sizeof(types) / sizeof(types[0]);
+
+		auto create_events = []() {
+			std::vector<Event> events(event_count);
+			std::mt19937 random{42};
+			for (SizeType i = 0; i < events.size(); ++i) {
+				events[i] = Event::CreateMouseMove(0, static_cast<float>(i), 0.0f);
+				events[i].Type = types[random() % listener_count];
+			}
+			return events;
+		};
+
+		registry.Add("EventBus/Broadcast", event_count, [create_events](State& state) {
+			auto events = create_events();
+			std::vector<std::unique_ptr<BenchmarkListener>> listeners;
+			for (auto type : types) { listeners.push_back(std::make_unique<BenchmarkListener>(type)); }
+
+			state.Measure([&]() {
+				for (const auto& event : events) {
+					for (auto& listener : listeners) {
+						listener->OnEvent(event);
+					}
+				}
+			});
+			DoNotOptimize(listeners.front()->GetSum());
+		});
+
+		registry.Add("EventBus/Publish", event_count, [create_events](State& state) {
+			auto events = create_events();
+			std::vector<std::unique_ptr<BenchmarkListener>> listeners;
+			EventBus event_bus;
+			for (auto type : types) {
+				listeners.push_back(std::make_unique<BenchmarkListener>(type));
+				event_bus.Subscribe<&BenchmarkListener::OnTypedEvent>(type, listeners.back().get());
+			}
+
+			state.Measure([&]() {
+				for (const auto& event : events) {
+					event_bus.Publish(event);
+				}
+			});
+			DoNotOptimize(listeners.front()->GetSum());
+		});
+
+		registry.Add("EventBus/Dispatch", event_count, [create_events](State& state) {
+			auto events = create_events();
+			std::vector<std::unique_ptr<BenchmarkListener>> listeners;
+			EventBus event_bus;
+			for (auto type : types) {
+				listeners.push_back(std::make_unique<BenchmarkListener>(type));
+				event_bus.Subscribe<&BenchmarkListener::OnTypedEvent>(type, listeners.back().get());
+			}
+
+			state.Measure([&]() {
+				event_bus.Enqueue(events.data(), events.size());
+				event_bus.Dispatch();
+			});
+			DoNotOptimize(listeners.front()->GetSum());
+		});
+
+		registry.Add("EventBus/Dispatch/Batch", event_count, [create_events](State& state) {
+			auto events = create_events();
+			std::vector<std::unique_ptr<BenchmarkListener>> listeners;
+			EventBus event_bus;
+			for (auto type : types) {
+				listeners.push_back(std::make_unique<BenchmarkListener>(type));
+				event_bus.SubscribeBatch<&BenchmarkListener::OnTypedEvents>(type, listeners.back().get());
+			}
+
+			state.Measure([&]() {
+				event_bus.Enqueue(events.data(), events.size());
+				event_bus.Dispatch();
+			});
+			DoNotOptimize(listeners.front()->GetSum());
+		});
+	}
+
+	void RegisterCoreBenchmarks(Registry& registry) {
+		RegisterEventQueueBenchmarks(registry);
+		RegisterInputBenchmarks(registry);
+		RegisterEventBusBenchmarks(registry);
+	}
+}
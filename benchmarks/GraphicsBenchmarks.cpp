@@ -0,0 +1,243 @@
+#include <random>
+
+#include "Benchmark.h"
+#include "BenchmarkRenderer.h"
+
+#include "Vortex/Common/ThreadPool.h"
+#include "Vortex/Graphics/LineRenderer.h"
+
+namespace Vortex::Benchmark {
+	// Graphics handles are 10 bit ids, so resources are shared between many draws
+	constexpr static SizeType SortMaterialCount = 64;
+	constexpr static SizeType SortMeshCount = 64;
+
+	struct RandomDraw {
+		Graphics::Handle DrawHandle;
+		Graphics::ViewLayer::Enum ViewLayer;
+		Graphics::Handle DrawSurfaceHandle;
+		Graphics::Handle MaterialHandle;
+		Math::Matrix4 Transform;
+		Graphics::Handle MeshHandle;
+	};
+
+	// instanced draws use one mesh per material, like props placed many times, otherwise meshes are random
+	// multi draw meshes are allocated from one mesh pool
+	static std::vector<RandomDraw> CreateRandomDraws(BenchmarkRenderer& renderer, SizeType draw_count, Graphics::ShaderTags::Enum shader_tags = Graphics::ShaderTags::Lit) {
+		auto window_handle = renderer.CreateWindow(Graphics::Resolution{1280, 720}, "Benchmark");
+		auto view_handle = renderer.GetDefaultView(window_handle);
+		auto draw_surface_handle = renderer.CreateDrawSurface(Math::RectangleInt{0, 0, 1280, 720});
+		auto shader_handle = renderer.CreateShader(nullptr, nullptr, 0, shader_tags);
+
+		std::vector<Graphics::Handle> materials;
+		for (SizeType i = 0; i < SortMaterialCount; ++i) {
+			auto blending = i % 4 == 0 ? Graphics::Blending::Additive : Graphics::Blending::Opaque;
+			materials.push_back(renderer.CreateMaterial(shader_handle, blending, nullptr));
+		}
+
+		auto mesh_layout = Graphics::CreateMeshLayout(Graphics::ElementType::Float3);
+		auto mesh_pool_handle = shader_tags == Graphics::ShaderTags::MultiDraw
+			? renderer.CreateMeshPool(Graphics::Topology::TriangleList, Graphics::BufferUsage::StaticDraw, mesh_layout, 3 * SortMeshCount, 3 * SortMeshCount)
+			: Graphics::Map::NullHandle;
+
+		std::vector<Graphics::Handle> meshes;
+		for (SizeType i = 0; i < SortMeshCount; ++i) {
+			if (mesh_pool_handle != Graphics::Map::NullHandle) {
+				meshes.push_back(renderer.CreateMesh(mesh_pool_handle, 3, 3));
+			} else {
+				meshes.push_back(renderer.CreateMesh(Graphics::Topology::TriangleList, Graphics::BufferUsage::StaticDraw, mesh_layout, 3, 3));
+			}
+		}
+
+		std::mt19937 random{42};
+		std::uniform_real_distribution<float> position{-500.0f, 500.0f};
+		std::uniform_int_distribution<SizeType> index{0, SortMaterialCount - 1};
+
+		std::vector<RandomDraw> draws;
+		draws.reserve(draw_count);
+		for (SizeType i = 0; i < draw_count; ++i) {
+			auto transform = Math::Matrix4::Identity();
+			transform.Translate3D(position(random), position(random), position(random));
+
+			auto material_index = index(random);
+			auto mesh_index = shader_tags == Graphics::ShaderTags::Instanced ? material_index : index(random);
+			draws.push_back(RandomDraw{
+				i % 8 == 0 ? window_handle : view_handle,
+				i % 16 == 0 ? Graphics::ViewLayer::HUD : Graphics::ViewLayer::World,
+				draw_surface_handle,
+				materials[material_index],
+				transform,
+				meshes[mesh_index % SortMeshCount]
+			});
+		}
+		return draws;
+	}
+
+	static void SubmitRandomDraws(BenchmarkRenderer& renderer, SizeType draw_count, Graphics::ShaderTags::Enum shader_tags = Graphics::ShaderTags::Lit) {
+		for (const auto& draw : CreateRandomDraws(renderer, draw_count, shader_tags)) {
+			renderer.SubmitDraw(draw.DrawHandle, draw.ViewLayer, draw.DrawSurfaceHandle, draw.MaterialHandle, draw.Transform, draw.MeshHandle);
+		}
+	}
+
+	// renderers keep their sort scratch between frames, measure the steady state and not the first allocation
+	static void WarmSortScratch(BenchmarkRenderer& renderer) {
+		auto draw_commands = renderer.GetDrawCommands();
+		renderer.Sort();
+		renderer.GetDrawCommands() = draw_commands;
+	}
+
+	void RegisterGraphicsBenchmarks(Registry& registry) {
+		for (SizeType draw_count : {1000, 10000, 100000, 1000000}) {
+			registry.Add("Renderer/SortDrawCommands/StdSort/" + std::to_string(draw_count), draw_count, [](State& state) {
+				BenchmarkRenderer renderer;
+				SubmitRandomDraws(renderer, state.GetItemCount());
+
+				state.Measure([&]() { renderer.SortComparison(); });
+				DoNotOptimize(renderer.GetDrawCommands().data());
+			});
+			registry.Add("Renderer/SortDrawCommands/Radix/" + std::to_string(draw_count), draw_count, [](State& state) {
+				BenchmarkRenderer renderer;
+				SubmitRandomDraws(renderer, state.GetItemCount());
+				WarmSortScratch(renderer);
+
+				state.Measure([&]() { renderer.Sort(); });
+				DoNotOptimize(renderer.GetDrawCommands().data());
+			});
+			registry.Add("Renderer/SortDrawCommands/RadixThreadPool/" + std::to_string(draw_count), draw_count, [](State& state) {
+				ThreadPool thread_pool;
+				BenchmarkRenderer renderer;
+				renderer.SetSortThreadPool(&thread_pool);
+				SubmitRandomDraws(renderer, state.GetItemCount());
+				WarmSortScratch(renderer);
+
+				state.Measure([&]() { renderer.Sort(); });
+				DoNotOptimize(renderer.GetDrawCommands().data());
+			});
+		}
+
+		// sort plus state filtering, the backend independent part of a frame
+		for (SizeType draw_count : {1000, 10000, 100000}) {
+			registry.Add("Renderer/NextFrame/" + std::to_string(draw_count), draw_count, [](State& state) {
+				BenchmarkRenderer renderer;
+				SubmitRandomDraws(renderer, state.GetItemCount());
+
+				state.Measure([&]() { renderer.NextFrame(); });
+				DoNotOptimize(renderer.GetLastFrameStats().StateChanges);
+			});
+			// instanced shader, runs of equal material and mesh become one draw
+			registry.Add("Renderer/NextFrame/Instanced/" + std::to_string(draw_count), draw_count, [](State& state) {
+				BenchmarkRenderer renderer;
+				SubmitRandomDraws(renderer, state.GetItemCount(), Graphics::ShaderTags::Instanced);
+
+				state.Measure([&]() { renderer.NextFrame(); });
+				DoNotOptimize(renderer.GetLastFrameStats().DrawCalls);
+			});
+			// multi draw shader, batches per shader and mesh pool, built into indirect commands on the CPU
+			registry.Add("Renderer/NextFrame/MultiDraw/" + std::to_string(draw_count), draw_count, [](State& state) {
+				BenchmarkRenderer renderer;
+				SubmitRandomDraws(renderer, state.GetItemCount(), Graphics::ShaderTags::MultiDraw);
+
+				state.Measure([&]() { renderer.NextFrame(); });
+				DoNotOptimize(renderer.GetLastFrameStats().DrawCalls);
+			});
+		}
+
+		// submission and merge, from the calling thread or from ThreadPool workers through their submit contexts
+		constexpr static SizeType submit_draw_count = 100000;
+		registry.Add("Renderer/Submit/CallingThread", submit_draw_count, [](State& state) {
+			BenchmarkRenderer renderer;
+			auto draws = CreateRandomDraws(renderer, state.GetItemCount());
+			auto submit = [&]() {
+				for (const auto& draw : draws) {
+					renderer.SubmitDraw(draw.DrawHandle, draw.ViewLayer, draw.DrawSurfaceHandle, draw.MaterialHandle, draw.Transform, draw.MeshHandle);
+				}
+				renderer.MergeSubmissions();
+			};
+
+			// buckets keep their capacity between frames, measure a frame after the first
+			submit();
+			renderer.GetDrawCommands().clear();
+			state.Measure(submit);
+			DoNotOptimize(renderer.GetDrawCommands().data());
+		});
+		for (SizeType thread_count : {1, 2, 4}) {
+			registry.Add("Renderer/Submit/SubmitContext/" + std::to_string(thread_count) + "Threads", submit_draw_count, [thread_count](State& state) {
+				ThreadPool thread_pool{thread_count};
+				BenchmarkRenderer renderer;
+				auto draws = CreateRandomDraws(renderer, state.GetItemCount());
+				auto submit = [&]() {
+					thread_pool.Foreach<RandomDraw>(draws, [&renderer](SizeType, RandomDraw& draw) {
+						renderer.GetSubmitContext().SubmitDraw(draw.DrawHandle, draw.ViewLayer, draw.DrawSurfaceHandle, draw.MaterialHandle, draw.Transform, draw.MeshHandle);
+					}).Dispatch().Await();
+					renderer.MergeSubmissions();
+				};
+
+				submit();
+				renderer.GetDrawCommands().clear();
+				state.Measure(submit);
+				DoNotOptimize(renderer.GetDrawCommands().data());
+			});
+		}
+
+		// simulation and submission on the calling thread, sorting as frame execution, serial against pipelined
+		constexpr static SizeType frame_draw_count = 10000;
+		for (SizeType frames_in_flight : {0, 1, 2}) {
+			registry.Add("Renderer/Frame/FramesInFlight/" + std::to_string(frames_in_flight), 64, [frames_in_flight](State& state) {
+				BenchmarkRenderer renderer;
+				SubmitRandomDraws(renderer, frame_draw_count);
+				auto draw_commands = renderer.GetDrawCommands();
+				renderer.GetDrawCommands().clear();
+				renderer.SetFramesInFlight(frames_in_flight);
+
+				std::mt19937 random{42};
+				std::uniform_real_distribution<float> offset{-1.0f, 1.0f};
+
+				state.Measure([&]() {
+					for (SizeType frame = 0; frame < state.GetItemCount(); ++frame) {
+						for (auto& cmd : draw_commands) {
+							cmd.TransformMatrix.Translate3D(offset(random), offset(random), offset(random));
+						}
+						renderer.GetDrawCommands().insert(renderer.GetDrawCommands().end(), draw_commands.begin(), draw_commands.end());
+						renderer.NextFrame();
+					}
+					renderer.WaitIdle();
+				});
+				renderer.SetFramesInFlight(0);
+			});
+		}
+
+		constexpr static SizeType grid_size = 64;
+		registry.Add("LineRenderer/Bake2DGrid", grid_size * grid_size, [](State& state) {
+			BenchmarkRenderer renderer;
+			Graphics::LineRenderer line_renderer{&renderer};
+			auto line_mesh = line_renderer.CreateLineMesh((grid_size + 1) * (grid_size + 1));
+
+			state.Measure([&]() {
+				line_renderer.Bake2DGrid(line_mesh, Math::Vector2Int{grid_size, grid_size}, Math::Vector2{1.0f, 1.0f}, Math::Colors::Values[Math::Colors::White]);
+			});
+		});
+
+		constexpr static SizeType grid_size_3d = 16;
+		registry.Add("LineRenderer/Bake3DGrid", grid_size_3d * grid_size_3d * grid_size_3d, [](State& state) {
+			BenchmarkRenderer renderer;
+			Graphics::LineRenderer line_renderer{&renderer};
+			auto line_mesh = line_renderer.CreateLineMesh((grid_size_3d + 1) * (grid_size_3d + 1) * (grid_size_3d + 1));
+
+			state.Measure([&]() {
+				line_renderer.Bake3DGrid(line_mesh, Math::Vector3Int{grid_size_3d, grid_size_3d, grid_size_3d}, Math::Vector3{1.0f, 1.0f, 1.0f}, Math::Colors::Values[Math::Colors::White]);
+			});
+		});
+
+		constexpr static SizeType circle_count = 256;
+		registry.Add("LineRenderer/BakeCircle", circle_count, [](State& state) {
+			BenchmarkRenderer renderer;
+			Graphics::LineRenderer line_renderer{&renderer};
+			auto line_mesh = line_renderer.CreateLineMesh(64);
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < state.GetItemCount(); ++i) {
+					line_renderer.BakeCircle(line_mesh, static_cast<float>(i), Math::Colors::Values[Math::Colors::White], 64);
+				}
+			});
+		});
+	}
+}
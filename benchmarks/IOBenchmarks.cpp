@@ -0,0 +1,103 @@
+#include <sstream>
+
+#include "Benchmark.h"
+
+#include "Vortex/IO/MathSerializables.h"
+
+namespace Vortex::Benchmark {
+	struct BenchmarkEntity {
+		Math::Vector3 Position;
+		Math::Vector3 Scale;
+		Math::Color Color;
+		Math::Matrix4 Transform;
+		UInt32 ID;
+	};
+}
+
+namespace Vortex {
+	template<>
+	struct Serializable<Benchmark::BenchmarkEntity> {
+		inline static bool Serialize(Serializer& serializer, const Benchmark::BenchmarkEntity& obj) {
+			bool out{true};
+			out &= serializer.Serialize("Position", obj.Position);
+			out &= serializer.Serialize("Scale", obj.Scale);
+			out &= serializer.Serialize("Color", obj.Color);
+			out &= serializer.Serialize("Transform", obj.Transform);
+			out &= serializer.Set<UInt32>("id", obj.ID);
+			return out;
+		}
+		inline static bool Deserialize(Serializer& serializer, Benchmark::BenchmarkEntity& obj) {
+			bool out{true};
+			out &= serializer.Deserialize("Position", obj.Position);
+			out &= serializer.Deserialize("Scale", obj.Scale);
+			out &= serializer.Deserialize("Color", obj.Color);
+			out &= serializer.Deserialize("Transform", obj.Transform);
+			out &= serializer.Get<UInt32>("id", obj.ID);
+			return out;
+		}
+	};
+}
+
+namespace Vortex::Benchmark {
+	constexpr static SizeType EntityCount = 1000;
+
+	static std::vector<BenchmarkEntity> CreateEntities(SizeType count) {
+		std::vector<BenchmarkEntity> entities(count);
+		for (SizeType i = 0; i < count; ++i) {
+			auto& entity = entities[i];
+			entity.Position = Math::Vector3{static_cast<float>(i), 1.0f, 2.0f};
+			entity.Scale = Math::Vector3{1.0f, 1.0f, 1.0f};
+			entity.Color = Math::Colors::Values[Math::Colors::White];
+			entity.Transform = Math::Matrix4::Identity();
+			entity.Transform.Translate3D(entity.Position.x, entity.Position.y, entity.Position.z);
+			entity.ID = static_cast<UInt32>(i);
+		}
+		return entities;
+	}
+
+	static std::string SaveEntities(const std::vector<BenchmarkEntity>& entities) {
+		Serializer serializer;
+		serializer.New();
+		serializer.SerializeArray("Entities", entities.data(), entities.size());
+
+		std::ostringstream ostream;
+		serializer.Save(ostream);
+		return ostream.str();
+	}
+
+	void RegisterIOBenchmarks(Registry& registry) {
+		registry.Add("Serializer/Save", EntityCount, [](State& state) {
+			auto entities = CreateEntities(state.GetItemCount());
+
+			state.Measure([&]() {
+				DoNotOptimize(SaveEntities(entities));
+			});
+		});
+
+		registry.Add("Serializer/Load", EntityCount, [](State& state) {
+			auto text = SaveEntities(CreateEntities(state.GetItemCount()));
+			std::vector<BenchmarkEntity> entities(state.GetItemCount());
+
+			state.Measure([&]() {
+				std::istringstream istream{text};
+				Serializer serializer;
+				serializer.Load(istream);
+				DoNotOptimize(serializer.DeserializeArray("Entities", entities.data(), entities.size()));
+			});
+			DoNotOptimize(entities.data());
+		});
+
+		registry.Add("Serializer/RoundTrip", EntityCount, [](State& state) {
+			auto entities = CreateEntities(state.GetItemCount());
+			std::vector<BenchmarkEntity> loaded(state.GetItemCount());
+
+			state.Measure([&]() {
+				std::istringstream istream{SaveEntities(entities)};
+				Serializer serializer;
+				serializer.Load(istream);
+				serializer.DeserializeArray("Entities", loaded.data(), loaded.size());
+			});
+			DoNotOptimize(loaded.data());
+		});
+	}
+}
@@ -0,0 +1,67 @@
+#include <random>
+
+#include "Benchmark.h"
+
+#include "Vortex/Math/VortexMath.h"
+
+namespace Vortex::Benchmark {
+	constexpr static SizeType MatrixCount = 4096;
+
+	static std::vector<Math::Matrix4> CreateTransforms(SizeType count) {
+		std::mt19937 random{42};
+		std::uniform_real_distribution<float> position{-100.0f, 100.0f};
+		std::uniform_real_distribution<float> angle{0.0f, 360.0f};
+
+		std::vector<Math::Matrix4> transforms(count);
+		for (auto& transform : transforms) {
+			transform = Math::Matrix4::Identity();
+			transform.SetRotationXYZ(
+				Math::Angle::FromDegrees(angle(random)),
+				Math::Angle::FromDegrees(angle(random)),
+				Math::Angle::FromDegrees(angle(random))
+			);
+			transform.Translate3D(position(random), position(random), position(random));
+		}
+		return transforms;
+	}
+
+	void RegisterMathBenchmarks(Registry& registry) {
+		registry.Add("Matrix4/Multiply", MatrixCount, [](State& state) {
+			auto lhs = CreateTransforms(state.GetItemCount());
+			auto rhs = CreateTransforms(state.GetItemCount());
+			std::vector<Math::Matrix4> results(state.GetItemCount());
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < results.size(); ++i) {
+					results[i] = lhs[i] * rhs[i];
+				}
+			});
+			DoNotOptimize(results.data());
+		});
+
+		registry.Add("Matrix4/MultiplyVector", MatrixCount, [](State& state) {
+			auto transforms = CreateTransforms(state.GetItemCount());
+			std::vector<Math::Vector4> results(state.GetItemCount());
+
+			state.Measure([&]() {
+				for (SizeType i = 0; i < results.size(); ++i) {
+					results[i] = transforms[i] * Math::Vector4{1.0f, 2.0f, 3.0f, 1.0f};
+				}
+			});
+			DoNotOptimize(results.data());
+		});
+
+		registry.Add("Matrix4/Invert", MatrixCount, [](State& state) {
+			auto transforms = CreateTransforms(state.GetItemCount());
+
+			state.Measure([&]() {
+				SizeType inverted_count{0};
+				for (auto& transform : transforms) {
+					inverted_count += transform.Invert();
+				}
+				DoNotOptimize(inverted_count);
+			});
+			DoNotOptimize(transforms.data());
+		});
+	}
+}
@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <thread>
+
+#include "Vortex/Common/CycleClock.h"
+#include "Vortex/Common/Timer.h"
+
+// Compares the cost of reading each clock and how far CycleClock drifts from steady_clock.
+
+template<typename ReadFn>
+double MeasureOverhead(ReadFn read_fn, Vortex::SizeType iterations) {
+	volatile Vortex::UInt64 sink{0};
+
+	auto begin = std::chrono::steady_clock::now();
+	for (Vortex::SizeType i = 0; i < iterations; ++i) {
+		sink = sink + static_cast<Vortex::UInt64>(read_fn());
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+}
+
+void BenchmarkOverhead(Vortex::SizeType iterations) {
+	std::printf("Clock read overhead (%zu iterations)\n", iterations);
+
+	auto steady_ns = MeasureOverhead([]() { return std::chrono::steady_clock::now().time_since_epoch().count(); }, iterations);
+	auto system_ns = MeasureOverhead([]() { return std::chrono::system_clock::now().time_since_epoch().count(); }, iterations);
+	auto cycle_ns = MeasureOverhead([]() { return Vortex::CycleClock::now().time_since_epoch().count(); }, iterations);
+	auto counter_ns = MeasureOverhead([]() { return Vortex::CycleClock::ReadCounter(); }, iterations);
+	auto ordered_ns = MeasureOverhead([]() { return Vortex::CycleClock::ReadCounterOrdered(); }, iterations);
+
+	std::printf("\t%-36s : %8.2f ns\n", "std::chrono::steady_clock::now", steady_ns);
+	std::printf("\t%-36s : %8.2f ns\n", "std::chrono::system_clock::now", system_ns);
+	std::printf("\t%-36s : %8.2f ns\n", "CycleClock::now", cycle_ns);
+	std::printf("\t%-36s : %8.2f ns\n", "CycleClock::ReadCounter", counter_ns);
+	std::printf("\t%-36s : %8.2f ns\n", "CycleClock::ReadCounterOrdered", ordered_ns);
+}
+
+void BenchmarkTimerOverhead(Vortex::SizeType iterations) {
+	std::printf("Timer start/stop overhead (%zu iterations)\n", iterations);
+
+	Vortex::Timer<double, Vortex::TimerTraits::Milliseconds<double>> steady_timer;
+	Vortex::CycleTimer<double, Vortex::TimerTraits::Milliseconds<double>> cycle_timer;
+
+	auto steady_ns = MeasureOverhead([&]() { steady_timer.Start(); steady_timer.Stop(); return steady_timer.Get(); }, iterations);
+	auto cycle_ns = MeasureOverhead([&]() { cycle_timer.Start(); cycle_timer.Stop(); return cycle_timer.Get(); }, iterations);
+
+	std::printf("\t%-36s : %8.2f ns\n", "Timer<steady_clock>", steady_ns);
+	std::printf("\t%-36s : %8.2f ns\n", "CycleTimer", cycle_ns);
+}
+
+void BenchmarkDrift(std::chrono::milliseconds interval, int samples) {
+	std::printf("Drift of CycleClock against steady_clock (%d x %lld ms)\n", samples, static_cast<long long>(interval.count()));
+
+	auto steady_begin = std::chrono::steady_clock::now();
+	auto cycle_begin = Vortex::CycleClock::now();
+
+	for (int i = 1; i <= samples; ++i) {
+		std::this_thread::sleep_for(interval);
+
+		auto steady_elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - steady_begin).count();
+		auto cycle_elapsed = std::chrono::duration<double, std::micro>(Vortex::CycleClock::now() - cycle_begin).count();
+		auto drift = cycle_elapsed - steady_elapsed;
+
+		std::printf("\t%10.1f us elapsed : drift %+9.3f us (%+8.2f ppm)\n", steady_elapsed, drift, drift / steady_elapsed * 1e6);
+	}
+}
+
+int main() {
+	std::printf("CycleClock frequency: %.3f MHz\n\n", Vortex::CycleClock::GetFrequency() / 1e6);
+
+	constexpr static Vortex::SizeType iterations = 10'000'000;
+	BenchmarkOverhead(iterations);
+	std::printf("\n");
+	BenchmarkTimerOverhead(iterations);
+	std::printf("\n");
+	BenchmarkDrift(std::chrono::milliseconds{250}, 8);
+	return 0;
+}
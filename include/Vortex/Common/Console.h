@@ -1,10 +1,27 @@
 #pragma once
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <shared_mutex>
 
+#include "Vortex/Common/FlightRecorder.h"
+#include "Vortex/Common/LogFormat.h"
+#include "Vortex/Common/MPSCQueue.h"
 #include "Vortex/Common/ThreadSafeRW.h"
 
+// Log calls below this EntryType are removed at compile time, arguments included (VORTEX_LOG* macros only).
+#ifndef VORTEX_LOG_MIN_LEVEL
+  #ifdef VORTEX_DEBUG
+    #define VORTEX_LOG_MIN_LEVEL 0 // Debug
+  #else
+    #define VORTEX_LOG_MIN_LEVEL 1 // Info
+  #endif
+#endif
+
 namespace Vortex {
 	namespace EntryType {
 		enum Enum {
@@ -22,15 +39,74 @@ namespace Vortex {
 		};
 	}
 
+	namespace LogCategory {
+		enum Enum {
+			General = 0,
+			Core,
+			Renderer,
+			Shader,
+			Audio,
+			Input,
+			IO,
+
+			Count
+		};
+
+		constexpr static const char* ToString[]{
+			"General"
+			, "Core"
+			, "Renderer"
+			, "Shader"
+			, "Audio"
+			, "Input"
+			, "IO"
+		};
+	}
+
+	namespace OverflowPolicy {
+		enum Enum {
+			Drop = 0,    // lose the entry, count it and report the count later
+			Block        // spin until the writer thread frees a slot
+		};
+
+		constexpr static const char* ToString[]{
+			"Drop"
+			, "Block"
+		};
+	}
+
+	//	Asynchronous console.
+	//	Callers format into a fixed-size record inside a lock-free MPSC ring, a writer thread
+	//	prints and writes records to the log file in batches, so logging never waits on I/O.
+	//	Call Flush() before the process ends normally and TryFlush() from crash handlers and asserts
+	//	to write out whatever is still queued on the calling thread.
+	//	With EnableFlightRecorder every record is also copied into a memory-mapped ring on the
+	//	calling thread, entries still queued or dropped when the process dies are kept there.
 	class Console {
 	public:
 		struct Entry {
 			Vortex::String Log;
 			EntryType::Enum Type;
+			LogCategory::Enum Category;
 		};
 
 		using ContainerType = std::vector<Console::Entry>;
 
+		constexpr static SizeType RecordTextSize = 496;
+		constexpr static SizeType DefaultRecordCapacity = 4096;
+
+		// Text holds the formatted log, or for deferred records the LogFormat encoded arguments
+		// of the format string FormatID, formatted by the writer thread.
+		struct Record {
+			EntryType::Enum Type;
+			LogCategory::Enum Category;
+			bool Append;
+			bool Deferred;
+			UInt16 DataSize;
+			UInt32 FormatID;
+			char Text[RecordTextSize];
+		};
+
 	public:
 		static void Initialize() {
 			VORTEX_ASSERT(s_Instance == nullptr)
@@ -43,48 +119,143 @@ namespace Vortex {
 		static void Shutdown() {
 			VORTEX_ASSERT(s_Instance != nullptr)
 			delete s_Instance;
+			s_Instance = nullptr;
 		}
 
 	public:
-		explicit Console(std::filesystem::path file_path = "log.txt", SizeType max_value = 100);
+		explicit Console(
+			std::filesystem::path file_path = "log.txt",
+			SizeType max_value = 100,
+			SizeType record_capacity = DefaultRecordCapacity,
+			OverflowPolicy::Enum overflow_policy = OverflowPolicy::Drop
+		);
 		~Console();
 
+		Console(const Console&) = delete;
+		Console(Console&&) = delete;
+
 	public:
-		inline void SetLogFilePath(const std::filesystem::path& file_path) {
-			std::unique_lock write_lock{m_Mutex};
-			m_LogFilePath = file_path;
-		}
+		void SetLogFilePath(const std::filesystem::path& file_path);
+		// number of entries kept in memory for GetEntries
 		inline void SetLogFileBufferEntryCount(SizeType max_value) {
 			std::unique_lock write_lock{m_Mutex};
 			m_LogFileBufferEntryCount = max_value;
 		}
-		inline void SetDebugOutput(bool active) {
-			std::unique_lock write_lock{m_Mutex};
-			m_DebugOutput = active;
+		inline void SetDebugOutput(bool active) { m_DebugOutput = active; }
+		// entries of category below level are skipped before their arguments are evaluated
+		inline void SetCategoryLevel(LogCategory::Enum category, EntryType::Enum level) {
+			m_CategoryLevels[category].store(level, std::memory_order_relaxed);
+		}
+		inline EntryType::Enum GetCategoryLevel(LogCategory::Enum category) const {
+			return m_CategoryLevels[category].load(std::memory_order_relaxed);
+		}
+		inline bool IsEnabled(LogCategory::Enum category, EntryType::Enum type) const {
+			return type >= m_CategoryLevels[category].load(std::memory_order_relaxed) && (type != EntryType::Debug || m_DebugOutput.load(std::memory_order_relaxed));
 		}
+		inline void SetOverflowPolicy(OverflowPolicy::Enum overflow_policy) { m_OverflowPolicy = overflow_policy; }
+
+		// Writes every queued record on the calling thread and flushes the file.
+		// Waits for the writer thread to finish the batch it is writing.
 		void Flush();
+		// Flush for crash paths, never waits. If another thread is draining (the writer, or a thread that
+		// crashed while writing) only stdout and the flight recorder are synced and false is returned.
+		bool TryFlush();
+
+		// Starts copying every record into a crash-safe memory-mapped ring at path, once per console.
+		// Returns false if the file can not be mapped.
+		bool EnableFlightRecorder(const std::filesystem::path& path, SizeType capacity = FlightRecorder::DefaultCapacity);
+		inline bool IsFlightRecorderEnabled() const { return m_FlightRecorder.load(std::memory_order_relaxed) != nullptr; }
 
 	protected:
+		template<typename Fn>
+		inline void Push_(Fn&& write_fn) {
+			auto* flight_recorder = m_FlightRecorder.load(std::memory_order_acquire);
+			if (flight_recorder == nullptr) {
+				PushQueue_(write_fn);
+				return;
+			}
+
+			bool queued = PushQueue_([&](Record& record) {
+				write_fn(record);
+				RecordFlight_(*flight_recorder, record);
+			});
+			// dropped records still reach the flight recorder
+			if (!queued) {
+				Record record;
+				write_fn(record);
+				RecordFlight_(*flight_recorder, record);
+			}
+		}
+
+		// returns false if the record was dropped
+		template<typename Fn>
+		inline bool PushQueue_(Fn&& write_fn) {
+			while (!m_Records.TryPush(write_fn)) {
+				if (m_OverflowPolicy == OverflowPolicy::Drop) {
+					m_DroppedEntryCount.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				WakeWriter_();
+				std::this_thread::yield();
+			}
+			m_TotalEntryCount.fetch_add(1, std::memory_order_relaxed);
+			if (m_WriterWaiting.load(std::memory_order_relaxed)) {
+				WakeWriter_();
+			}
+			return true;
+		}
+		static void RecordFlight_(FlightRecorder& flight_recorder, const Record& record);
+
 		void Write_(EntryType::Enum type, const char* log);
 		void Append_(const char* log);
 
+		void WakeWriter_();
+		void WriterLoop_();
+		SizeType Drain_(SizeType max_count);
+		SizeType DrainLocked_(SizeType max_count); // m_DrainMutex held
+		void FlushLocked_(); // m_DrainMutex held
+		void WriteRecord_(const Record& record);
+		void WriteText_(EntryType::Enum type, LogCategory::Enum category, bool append, const char* text);
+
 	public:
 		template<typename ...Args>
 		inline void WriteFormat(EntryType::Enum type, const char* format, Args ... args) {
-			if (!m_DebugOutput && type == EntryType::Debug) { return; }
+			if (!IsEnabled(LogCategory::General, type)) { return; }
 
-			char buffer[512];
-			sprintf_s(buffer, 512, format, args...);
-			Write_(type, buffer);
+			Push_([&](Record& record) {
+				record.Type = type;
+				record.Category = LogCategory::General;
+				record.Append = false;
+				record.Deferred = false;
+				snprintf(record.Text, RecordTextSize, format, args...);
+			});
 		}
 
 		template<typename ...Args>
 		inline void AppendFormat(EntryType::Enum type, const char* format, Args ... args) {
-			if (!m_DebugOutput && type == EntryType::Debug) { return; }
+			if (!IsEnabled(LogCategory::General, type)) { return; }
 
-			char buffer[512];
-			sprintf_s(buffer, 512, format, args...);
-			Append_(buffer);
+			Push_([&](Record& record) {
+				record.Type = type;
+				record.Category = LogCategory::General;
+				record.Append = true;
+				record.Deferred = false;
+				snprintf(record.Text, RecordTextSize, format, args...);
+			});
+		}
+
+		// Stores only the format id and the raw arguments, use through VORTEX_LOG.
+		// The enabled check is done by the macro before the arguments are evaluated.
+		template<typename ...Args>
+		inline void WriteDeferred(LogCategory::Enum category, EntryType::Enum type, UInt32 format_id, const Args& ... args) {
+			Push_([&](Record& record) {
+				record.Type = type;
+				record.Category = category;
+				record.Append = false;
+				record.Deferred = true;
+				record.FormatID = format_id;
+				record.DataSize = static_cast<UInt16>(LogFormat::Encode(record.Text, RecordTextSize, args...));
+			});
 		}
 
 		ThreadSafeReader<ContainerType> GetEntries() const { return {m_Mutex, &m_Entries}; }
@@ -134,21 +305,73 @@ namespace Vortex {
 		}
 
 	public:
-		inline SizeType GetTotalEntryCount() const { return m_TotalEntryCount; }
+		inline SizeType GetTotalEntryCount() const { return m_TotalEntryCount.load(std::memory_order_relaxed); }
+		inline SizeType GetDroppedEntryCount() const { return m_DroppedEntryCount.load(std::memory_order_relaxed); }
 
 	protected:
 		static Console* s_Instance;
 
 	protected:
-		bool m_DebugOutput;
+		std::atomic<bool> m_DebugOutput;
+		std::atomic<EntryType::Enum> m_CategoryLevels[LogCategory::Count];
+		std::atomic<OverflowPolicy::Enum> m_OverflowPolicy;
 
 		std::filesystem::path m_LogFilePath;
 		SizeType m_LogFileBufferEntryCount;
-		ContainerType m_LogFileBuffer;
 
+		// recent entries, guarded by m_Mutex
 		ContainerType m_Entries;
-
-		SizeType m_TotalEntryCount;
 		mutable std::shared_mutex m_Mutex;
+
+		// producers -> writer
+		MPSCQueue<Record> m_Records;
+		std::atomic<SizeType> m_TotalEntryCount;
+		std::atomic<SizeType> m_DroppedEntryCount;
+		SizeType m_ReportedDroppedEntryCount;
+
+		// consumer side, only one thread drains at a time (writer thread or Flush)
+		std::mutex m_DrainMutex;
+		std::ofstream m_LogFile;
+
+		std::mutex m_WriterMutex;
+		std::condition_variable m_WriterSignal;
+		std::atomic<bool> m_WriterWaiting;
+		std::atomic<bool> m_Running;
+		std::thread m_WriterThread;
+
+		// owned, set once by EnableFlightRecorder and kept until the console is destroyed
+		std::atomic<FlightRecorder*> m_FlightRecorder;
 	};
 }
+
+//	Deferred logging: the call costs a format id lookup and a copy of the arguments,
+//	formatting happens on the console writer thread. Format strings must be literals and are
+//	checked against the argument types at compile time.
+//	Calls below VORTEX_LOG_MIN_LEVEL compile to nothing, calls below the category's runtime
+//	level (Console::SetCategoryLevel) cost one branch and do not evaluate their arguments.
+//
+//		VORTEX_LOG_INFO("%zu entities loaded", count);
+//		VORTEX_LOG_CATEGORY_DEBUG(Vortex::LogCategory::Renderer, "%zu draw calls in %.3f ms", draw_count, time);
+#define VORTEX_LOG_CATEGORY(category, type, format, ...)                                                                       \
+    do {                                                                                                                       \
+        VORTEX_STATIC_ASSERT_MSG(                                                                                              \
+            Vortex::LogFormat::Validate(format, decltype(Vortex::LogFormat::MakeTypeList(__VA_ARGS__)){}),                   \
+            "Log format does not match the argument types")                                                                    \
+        if constexpr ((type) >= VORTEX_LOG_MIN_LEVEL) {                                                                        \
+            if (Vortex::Console::Get().IsEnabled(category, type)) {                                                            \
+                static const Vortex::UInt32 vortex_log_format_id = Vortex::LogFormat::RegisterFormat(format);                 \
+                Vortex::Console::Get().WriteDeferred(category, type, vortex_log_format_id, ##__VA_ARGS__);                     \
+            }                                                                                                                  \
+        }                                                                                                                      \
+    } while (false)
+
+#define VORTEX_LOG_CATEGORY_DEBUG(category, format, ...) VORTEX_LOG_CATEGORY(category, Vortex::EntryType::Debug, format, ##__VA_ARGS__)
+#define VORTEX_LOG_CATEGORY_INFO(category, format, ...) VORTEX_LOG_CATEGORY(category, Vortex::EntryType::Info, format, ##__VA_ARGS__)
+#define VORTEX_LOG_CATEGORY_WARNING(category, format, ...) VORTEX_LOG_CATEGORY(category, Vortex::EntryType::Warning, format, ##__VA_ARGS__)
+#define VORTEX_LOG_CATEGORY_ERROR(category, format, ...) VORTEX_LOG_CATEGORY(category, Vortex::EntryType::Error, format, ##__VA_ARGS__)
+
+#define VORTEX_LOG(type, format, ...) VORTEX_LOG_CATEGORY(Vortex::LogCategory::General, type, format, ##__VA_ARGS__)
+#define VORTEX_LOG_DEBUG(format, ...) VORTEX_LOG(Vortex::EntryType::Debug, format, ##__VA_ARGS__)
+#define VORTEX_LOG_INFO(format, ...) VORTEX_LOG(Vortex::EntryType::Info, format, ##__VA_ARGS__)
+#define VORTEX_LOG_WARNING(format, ...) VORTEX_LOG(Vortex::EntryType::Warning, format, ##__VA_ARGS__)
+#define VORTEX_LOG_ERROR(format, ...) VORTEX_LOG(Vortex::EntryType::Error, format, ##__VA_ARGS__)
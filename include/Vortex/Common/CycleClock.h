@@ -0,0 +1,79 @@
+#pragma once
+#include <chrono>
+
+#include "Vortex/Memory/Memory.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+  #define VORTEX_CYCLE_CLOCK_X86
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define VORTEX_CYCLE_CLOCK_X86
+#elif defined(__aarch64__)
+  #define VORTEX_CYCLE_CLOCK_ARM64
+#endif
+
+namespace Vortex {
+	// std::chrono compatible clock reading the CPU timestamp counter
+	// (rdtsc on x86, cntvct_el0 on arm64), converted to nanoseconds with a factor
+	// calibrated once against steady_clock. Falls back to steady_clock on other targets.
+	//
+	// Assumes an invariant counter shared by all cores, which is the case for every
+	// x86 CPU since Nehalem / Bulldozer and for the arm64 generic timer.
+	class CycleClock {
+	public:
+		using rep = Int64;
+		using period = std::nano;
+		using duration = std::chrono::duration<rep, period>;
+		using time_point = std::chrono::time_point<CycleClock>;
+		constexpr static bool is_steady = true;
+
+	public:
+		static time_point now() noexcept {
+			auto ticks = static_cast<double>(ReadCounter() - s_BaseTicks);
+			return time_point{duration{static_cast<rep>(ticks * s_NanosecondsPerTick)}};
+		}
+
+		// Raw counter value, cheapest way to time a region. Not ordered with surrounding instructions.
+		static UInt64 ReadCounter() noexcept {
+#if defined(VORTEX_CYCLE_CLOCK_X86)
+			return __rdtsc();
+#elif defined(VORTEX_CYCLE_CLOCK_ARM64)
+			UInt64 value;
+			asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+			return value;
+#else
+			return static_cast<UInt64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		// Waits for preceding instructions to retire before reading the counter (rdtscp / isb).
+		static UInt64 ReadCounterOrdered() noexcept {
+#if defined(VORTEX_CYCLE_CLOCK_X86)
+			unsigned int aux;
+			return __rdtscp(&aux);
+#elif defined(VORTEX_CYCLE_CLOCK_ARM64)
+			UInt64 value;
+			asm volatile("isb; mrs %0, cntvct_el0" : "=r"(value) :: "memory");
+			return value;
+#else
+			return ReadCounter();
+#endif
+		}
+
+		static double TicksToNanoseconds(UInt64 ticks) noexcept {
+			return static_cast<double>(ticks) * s_NanosecondsPerTick;
+		}
+
+		static double GetNanosecondsPerTick() { return s_NanosecondsPerTick; }
+		static double GetFrequency() { return 1e9 / s_NanosecondsPerTick; }
+
+		// Runs automatically at startup, can be repeated with a longer duration for better precision.
+		// Time points taken before a recalibration are not comparable with the ones after it.
+		static void Calibrate(std::chrono::milliseconds calibration_time = std::chrono::milliseconds{10});
+
+	private:
+		static double s_NanosecondsPerTick;
+		static UInt64 s_BaseTicks;
+	};
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Vortex/Debug/Assert.h"
+#include "Vortex/Memory/Memory.h"
+
+namespace Vortex {
+	template<typename Signature>
+	class Delegate;
+
+	//	Non-owning callable with inline storage, never allocates.
+	//	Holds a function pointer, a member function bound to an instance, or a small lambda
+	//	(at most StorageSize bytes of captures, trivially copyable, e.g. capturing pointers or references).
+	//
+	//		Delegate<void(float)> on_update = Delegate<void(float)>::Bind<&Camera::Update>(&camera);
+	//		Delegate<void(float)> on_tick = [&counter](float) { ++counter; };
+	template<typename Ret, typename ... Args>
+	class Delegate<Ret(Args...)> {
+	public:
+		constexpr static SizeType StorageSize = 2 * sizeof(void*);
+
+	protected:
+		using InvokeFn = Ret (*)(const void*, Args...);
+
+	public:
+		Delegate() = default;
+
+		template<
+			typename Fn,
+			typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, Delegate> && std::is_invocable_r_v<Ret, const std::decay_t<Fn>&, Args...>>
+		>
+		Delegate(Fn&& fn) {
+			using FnType = std::decay_t<Fn>;
+			VORTEX_STATIC_ASSERT_MSG(sizeof(FnType) <= StorageSize, "Callable too large for Delegate, capture less or bind a member function")
+			VORTEX_STATIC_ASSERT_MSG(alignof(FnType) <= alignof(void*), "Callable alignment not supported by Delegate")
+			VORTEX_STATIC_ASSERT_MSG(std::is_trivially_copyable_v<FnType> && std::is_trivially_destructible_v<FnType>, "Delegate callables must be trivially copyable")
+
+			new(m_Storage) FnType(std::forward<Fn>(fn));
+			m_Invoke = [](const void* storage, Args... args) -> Ret {
+				return (*static_cast<const FnType*>(storage))(std::forward<Args>(args)...);
+			};
+		}
+
+		// member function, Bind<&Type::Method>(instance)
+		template<auto Method, typename T>
+		static Delegate Bind(T* instance) {
+			VORTEX_ASSERT(instance != nullptr)
+			Delegate delegate;
+			new(delegate.m_Storage) T*(instance);
+			delegate.m_Invoke = [](const void* storage, Args... args) -> Ret {
+				return ((*static_cast<T* const*>(storage))->*Method)(std::forward<Args>(args)...);
+			};
+			return delegate;
+		}
+
+		// free function, call through the invoke pointer without a stored function pointer
+		template<auto Function>
+		static Delegate Bind() {
+			Delegate delegate;
+			delegate.m_Invoke = [](const void*, Args... args) -> Ret {
+				return Function(std::forward<Args>(args)...);
+			};
+			return delegate;
+		}
+
+	public:
+		inline Ret operator()(Args... args) const {
+			VORTEX_ASSERT(m_Invoke != nullptr)
+			return m_Invoke(m_Storage, std::forward<Args>(args)...);
+		}
+
+		inline bool IsBound() const { return m_Invoke != nullptr; }
+		inline explicit operator bool() const { return IsBound(); }
+
+	protected:
+		alignas(void*) unsigned char m_Storage[StorageSize]{};
+		InvokeFn m_Invoke{nullptr};
+	};
+}
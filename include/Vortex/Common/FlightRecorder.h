@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+
+#include "Vortex/Common/CycleClock.h"
+
+namespace Vortex {
+	//	Crash-safe log ring in a memory-mapped file.
+	//	Records are copied into the shared mapping on the logging thread, there is no syscall per message.
+	//	The pages belong to the OS page cache, so the last Capacity bytes of logs survive a crash of the
+	//	process and can be read back afterwards with FlightRecorder::Decode / VortexFlightRecorderDecoder.
+	//
+	//	File layout:
+	//		FileHeader                                         HeaderSize bytes
+	//		format table: [UInt32 id][UInt16 length][chars]... FormatTableSize bytes
+	//		ring: [RecordHeader][payload]... 8 byte aligned    Capacity bytes
+	//
+	//	Writers reserve ring space with one atomic add on FileHeader::WritePosition, positions are absolute
+	//	(never wrapped) byte offsets. RecordHeader::Position is stored last, a record only counts once it
+	//	holds its own position, so records torn by a crash or already overwritten are skipped when decoding.
+	class FlightRecorder {
+	public:
+		constexpr static UInt64 Magic = 0x5448474C4658565Full; // "VXFLIGHT"
+		constexpr static UInt32 Version = 1;
+		constexpr static UInt32 RecordMagic = 0x4C525856; // "VXRL"
+		constexpr static UInt32 TextFormatID = 0xFFFFFFFF; // payload is formatted text
+
+		constexpr static SizeType HeaderSize = 4096;
+		constexpr static SizeType FormatTableSize = 64 * 1024;
+		constexpr static SizeType MaxFormatCount = 4096;
+		constexpr static SizeType DefaultCapacity = 4 * 1024 * 1024;
+		constexpr static SizeType RecordAlignment = 8;
+
+		struct FileHeader {
+			UInt64 Magic;
+			UInt32 Version;
+			UInt32 HeaderSize;
+			UInt64 FormatTableSize;
+			UInt64 Capacity;
+			Int64 StartTime; // system_clock nanoseconds since epoch, record timestamps are relative to it
+
+			std::atomic<UInt64> WritePosition;
+			std::atomic<UInt64> FormatTablePosition;
+		};
+
+		// may wrap around the end of the ring, Position never straddles it (8 byte aligned)
+		struct RecordHeader {
+			UInt32 Magic;
+			UInt16 Size; // header + payload, aligned to RecordAlignment
+			UInt16 DataSize;
+			UInt32 FormatID;
+			UInt8 Type;
+			UInt8 Category;
+			UInt8 Append;
+			UInt8 Reserved;
+			UInt64 Timestamp; // nanoseconds since FileHeader::StartTime
+			UInt64 Position; // commit marker, stored with release semantics
+		};
+
+		struct DecodedRecord {
+			UInt64 Timestamp;
+			UInt8 Type;
+			UInt8 Category;
+			bool Append;
+			UInt32 FormatID;
+			const char* Format; // nullptr for text records or formats missing from the table
+			const char* Data;
+			SizeType DataSize;
+		};
+		using DecodeFn = std::function<void(const DecodedRecord&)>;
+
+	public:
+		// Moves an existing file at path to <name>.prev<ext> first, the log of a crashed run is kept for one restart.
+		explicit FlightRecorder(const std::filesystem::path& path, SizeType capacity = DefaultCapacity);
+		~FlightRecorder();
+
+		FlightRecorder(const FlightRecorder&) = delete;
+		FlightRecorder(FlightRecorder&&) = delete;
+
+	public:
+		inline bool IsOpen() const { return m_Header != nullptr; }
+		inline SizeType GetCapacity() const { return m_Capacity; }
+
+		// data is the LogFormat encoded arguments of format_id, or text when format_id is TextFormatID.
+		// Records of format ids from MaxFormatCount on are formatted on the calling thread and stored as text.
+		void Write(UInt8 type, UInt8 category, bool append, UInt32 format_id, const char* data, SizeType data_size);
+
+		// Asks the OS to write the mapping to disk now. Not needed when only the process crashes,
+		// covers power loss and kernel panics.
+		void Sync();
+
+	public:
+		// Calls decode_fn for every intact record of a recorder file, oldest first.
+		// Returns false if the file can not be read or is not a recorder file.
+		static bool Decode(const std::filesystem::path& path, const DecodeFn& decode_fn);
+
+	protected:
+		void WriteFormat_(UInt32 format_id);
+		void CopyToRing_(UInt64 position, const void* data, SizeType size);
+
+		bool Map_(const std::filesystem::path& path, SizeType size);
+		void Unmap_();
+
+	protected:
+		FileHeader* m_Header;
+		char* m_FormatTable;
+		char* m_Ring;
+		SizeType m_Capacity;
+		CycleClock::time_point m_StartTime;
+
+		// platform mapping
+		void* m_Mapping;
+		SizeType m_MappingSize;
+		std::intptr_t m_File;
+		std::intptr_t m_MappingObject;
+
+		// format strings are appended to the table the first time a record uses them
+		std::mutex m_FormatMutex;
+		std::atomic<bool> m_FormatWritten[MaxFormatCount];
+	};
+}
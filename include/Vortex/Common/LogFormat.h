@@ -0,0 +1,175 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Vortex/Debug/Assert.h"
+
+//	Deferred log formatting.
+//	A log call stores the id of its (static) format string and the raw argument bytes,
+//	the printf style formatting happens later, on the console writer thread or offline.
+//
+//	Encoded arguments: [ArgumentType : UInt8][size : UInt8][payload]
+//		Int64 / UInt64 / Double / Pointer: 8 byte payload, size is the size of the original type
+//		String: size is the string length (truncated to 255), payload is the characters without terminator
+namespace Vortex::LogFormat {
+	namespace ArgumentType {
+		enum Enum : UInt8 {
+			Int64 = 0,
+			UInt64,
+			Double,
+			String,
+			Pointer,
+
+			Count,
+			Invalid = Count
+		};
+
+		constexpr static const char* ToString[]{
+			"Int64"
+			, "UInt64"
+			, "Double"
+			, "String"
+			, "Pointer"
+		};
+	}
+
+	template<typename T>
+	constexpr ArgumentType::Enum GetArgumentType() {
+		using Type = std::decay_t<T>;
+		if constexpr(std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+			return ArgumentType::String;
+		} else if constexpr(std::is_pointer_v<Type>) {
+			return ArgumentType::Pointer;
+		} else if constexpr(std::is_floating_point_v<Type>) {
+			return ArgumentType::Double;
+		} else if constexpr(std::is_enum_v<Type>) {
+			return std::is_signed_v<std::underlying_type_t<Type>> ? ArgumentType::Int64 : ArgumentType::UInt64;
+		} else if constexpr(std::is_integral_v<Type>) {
+			return std::is_signed_v<Type> ? ArgumentType::Int64 : ArgumentType::UInt64;
+		} else {
+			return ArgumentType::Invalid;
+		}
+	}
+
+	// ======= compile-time format check =======
+	template<typename ... Args>
+	struct TypeList {};
+
+	// only used in unevaluated context: decltype(MakeTypeList(args...))
+	template<typename ... Args>
+	TypeList<std::decay_t<Args>...> MakeTypeList(const Args& ...);
+
+	constexpr bool IsLengthModifier(char c) {
+		return c == 'h' || c == 'l' || c == 'L' || c == 'z' || c == 'j' || c == 't' || c == 'q';
+	}
+	constexpr bool IsFlagOrWidth(char c) {
+		return c == '-' || c == '+' || c == ' ' || c == '#' || c == '.' || (c >= '0' && c <= '9');
+	}
+
+	constexpr bool AcceptsArgument(char conversion, ArgumentType::Enum type) {
+		switch (conversion) {
+			case 'd':
+			case 'i':
+			case 'u':
+			case 'o':
+			case 'x':
+			case 'X':
+			case 'c': return type == ArgumentType::Int64 || type == ArgumentType::UInt64;
+			case 'f':
+			case 'F':
+			case 'e':
+			case 'E':
+			case 'g':
+			case 'G':
+			case 'a':
+			case 'A': return type == ArgumentType::Double;
+			case 's': return type == ArgumentType::String;
+			case 'p': return type == ArgumentType::Pointer || type == ArgumentType::String;
+			default: return false;
+		}
+	}
+
+	// True if every conversion in format matches the argument at its position and the counts agree.
+	// '*' widths and %n are rejected, they cannot be deferred.
+	template<typename ... Args>
+	constexpr bool Validate(const char* format, TypeList<Args...>) {
+		constexpr ArgumentType::Enum types[]{GetArgumentType<Args>()..., ArgumentType::Invalid};
+		constexpr SizeType argument_count = sizeof...(Args);
+
+		SizeType argument_index{0};
+		for (SizeType i = 0; format[i] != '\0'; ++i) {
+			if (format[i] != '%') { continue; }
+
+			++i;
+			if (format[i] == '%') { continue; }
+
+			while (IsFlagOrWidth(format[i])) { ++i; }
+			while (IsLengthModifier(format[i])) { ++i; }
+
+			if (argument_index >= argument_count || !AcceptsArgument(format[i], types[argument_index])) {
+				return false;
+			}
+			++argument_index;
+		}
+		return argument_index == argument_count;
+	}
+
+	// ======= encoding =======
+	template<typename T>
+	inline bool EncodeArgument(char*& cursor, const char* end, const T& value) {
+		constexpr auto type = GetArgumentType<T>();
+		VORTEX_STATIC_ASSERT_MSG(type != ArgumentType::Invalid, "Type can not be logged deferred")
+
+		if constexpr(type == ArgumentType::String) {
+			SizeType length = value != nullptr ? std::strlen(value) : 0;
+			if (length > 255) { length = 255; }
+			if (end - cursor < static_cast<std::ptrdiff_t>(2 + length)) { return false; }
+
+			cursor[0] = static_cast<char>(type);
+			cursor[1] = static_cast<char>(length);
+			std::memcpy(cursor + 2, value, length);
+			cursor += 2 + length;
+		} else {
+			if (end - cursor < 10) { return false; }
+
+			cursor[0] = static_cast<char>(type);
+			cursor[1] = static_cast<char>(sizeof(T));
+			if constexpr(type == ArgumentType::Double) {
+				auto payload = static_cast<double>(value);
+				std::memcpy(cursor + 2, &payload, 8);
+			} else if constexpr(type == ArgumentType::Pointer) {
+				auto payload = static_cast<Vortex::UInt64>(reinterpret_cast<std::uintptr_t>(value));
+				std::memcpy(cursor + 2, &payload, 8);
+			} else if constexpr(type == ArgumentType::Int64) {
+				auto payload = static_cast<Vortex::Int64>(value);
+				std::memcpy(cursor + 2, &payload, 8);
+			} else {
+				auto payload = static_cast<Vortex::UInt64>(value);
+				std::memcpy(cursor + 2, &payload, 8);
+			}
+			cursor += 10;
+		}
+		return true;
+	}
+
+	// Returns the number of bytes written. Arguments that do not fit are left out,
+	// Format prints them as "<?>".
+	template<typename ... Args>
+	inline SizeType Encode(char* buffer, SizeType capacity, const Args& ... args) {
+		char* cursor = buffer;
+		const char* end = buffer + capacity;
+		(void) (EncodeArgument(cursor, end, args) && ...);
+		return static_cast<SizeType>(cursor - buffer);
+	}
+
+	// ======= decoding =======
+	// Formats encoded arguments with format into out (always null terminated), returns the text length.
+	SizeType Format(char* out, SizeType out_size, const char* format, const char* data, SizeType data_size);
+
+	// ======= format registry =======
+	// Format strings are registered once per call site, ids are stable for the lifetime of the process.
+	UInt32 RegisterFormat(const char* format);
+	const char* GetFormat(UInt32 format_id);
+	SizeType GetFormatCount();
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "Vortex/Debug/Assert.h"
+
+namespace Vortex {
+	// Bounded lock-free queue for many producers and a single consumer (Vyukov's bounded queue).
+	// Every cell carries a sequence number telling whether it is free for the producer at position N
+	// (sequence == N) or holds data for the consumer (sequence == N + 1), so producers only contend
+	// on one atomic increment and never wait for each other.
+	//
+	// Push and pop take a callback that writes/reads the cell in place, large records are not copied twice.
+	// Only one thread may pop at a time, callers guard the consumer side themselves if needed.
+	template<typename T>
+	class MPSCQueue {
+		VORTEX_STATIC_ASSERT_MSG(std::is_default_constructible_v<T>, "Type must be default constructible")
+
+	public:
+		constexpr static SizeType CacheLineSize = 64;
+
+	protected:
+		struct Cell {
+			std::atomic<SizeType> Sequence;
+			T Value;
+		};
+
+	public:
+		// capacity is rounded up to a power of two
+		explicit MPSCQueue(SizeType capacity)
+			: m_Capacity{RoundUpToPowerOfTwo(capacity)},
+			  m_Mask{m_Capacity - 1},
+			  m_Cells{new Cell[m_Capacity]},
+			  m_EnqueuePosition{0},
+			  m_DequeuePosition{0} {
+
+			for (SizeType i = 0; i < m_Capacity; ++i) {
+				m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue(MPSCQueue&&) = delete;
+
+	public:
+		// returns false if the queue is full, write_fn(T&) is not called then
+		template<typename Fn>
+		bool TryPush(Fn&& write_fn) {
+			Cell* cell;
+			auto position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			while (true) {
+				cell = &m_Cells[position & m_Mask];
+				auto sequence = cell->Sequence.load(std::memory_order_acquire);
+				auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+				if (difference == 0) {
+					if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				} else if (difference < 0) {
+					return false;
+				} else {
+					position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			write_fn(cell->Value);
+			cell->Sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+		inline bool TryPush(const T& value) {
+			return TryPush([&value](T& cell_value) { cell_value = value; });
+		}
+
+		// single consumer only, returns false if the queue is empty, read_fn(T&) is not called then
+		template<typename Fn>
+		bool TryPop(Fn&& read_fn) {
+			auto position = m_DequeuePosition.load(std::memory_order_relaxed);
+			auto& cell = m_Cells[position & m_Mask];
+			auto sequence = cell.Sequence.load(std::memory_order_acquire);
+			if (sequence != position + 1) {
+				return false;
+			}
+
+			read_fn(cell.Value);
+			cell.Sequence.store(position + m_Capacity, std::memory_order_release);
+			m_DequeuePosition.store(position + 1, std::memory_order_relaxed);
+			return true;
+		}
+		inline bool TryPop(T& value) {
+			return TryPop([&value](T& cell_value) { value = std::move(cell_value); });
+		}
+
+	public:
+		// exact on the consumer thread, a snapshot anywhere else
+		inline bool IsEmpty() const {
+			auto position = m_DequeuePosition.load(std::memory_order_relaxed);
+			return m_Cells[position & m_Mask].Sequence.load(std::memory_order_acquire) != position + 1;
+		}
+		inline SizeType GetApproximateSize() const {
+			auto enqueue_position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			auto dequeue_position = m_DequeuePosition.load(std::memory_order_relaxed);
+			return enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0;
+		}
+		inline SizeType GetCapacity() const { return m_Capacity; }
+
+	protected:
+		constexpr static SizeType RoundUpToPowerOfTwo(SizeType value) {
+			SizeType out{1};
+			while (out < value) { out <<= 1; }
+			return out;
+		}
+
+	protected:
+		const SizeType m_Capacity;
+		const SizeType m_Mask;
+		std::unique_ptr<Cell[]> m_Cells;
+
+		// producers and the consumer write different ends, keep them on separate cache lines
+		alignas(CacheLineSize) std::atomic<SizeType> m_EnqueuePosition;
+		alignas(CacheLineSize) std::atomic<SizeType> m_DequeuePosition; // atomic only so other threads may read it
+	};
+}
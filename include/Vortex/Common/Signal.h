@@ -1,48 +1,117 @@
 #pragma once
 #include <vector>
-#include <functional>
 
+#include "Vortex/Common/Delegate.h"
 #include "Vortex/Memory/Memory.h"
 
 namespace Vortex {
+	//	Receivers are kept packed in one array and called in a plain loop, without holes or null checks.
+	//	Handles point to a slot (index + generation) which maps to the receiver's position in that array,
+	//	Connect reuses slots from a free list and Disconnect moves the last receiver into the hole, both O(1).
+	//	The call order of receivers is not kept across Disconnect.
+	//	Receivers must not connect or disconnect while the signal is being emitted.
 	template<typename ...Args>
 	class Signal {
 	public:
-		using ReceiverFn = std::function<void(Args...)>;
-		using Handle = SizeType;
+		using ReceiverFn = Delegate<void(Args...)>;
+		using Handle = SizeType; // generation << 32 | slot
+
+		constexpr static Handle InvalidHandle = ~Handle{0};
+
+	protected:
+		constexpr static UInt32 NoSlot = ~UInt32{0};
+
+		struct Slot {
+			UInt32 Index; // receiver index, or the next free slot
+			UInt32 Generation;
+		};
 
 	public:
 		inline Handle Connect(const ReceiverFn& function) {
-			for (int i = 0; i < m_Connections.size(); ++i) {
-				if (m_Connections[i] == nullptr) {
-					m_Connections[i] = function;
-					return i;
-				}
+			VORTEX_ASSERT(function.IsBound())
+			VORTEX_ASSERT_MSG(!d_Emitting, "Signal receivers can not be connected while emitting")
+
+			UInt32 slot;
+			if (m_FreeSlot != NoSlot) {
+				slot = m_FreeSlot;
+				m_FreeSlot = m_Slots[slot].Index;
+			} else {
+				slot = static_cast<UInt32>(m_Slots.size());
+				m_Slots.push_back(Slot{0, 0});
 			}
-			m_Connections.emplace_back(function);
-			return m_Connections.size() - 1;
+
+			m_Slots[slot].Index = static_cast<UInt32>(m_Receivers.size());
+			m_Receivers.push_back(function);
+			m_ReceiverSlots.push_back(slot);
+			return static_cast<Handle>(m_Slots[slot].Generation) << 32 | slot;
+		}
+
+		template<auto Method, typename T>
+		inline Handle Connect(T* instance) {
+			return Connect(ReceiverFn::template Bind<Method>(instance));
 		}
 
 		inline void Disconnect(Handle handle) {
-			m_Connections[handle] = nullptr;
+			VORTEX_ASSERT_MSG(!d_Emitting, "Signal receivers can not be disconnected while emitting")
+			VORTEX_ASSERT(IsConnected(handle))
+			if (!IsConnected(handle)) { return; }
+
+			auto slot = static_cast<UInt32>(handle);
+			auto index = m_Slots[slot].Index;
+			auto last_index = static_cast<UInt32>(m_Receivers.size() - 1);
+			if (index != last_index) {
+				m_Receivers[index] = m_Receivers[last_index];
+				m_ReceiverSlots[index] = m_ReceiverSlots[last_index];
+				m_Slots[m_ReceiverSlots[index]].Index = index;
+			}
+			m_Receivers.pop_back();
+			m_ReceiverSlots.pop_back();
+
+			++m_Slots[slot].Generation;
+			m_Slots[slot].Index = m_FreeSlot;
+			m_FreeSlot = slot;
+		}
+
+		inline bool IsConnected(Handle handle) const {
+			auto slot = static_cast<UInt32>(handle);
+			return slot < m_Slots.size() && m_Slots[slot].Generation == static_cast<UInt32>(handle >> 32) && m_Slots[slot].Index < m_Receivers.size() && m_ReceiverSlots[m_Slots[slot].Index] == slot;
 		}
 
-		inline void operator()(Args&& ... args) const {
-			for (const auto& connection :  m_Connections) {
-				if (connection != nullptr) {
-					connection(std::forward<Args>(args)...);
-				}
+		inline void operator()(Args ... args) const {
+#ifdef VORTEX_DEBUG
+			d_Emitting = true;
+#endif
+			for (const auto& receiver : m_Receivers) {
+				receiver(args...);
 			}
+#ifdef VORTEX_DEBUG
+			d_Emitting = false;
+#endif
 		}
 
-		inline void Clear() { m_Connections.Clear(); }
+		inline void Clear() {
+			VORTEX_ASSERT_MSG(!d_Emitting, "Signal receivers can not be disconnected while emitting")
+			for (auto slot : m_ReceiverSlots) {
+				++m_Slots[slot].Generation;
+				m_Slots[slot].Index = m_FreeSlot;
+				m_FreeSlot = slot;
+			}
+			m_Receivers.clear();
+			m_ReceiverSlots.clear();
+		}
 
-		inline SizeType Size() const { return m_Connections.size(); }
-		inline SizeType Empty() const { return m_Connections.empty(); }
+		inline SizeType Size() const { return m_Receivers.size(); }
+		inline bool Empty() const { return m_Receivers.empty(); }
 		inline operator bool() const { return !Empty(); }
 
 	private:
-		std::vector<ReceiverFn> m_Connections;
-	};
+		std::vector<ReceiverFn> m_Receivers;
+		std::vector<UInt32> m_ReceiverSlots; // slot of each receiver, parallel to m_Receivers
+		std::vector<Slot> m_Slots;
+		UInt32 m_FreeSlot{NoSlot};
 
-}
\ No newline at end of file
+#ifdef VORTEX_DEBUG
+		mutable bool d_Emitting{false};
+#endif
+	};
+}
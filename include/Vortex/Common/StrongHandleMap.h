@@ -120,14 +120,14 @@ namespace Vortex {
 				auto stored_gen = m_Generations[index];
 				if (stored_gen == generation) {
 					++stored_gen;
-					if (stored_gen >= Packer::template GetMaxValue<2>()) {
+					if (stored_gen >= Packer::template GetMaxValue<1>()) {
 						stored_gen = 0;
 					}
 					m_FreeList.emplace(index);
 					m_Generations[index] = stored_gen;
 
 #ifdef VORTEX_DEBUG
-					d_ActiveIDs.erase(handle);
+					d_ActiveIDs.erase(handle.id);
 					--d_Size;
 #endif
 				}
@@ -105,14 +105,15 @@ namespace Vortex {
 			std::unique_lock<std::mutex> lock{m_Mutex};
 			for (SizeType i = 0; i < job_count; ++i) {
 				auto start_index = i * chunk_size;
-				m_JobQueue.emplace(new ParallelForJob<T>(array, start_index, chunk_size, foreach_fn));
+				auto job_size = i + 1 == job_count ? count - start_index : chunk_size; // last job takes the remainder
+				m_JobQueue.emplace(new ParallelForJob<T>(array, start_index, job_size, foreach_fn));
 			}
 			return *this;
 		}
 
 		template<typename T>
 		inline ThreadPool& Foreach(std::vector<T>& vector, const ParallelJobFn<T>& foreach_fn) {
-			return Foreach(vector.Data(), vector.Size(), foreach_fn);
+			return Foreach(vector.data(), vector.size(), foreach_fn);
 		}
 /*
 		template<typename ...T>
@@ -124,6 +125,9 @@ namespace Vortex {
 			return *this;
 		}
 */
+	public:
+		inline SizeType GetThreadCount() const { return m_Threads.size(); }
+
 	public:
 		ThreadPool& Await();
 		ThreadPool& Dispatch();
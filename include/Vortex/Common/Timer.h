@@ -1,10 +1,15 @@
 #pragma once
 #include <chrono>
 
+#include "Vortex/Common/CycleClock.h"
+
 namespace Vortex::TimerTraits {
 	using ClockType = std::chrono::steady_clock;
 	using Timepoint = ClockType::time_point;
 
+	// Lower overhead alternative for short regions, see CycleClock.
+	using CycleClockType = Vortex::CycleClock;
+
 	template<typename T>
 	using Seconds = std::chrono::duration<T, std::ratio<1, 1>>;
 
@@ -19,7 +24,7 @@ namespace Vortex::TimerTraits {
 }
 
 namespace Vortex {
-	template<typename T, typename DurationType = TimerTraits::Seconds<T>>
+	template<typename T, typename DurationType = TimerTraits::Seconds<T>, typename Clock = TimerTraits::ClockType>
 	class Timer {
 	public:
 		Timer(): m_Begin{}, m_Time{} {}
@@ -27,10 +32,10 @@ namespace Vortex {
 
 	public:
 		void Start() {
-			m_Begin = TimerTraits::TimeNow();
+			m_Begin = Clock::now();
 		}
 		void Stop() {
-			auto duration = TimerTraits::TimeNow() - m_Begin;
+			auto duration = Clock::now() - m_Begin;
 			m_Time = std::chrono::duration_cast<DurationType>(duration);
 		}
 
@@ -38,22 +43,28 @@ namespace Vortex {
 		operator T() const { return m_Time.count(); }
 
 	private:
-		TimerTraits::Timepoint m_Begin;
+		typename Clock::time_point m_Begin;
 		DurationType m_Time;
 	};
 
-	template<typename T, typename DurationType= TimerTraits::Seconds<T>>
+	template<typename T, typename DurationType= TimerTraits::Seconds<T>, typename Clock = TimerTraits::ClockType>
 	class RAIITimer {
 	public:
 		explicit RAIITimer(T* data_ptr)
-			: m_Begin{TimerTraits::TimeNow()}, m_DataPtr{data_ptr} {}
+			: m_Begin{Clock::now()}, m_DataPtr{data_ptr} {}
 		~RAIITimer() {
-			auto duration = TimerTraits::TimeNow() - m_Begin;
+			auto duration = Clock::now() - m_Begin;
 			*m_DataPtr = std::chrono::duration_cast<DurationType>(duration).count();
 		}
 
 	private:
-		TimerTraits::Timepoint m_Begin;
+		typename Clock::time_point m_Begin;
 		T* m_DataPtr;
 	};
-}
\ No newline at end of file
+
+	template<typename T, typename DurationType = TimerTraits::Seconds<T>>
+	using CycleTimer = Timer<T, DurationType, TimerTraits::CycleClockType>;
+
+	template<typename T, typename DurationType = TimerTraits::Seconds<T>>
+	using RAIICycleTimer = RAIITimer<T, DurationType, TimerTraits::CycleClockType>;
+}
@@ -1,33 +1,133 @@
 #pragma once
-#include <queue>
+#include <filesystem>
+#include <memory>
+#include <vector>
 
 #include "Vortex/Core/Event.h"
+#include "Vortex/Core/EventBus.h"
+#include "Vortex/Core/EventQueue.h"
+#include "Vortex/Core/SessionRecorder.h"
 #include "Vortex/Common/Timer.h"
 
 namespace Vortex {
+	//	Main loop policy, see Application::SetLoopSettings.
+	struct LoopSettings {
+		// seconds per OnFixedUpdate step, 0 runs only the variable OnUpdate
+		float FixedTimeStep{0.0f};
+		// fixed steps per frame at most, time beyond that is dropped so a slow frame can not snowball
+		UInt32 MaxFixedSteps{5};
+		// frames per second, 0 runs uncapped (e.g. paced by vsync)
+		float TargetFrameRate{0.0f};
+		// the end of each frame is waited out by spinning for this long, sleeping before that,
+		// sleep wakes up late by up to a scheduler tick
+		float SpinTime{0.002f};
+	};
+
+	struct FrameTiming {
+		float FrameTime; // dt passed to OnUpdate
+		float WorkTime; // events and updates, without pacing
+		float PacingTime; // slept and spun to reach the target frame rate
+		float DroppedTime; // fixed step time dropped by MaxFixedSteps
+		UInt32 FixedStepCount;
+	};
+
 	class Application {
 	public:
 		virtual void OnStart() = 0;
 		virtual void OnUpdate(float dt) = 0;
+		// called 0..MaxFixedSteps times per frame before OnUpdate when LoopSettings::FixedTimeStep is set
+		virtual void OnFixedUpdate(float /*step*/) {}
 		virtual void OnStop() = 0;
 		virtual void OnEvent(Event& event) = 0;
+		// the frame's events after coalescing, in posting order, override to handle them in one pass
+		virtual void OnEvents(Event* events, SizeType count) {
+			for (SizeType i = 0; i < count; ++i) {
+				OnEvent(events[i]);
+			}
+		}
 
 	public:
+		// starts the profile before OnStart and brackets every frame with VORTEX_DEBUG_PROFILER_FRAME_BEGIN / END
 		void Run();
 
+		// merge consecutive MouseMove / ScrollChange events of a window before dispatch (EventQueue::Coalesce), on by default
+		inline void SetEventCoalescing(bool active) { m_EventCoalescing = active; }
+
+		inline void SetLoopSettings(const LoopSettings& loop_settings) { m_LoopSettings = loop_settings; }
+		inline const LoopSettings& GetLoopSettings() const { return m_LoopSettings; }
+
+		// fraction of a fixed step left in the accumulator, blend the last two fixed states with it when rendering
+		inline float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+
+		// frames_ago < FrameTimingHistorySize, 0 is the last finished frame
+		inline const FrameTiming& GetFrameTiming(SizeType frames_ago = 0) const {
+			VORTEX_ASSERT(frames_ago < FrameTimingHistorySize)
+			return m_FrameTimings[(m_FrameIndex - 1 - frames_ago) % FrameTimingHistorySize];
+		}
+		inline SizeType GetFrameIndex() const { return m_FrameIndex; }
+
+		// Call before Run. Records every frame's events and dt to path (see SessionRecorder).
+		// Events the application posts itself (EventSource::Application / User) are not recorded, a replay posts them again.
+		bool RecordSession(const std::filesystem::path& path);
+		// Call before Run. Frames come from the recorded session instead of the event queue, as fast as possible,
+		// OnUpdate gets the recorded dt. The application quits after the last frame and logs frame time statistics.
+		// Create the renderer headless when IsReplayingSession() is set.
+		bool ReplaySession(const std::filesystem::path& path);
+		inline bool IsReplayingSession() const { return m_SessionPlayer != nullptr; }
+
 	public:
-		inline static void Quit() { EventCallback(Event::CreateApplicationClose()); }
+		inline static void Quit() { PostEvent(Event::CreateApplicationClose(), EventSource::Application); }
 
+		// window event callback (EventCallbackFn)
 		inline static void EventCallback(const Event& event) {
+			PostEvent(event, EventSource::Window);
+		}
+
+		//	Subsystems subscribe here to the event types they handle (Input::Subscribe, Renderer::Subscribe),
+		//	the frame's events are published to them in posting order after OnEvents.
+		inline static EventBus& GetEventBus() {
+			VORTEX_ASSERT(s_Instance != nullptr)
+			return s_Instance->m_EventBus;
+		}
+
+		//	Thread safe, events are handled by OnEvent on the main thread at the start of the next frame.
+		//	Returns false when the event queue is full and the event was dropped, drops are logged once per frame.
+		//	ApplicationClose (Quit) is never dropped.
+		inline static bool PostEvent(const Event& event, EventSource::Enum source) {
 			VORTEX_ASSERT(s_Instance != nullptr)
-			s_Instance->m_EventQueue.emplace(event);
+			return s_Instance->m_EventQueue.Post(event, source);
 		}
 
+	public:
+		constexpr static SizeType FrameTimingHistorySize = 256;
+
 	protected:
 		Application() = default;
 
 		static Application* s_Instance;
-		std::queue<Event> m_EventQueue;
+		EventQueue m_EventQueue;
+		EventBus m_EventBus;
+		std::vector<Event> m_EventBatch;
+		bool m_EventCoalescing{true};
+		SizeType m_ReportedDroppedEventCount{0};
+
+		LoopSettings m_LoopSettings;
+		float m_Accumulator{0.0f};
+		float m_InterpolationAlpha{0.0f};
+		FrameTiming m_FrameTimings[FrameTimingHistorySize]{};
+		SizeType m_FrameIndex{0};
+
+		std::unique_ptr<SessionRecorder> m_SessionRecorder;
+		std::unique_ptr<SessionPlayer> m_SessionPlayer;
+		std::vector<Event> m_SessionEventBatch;
+		std::vector<float> m_ReplayFrameTimes;
+
+	private:
+		// appends the frame's events, returns the dt to update with
+		float GatherFrameEvents_(float dt);
+		void UpdateFixed_(float dt, FrameTiming& timing);
+		float PaceFrame_(TimerTraits::Timepoint frame_begin);
+		void ReportReplay_();
 
 	public:
 		virtual ~Application() = default;
@@ -70,8 +70,33 @@ namespace Vortex {
 		constexpr static bool IsApplication(EventType::Enum type) { return WindowEventCount < type && type < Count; }
 	};
 
+	struct EventSource {
+		enum Enum : UInt8 {
+			Window = 0,
+			Application,
+			Audio,
+			Network,
+			Loader,
+			User,
+
+			Count
+		};
+		constexpr static const char* ToString[]{
+			"Window"
+			, "Application"
+			, "Audio"
+			, "Network"
+			, "Loader"
+			, "User"
+
+			, "Count"
+		};
+	};
+
 	struct Event {
 		EventType::Enum Type;
+		EventSource::Enum Source; // set by EventQueue::Post
+		Int64 Timestamp; // CycleClock nanoseconds at the time the source posted the event
 
 		union {
 			struct {
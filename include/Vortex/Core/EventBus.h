@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+
+#include "Vortex/Common/Signal.h"
+#include "Vortex/Core/Event.h"
+
+namespace Vortex {
+	//	Per EventType subscriber lists, an event only reaches the listeners of its type.
+	//
+	//	Publish delivers immediately, in order. Enqueue collects events per type and Dispatch delivers them
+	//	type by type: batch listeners get all events of their type in one call, event listeners are called
+	//	for each of them. Events of one type keep their order, the order between types is not kept,
+	//	subscribe through Publish (or handle both types in one listener) where that matters.
+	class EventBus {
+	public:
+		using ListenerFn = Delegate<void(const Event&)>;
+		using BatchListenerFn = Delegate<void(const Event*, SizeType)>;
+
+		struct Subscription {
+			EventType::Enum Type;
+			bool IsBatch;
+			SizeType Handle;
+		};
+
+	public:
+		EventBus() = default;
+
+		EventBus(const EventBus&) = delete;
+		EventBus(EventBus&&) = delete;
+
+	public:
+		inline Subscription Subscribe(EventType::Enum type, const ListenerFn& listener) {
+			VORTEX_ASSERT(type < EventType::Count)
+			return Subscription{type, false, m_Listeners[type].Connect(listener)};
+		}
+		template<auto Method, typename T>
+		inline Subscription Subscribe(EventType::Enum type, T* instance) {
+			return Subscribe(type, ListenerFn::template Bind<Method>(instance));
+		}
+
+		inline Subscription SubscribeBatch(EventType::Enum type, const BatchListenerFn& listener) {
+			VORTEX_ASSERT(type < EventType::Count)
+			return Subscription{type, true, m_BatchListeners[type].Connect(listener)};
+		}
+		template<auto Method, typename T>
+		inline Subscription SubscribeBatch(EventType::Enum type, T* instance) {
+			return SubscribeBatch(type, BatchListenerFn::template Bind<Method>(instance));
+		}
+
+		inline void Unsubscribe(const Subscription& subscription) {
+			if (subscription.IsBatch) {
+				m_BatchListeners[subscription.Type].Disconnect(subscription.Handle);
+			} else {
+				m_Listeners[subscription.Type].Disconnect(subscription.Handle);
+			}
+		}
+
+		inline bool HasListeners(EventType::Enum type) const {
+			return !m_Listeners[type].Empty() || !m_BatchListeners[type].Empty();
+		}
+
+	public:
+		// immediate, to the listeners of event.Type only
+		inline void Publish(const Event& event) {
+			m_Listeners[event.Type](event);
+			m_BatchListeners[event.Type](&event, 1);
+		}
+
+		// deferred until Dispatch, events without listeners are not stored
+		inline void Enqueue(const Event& event) {
+			if (HasListeners(event.Type)) {
+				m_Pending[event.Type].push_back(event);
+			}
+		}
+		inline void Enqueue(const Event* events, SizeType count) {
+			for (SizeType i = 0; i < count; ++i) {
+				Enqueue(events[i]);
+			}
+		}
+
+		// Delivers the pending events type by type. Events enqueued by listeners are delivered on the next Dispatch.
+		void Dispatch();
+
+	protected:
+		Signal<const Event&> m_Listeners[EventType::Count];
+		Signal<const Event*, SizeType> m_BatchListeners[EventType::Count];
+
+		std::vector<Event> m_Pending[EventType::Count];
+		std::vector<Event> m_Dispatching[EventType::Count];
+	};
+}
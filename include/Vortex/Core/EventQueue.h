@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <vector>
+
+#include "Vortex/Common/CycleClock.h"
+#include "Vortex/Common/MPSCQueue.h"
+#include "Vortex/Core/Event.h"
+
+namespace Vortex {
+	//	Events posted from any thread (window callbacks, audio, loaders), drained once per frame by the main thread.
+	//	Posting is lock-free, a full queue drops the event and counts it: the main thread itself posts window
+	//	events while polling, so it must never wait for the consumer. ApplicationClose is never dropped, a full
+	//	queue keeps it in a flag and the next Drain appends it after the events it pops.
+	class EventQueue {
+	public:
+		constexpr static SizeType DefaultCapacity = 4096;
+
+	public:
+		explicit EventQueue(SizeType capacity = DefaultCapacity)
+			: m_Events{capacity},
+			  m_DroppedEventCount{0},
+			  m_OverflowClose{false},
+			  m_OverflowCloseSource{EventSource::Application},
+			  m_OverflowCloseTimestamp{0} {}
+
+		EventQueue(const EventQueue&) = delete;
+		EventQueue(EventQueue&&) = delete;
+
+	public:
+		// stamps the event with source and the current time, returns false if the event was dropped
+		inline bool Post(const Event& event, EventSource::Enum source) {
+			auto timestamp = CycleClock::now().time_since_epoch().count();
+			bool posted = m_Events.TryPush([&](Event& queued_event) {
+				queued_event = event;
+				queued_event.Source = source;
+				queued_event.Timestamp = timestamp;
+			});
+			if (posted) {
+				return true;
+			}
+
+			if (event.Type == EventType::ApplicationClose) {
+				m_OverflowCloseSource.store(source, std::memory_order_relaxed);
+				m_OverflowCloseTimestamp.store(timestamp, std::memory_order_relaxed);
+				m_OverflowClose.store(true, std::memory_order_release);
+				return true;
+			}
+			m_DroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		// Single consumer. Appends at most max_count events to batch, returns the number appended.
+		// Events posted while the batch is handled wait for the next drain, a busy producer can not stall the frame.
+		inline SizeType Drain(std::vector<Event>& batch, SizeType max_count) {
+			SizeType count{0};
+			while (count < max_count && m_Events.TryPop([&batch](const Event& event) { batch.push_back(event); })) {
+				++count;
+			}
+
+			// may go over max_count, the close must not wait for another drain
+			if (m_OverflowClose.load(std::memory_order_relaxed) && m_OverflowClose.exchange(false, std::memory_order_acquire)) {
+				auto event = Event::CreateApplicationClose();
+				event.Source = m_OverflowCloseSource.load(std::memory_order_relaxed);
+				event.Timestamp = m_OverflowCloseTimestamp.load(std::memory_order_relaxed);
+				batch.push_back(event);
+				++count;
+			}
+			return count;
+		}
+
+		// Merges runs of MouseMove and ScrollChange events of the same window in place, keeping the position of the
+		// first event of each run: a MouseMove keeps the latest cursor position, a ScrollChange the summed offsets,
+		// both the latest timestamp. The two types are merged independently, Input tracks cursor and scroll apart,
+		// so a scroll does not end a move run and a frame dispatches at most one of each between other events.
+		// A run ends at any other event of that window, so presses and releases still see the cursor where it was.
+		// Returns the number of events removed.
+		static SizeType Coalesce(std::vector<Event>& batch);
+
+		inline bool IsEmpty() const { return m_Events.IsEmpty(); }
+		inline SizeType GetCapacity() const { return m_Events.GetCapacity(); }
+		inline SizeType GetDroppedEventCount() const { return m_DroppedEventCount.load(std::memory_order_relaxed); }
+
+	protected:
+		MPSCQueue<Event> m_Events;
+		std::atomic<SizeType> m_DroppedEventCount;
+
+		// ApplicationClose posted while the queue was full
+		std::atomic<bool> m_OverflowClose;
+		std::atomic<EventSource::Enum> m_OverflowCloseSource;
+		std::atomic<Int64> m_OverflowCloseTimestamp;
+	};
+}
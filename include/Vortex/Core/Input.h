@@ -1,6 +1,7 @@
 #pragma once
 #include "Vortex/Core/Keycode.h"
 #include "Vortex/Core/Event.h"
+#include "Vortex/Core/EventBus.h"
 #include "Vortex/Math/VortexMath.h"
 
 namespace Vortex {
@@ -17,9 +18,16 @@ namespace Vortex {
 		Input();
 		virtual ~Input();
 
+		Input(const Input&) = delete;
+		Input& operator=(const Input&) = delete;
+
 	public:
 		void Update();
-		void OnEvent(const Event& event);
+
+		//	Receives the key, char, mouse button, mouse move and scroll events of event_bus (e.g. Application::GetEventBus).
+		//	Subscribed until Unsubscribe or destruction, the bus must outlive the subscription.
+		void Subscribe(EventBus& event_bus);
+		void Unsubscribe();
 
 	public: // cursor
 		Math::Vector2 CursorSensivity;
@@ -48,6 +56,16 @@ namespace Vortex {
 		constexpr static UInt8 StateDown{1 << 1};
 
 	protected:
+		void OnKeyEvent(const Event& event);
+		void OnCharInput(const Event& event);
+		void OnMouseButtonEvent(const Event& event);
+		void OnMouseMove(const Event& event);
+		void OnScrollChange(const Event& event);
+
+	protected:
+		EventBus* m_EventBus{nullptr};
+		std::vector<EventBus::Subscription> m_Subscriptions;
+
 		Math::Vector2 m_LastCursorPosition;
 		Math::Vector2 m_CursorPosition;
 		Math::Vector2 m_CursorDelta;
@@ -0,0 +1,62 @@
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "Vortex/Core/Event.h"
+
+namespace Vortex {
+	//	Recorded session: the events and the dt of every frame, as Application::Run saw them.
+	//	Replaying a session feeds the same input in the same frames, so runs can be compared for performance.
+	//
+	//	File layout (little endian):
+	//		header: [UInt64 Magic][UInt32 Version][UInt32 reserved]
+	//		frame:  [UInt32 event count][float dt] then per event [UInt8 type][UInt8 source][payload]
+	//	The payload is the event's union member for its type, see GetPayloadSize.
+	//	WindowPathDrop events are not recorded, their paths only live during the callback.
+	namespace Session {
+		constexpr static UInt64 Magic = 0x4E4F495353455856ull; // "VXSESSIO"
+		constexpr static UInt32 Version = 1;
+
+		SizeType GetPayloadSize(EventType::Enum type);
+	}
+
+	class SessionRecorder {
+	public:
+		explicit SessionRecorder(const std::filesystem::path& path);
+		~SessionRecorder();
+
+		SessionRecorder(const SessionRecorder&) = delete;
+		SessionRecorder(SessionRecorder&&) = delete;
+
+	public:
+		inline bool IsOpen() const { return m_File.is_open(); }
+		inline SizeType GetFrameCount() const { return m_FrameCount; }
+
+		void WriteFrame(const Event* events, SizeType count, float dt);
+
+	protected:
+		std::ofstream m_File;
+		SizeType m_FrameCount;
+	};
+
+	class SessionPlayer {
+	public:
+		explicit SessionPlayer(const std::filesystem::path& path);
+
+		SessionPlayer(const SessionPlayer&) = delete;
+		SessionPlayer(SessionPlayer&&) = delete;
+
+	public:
+		inline bool IsOpen() const { return m_Valid; }
+		inline SizeType GetFrameCount() const { return m_FrameCount; }
+
+		// Appends the next frame's events to events, returns false at the end of the session or on a damaged frame.
+		bool ReadFrame(std::vector<Event>& events, float& dt);
+
+	protected:
+		std::ifstream m_File;
+		bool m_Valid;
+		SizeType m_FrameCount;
+	};
+}
@@ -46,6 +46,34 @@
 //	}
 //
 //	=============== Example Code ===============
+//
+//	Application::Run begins the profile and brackets every frame itself, games only add zones and counters.
+//
+//	Timeline capture:
+//	Aggregated tables hide when a spike happens and on which thread. Timeline mode records every zone instance
+//	with its thread and nesting depth, grouped by frame. Only the last N frames are kept, so it can stay enabled.
+//
+//		VORTEX_DEBUG_PROFILER_TIMELINE_BEGIN(300)                            // keep last 300 frames
+//		VORTEX_DEBUG_PROFILER_TIMELINE_CAPTURE("Profiler_Timeline.json")     // dump them at the end of the current frame
+//
+//	If the timeline is not active, a capture request records the next VORTEX_DEBUG_PROFILER_TIMELINE_FRAMES frames instead.
+//	".json" files are written in Chrome Trace Event format (chrome://tracing, ui.perfetto.dev),
+//	".pftrace" files are written in Perfetto protobuf trace format.
+//
+//	Latency statistics:
+//	Every zone and the frame time are recorded into a LatencyHistogram (log buckets, fixed size), so p50/p90/p99/p99.9
+//	and variance are available for runs of any length. Use QueryFrameStatistics/QueryZoneStatistics while running.
+//
+//	Counters:
+//	Numeric series sampled once per frame (draw calls, uploaded bytes, live handles...).
+//
+//		VORTEX_DEBUG_PROFILER_COUNTER("Draw Calls", 1)              // added up during the frame, reset at frame end
+//		VORTEX_DEBUG_PROFILER_COUNTER_SET("Live Handles", count)    // keeps its value until set again
+//
+//	Each macro registers its name once per call site and then updates a per-counter atomic, so the name must not
+//	change between calls. Up to VORTEX_DEBUG_PROFILER_MAX_COUNTERS counters can be registered.
+//	The last VORTEX_DEBUG_PROFILER_COUNTER_FRAMES samples are kept per counter, min/max/mean cover the whole profile.
+//	Counters are written with the profile results and as counter tracks in timeline captures.
 
 #pragma once
 #ifdef VORTEX_DEBUG
@@ -58,6 +86,29 @@
 #include <fstream>
 #include <cstdio>
 #include <utility>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+#include "Vortex/Common/CycleClock.h"
+
+#ifndef VORTEX_DEBUG_PROFILER_TIMELINE_FRAMES
+  #define VORTEX_DEBUG_PROFILER_TIMELINE_FRAMES 120
+#endif
+
+// Clock used for zones and frames. Vortex::CycleClock reads the CPU timestamp counter,
+// which is several times cheaper than steady_clock and skews short zones less.
+#ifndef VORTEX_DEBUG_PROFILER_CLOCK
+  #define VORTEX_DEBUG_PROFILER_CLOCK std::chrono::steady_clock
+#endif
+
+#ifndef VORTEX_DEBUG_PROFILER_COUNTER_FRAMES
+  #define VORTEX_DEBUG_PROFILER_COUNTER_FRAMES 300
+#endif
+
+#ifndef VORTEX_DEBUG_PROFILER_MAX_COUNTERS
+  #define VORTEX_DEBUG_PROFILER_MAX_COUNTERS 256
+#endif
 
 namespace Vortex::DebugProfiler {
 	struct RawProfileData;
@@ -67,13 +118,69 @@ namespace Vortex::DebugProfiler {
 
 	using CallCountType = std::uint64_t;
 	using DurationType = std::chrono::duration<double, std::ratio<1, 1000>>;
+	using ClockType = VORTEX_DEBUG_PROFILER_CLOCK;
+
+	using TimestampType = std::int64_t; // nanoseconds since BeginProfile
+	using ThreadIDType = std::uint32_t;
+	using NodeIndexType = std::uint32_t;
+	using CounterIDType = std::uint32_t;
+
+	struct LatencyStatistics {
+		DurationType MinTime{0};
+		DurationType MaxTime{0};
+		DurationType MeanTime{0};
+		double Variance{0}; // ms^2
+
+		DurationType P50{0};
+		DurationType P90{0};
+		DurationType P99{0};
+		DurationType P999{0};
+	};
+
+	// HDR-histogram style latency histogram with a fixed memory footprint.
+	// Every power of two nanoseconds is split into 2^SubBucketBits linear buckets,
+	// so each recorded value is kept with ~3% relative precision from 1ns up to ~39 hours.
+	class LatencyHistogram {
+	public:
+		constexpr static std::uint32_t SubBucketBits = 5;
+		constexpr static std::uint32_t SubBucketCount = 1u << SubBucketBits;
+		constexpr static std::uint32_t MaxExponent = 47;
+		constexpr static std::uint32_t BucketCount = SubBucketCount * (MaxExponent - SubBucketBits + 2);
+
+	public:
+		void Record(const DurationType& elapsed);
+		void Merge(const LatencyHistogram& other);
+		void Reset();
+
+		CallCountType GetCount() const { return m_Count; }
+		DurationType GetValueAtPercentile(double percentile) const; // percentile in [0, 100]
+		LatencyStatistics GetStatistics() const;
+
+		// Bucket range in nanoseconds, for printing or exporting the distribution.
+		static std::uint64_t GetBucketLowerBound(std::uint32_t index);
+		static std::uint64_t GetBucketUpperBound(std::uint32_t index);
+		CallCountType GetBucketCount(std::uint32_t index) const { return m_Buckets[index]; }
+
+	private:
+		static std::uint32_t GetBucketIndex(std::uint64_t value);
+
+	private:
+		std::array<CallCountType, BucketCount> m_Buckets{};
+		CallCountType m_Count{0};
+		std::uint64_t m_Min{UINT64_MAX};
+		std::uint64_t m_Max{0};
+		double m_Mean{0};
+		double m_M2{0};
+	};
 
 	struct RawProfileData {
 		DurationType TotalTime;
 		DurationType MaxTime;
 		CallCountType CallCount;
+		LatencyHistogram Histogram;
 
 		void AddTime(const DurationType& elapsed);
+		void Merge(const RawProfileData& other);
 	};
 
 	struct ProfilerResultData {
@@ -82,6 +189,7 @@ namespace Vortex::DebugProfiler {
 		DurationType MaxTime;
 		DurationType AverageTime;
 		CallCountType CallCount;
+		LatencyStatistics Latency;
 
 		double Utilization;
 
@@ -90,15 +198,52 @@ namespace Vortex::DebugProfiler {
 						   DurationType max_time,
 						   DurationType average_time,
 						   CallCountType call_count,
+						   const LatencyStatistics& latency,
 						   double utilization);
 	};
 
+	// A zone in the call tree, keyed by its name and the chain of parents above it.
+	// Inclusive time contains the children, exclusive time does not.
+	struct CallTreeResultData {
+		NameType Name;
+		NodeIndexType Parent; // index into CallTreeResult::Nodes, root nodes point to themselves
+		std::uint32_t Depth;
+
+		DurationType InclusiveTime;
+		DurationType ExclusiveTime;
+		DurationType InclusiveTimePerFrame;
+		DurationType ExclusiveTimePerFrame;
+		CallCountType CallCount;
+		double CallsPerFrame;
+	};
+
+	struct CallTreeResult {
+		ThreadIDType ThreadID;
+		NameType ThreadName;
+		std::vector<CallTreeResultData> Nodes; // depth-first order
+	};
+
+	struct CounterResultData {
+		NameType Name;
+		double MinValue;
+		double MaxValue;
+		double MeanValue;
+		double LastValue;
+		CallCountType SampleCount;
+		std::vector<double> History; // last VORTEX_DEBUG_PROFILER_COUNTER_FRAMES samples, oldest first
+	};
+
 	struct ProfilerResult {
 		std::vector<ProfilerResultData> Data;
+		std::vector<CounterResultData> Counters;
 		std::vector<ProfilerResultData> FrameData;
+		std::vector<CallTreeResult> CallTrees;
 		DurationType TotalTime;
 		DurationType TotalFrameTime;
 		std::size_t FrameCount;
+
+		LatencyStatistics FrameTimeStatistics;
+		LatencyHistogram FrameTimeHistogram;
 	};
 
 	void BeginProfile();
@@ -107,14 +252,96 @@ namespace Vortex::DebugProfiler {
 	void BeginFrame();
 	void EndFrame();
 
+	// Runtime queries, cover everything recorded since BeginProfile.
+	// Zone statistics merge the frame and application scopes of the zone.
+	LatencyStatistics QueryFrameStatistics();
+	LatencyStatistics QueryZoneStatistics(const KeyType& name);
+	const LatencyHistogram& GetFrameHistogram();
+	bool GetZoneHistogram(const KeyType& name, LatencyHistogram& histogram);
+
+	// Counters are thread safe and sampled at EndFrame.
+	// Registering returns the same id for the same name, updating by id is lock-free.
+	constexpr CounterIDType InvalidCounterID = VORTEX_DEBUG_PROFILER_MAX_COUNTERS;
+	CounterIDType RegisterCounter(const KeyType& name);
+	void AddCounter(CounterIDType counter_id, double value);
+	void SetCounter(CounterIDType counter_id, double value);
+	// Look the name up on every call, for names only known at runtime.
+	void AddCounter(const KeyType& name, double value);
+	void SetCounter(const KeyType& name, double value);
+	bool GetCounterHistory(const KeyType& name, std::vector<double>& history); // oldest first
+
 	void WriteToStream(std::ostream& ostream, const ProfilerResult& result);
+	// Writes the table to path and the call tree as collapsed stacks next to it with ".folded" extension.
 	void WriteToFile(const std::filesystem::path& path, const ProfilerResult& result);
+
+	// One "thread;parent;child microseconds" line per call tree node, using exclusive time.
+	// Compatible with flamegraph.pl, speedscope and inferno.
+	void WriteCollapsedStacks(std::ostream& ostream, const ProfilerResult& result);
+}
+
+namespace Vortex::DebugProfiler {
+	struct TimelineEvent {
+		NameType Name;
+		TimestampType Start;
+		TimestampType Duration;
+		ThreadIDType ThreadID;
+		std::uint32_t Depth;
+	};
+
+	struct TimelineCounter {
+		NameType Name;
+		double Value;
+	};
+
+	struct TimelineFrame {
+		std::size_t FrameIndex;
+		TimestampType Start;
+		TimestampType Duration;
+		std::vector<TimelineEvent> Events;
+		std::vector<TimelineCounter> Counters; // sampled at the end of the frame
+	};
+
+	struct TimelineThread {
+		ThreadIDType ThreadID;
+		NameType Name;
+	};
+
+	struct TimelineCapture {
+		std::vector<TimelineThread> Threads;
+		std::vector<TimelineFrame> Frames; // oldest first
+	};
+
+	// Names the calling thread in timeline captures.
+	void SetThreadName(const NameType& name);
+
+	// Starts recording zone instances, keeping only the last frame_count frames.
+	void BeginTimeline(std::size_t frame_count);
+	void EndTimeline();
+	bool IsTimelineActive();
+
+	// Copies the frames currently held by the timeline.
+	TimelineCapture CaptureTimeline();
+
+	// Writes the timeline to path at the end of the current frame.
+	// If the timeline is not active, records the next frame_count frames and writes them instead.
+	void RequestTimelineCapture(const std::filesystem::path& path, std::size_t frame_count = VORTEX_DEBUG_PROFILER_TIMELINE_FRAMES);
+
+	void WriteChromeTrace(std::ostream& ostream, const TimelineCapture& capture);
+	void WritePerfettoTrace(std::ostream& ostream, const TimelineCapture& capture);
+	// Selects the format by extension: ".pftrace" or ".perfetto-trace" is Perfetto, everything else is Chrome JSON.
+	void WriteTimelineToFile(const std::filesystem::path& path, const TimelineCapture& capture);
+
+	struct ThreadProfileData;
 }
+
 namespace Vortex {
 	class UniqueProfiler {
 	private:
 		DebugProfiler::KeyType m_Name;
-		std::chrono::steady_clock::time_point m_Start;
+		DebugProfiler::ThreadProfileData* m_ThreadData;
+		DebugProfiler::NodeIndexType m_Node;
+		std::uint32_t m_Depth;
+		DebugProfiler::ClockType::time_point m_Start;
 
 	public:
 		explicit UniqueProfiler(DebugProfiler::KeyType name);
@@ -129,6 +356,18 @@ namespace Vortex {
 #define VORTEX_DEBUG_PROFILER_FRAME_BEGIN Vortex::DebugProfiler::BeginFrame();
 #define VORTEX_DEBUG_PROFILER_FRAME_END Vortex::DebugProfiler::EndFrame();
 
+#define VORTEX_DEBUG_PROFILER_COUNTER(name, value) { \
+static const auto dpc = Vortex::DebugProfiler::RegisterCounter(name); \
+Vortex::DebugProfiler::AddCounter(dpc, static_cast<double>(value)); }
+#define VORTEX_DEBUG_PROFILER_COUNTER_SET(name, value) { \
+static const auto dpc = Vortex::DebugProfiler::RegisterCounter(name); \
+Vortex::DebugProfiler::SetCounter(dpc, static_cast<double>(value)); }
+
+#define VORTEX_DEBUG_PROFILER_THREAD(name) Vortex::DebugProfiler::SetThreadName(name);
+#define VORTEX_DEBUG_PROFILER_TIMELINE_BEGIN(frame_count) Vortex::DebugProfiler::BeginTimeline(frame_count);
+#define VORTEX_DEBUG_PROFILER_TIMELINE_END Vortex::DebugProfiler::EndTimeline();
+#define VORTEX_DEBUG_PROFILER_TIMELINE_CAPTURE(file_path) Vortex::DebugProfiler::RequestTimelineCapture(std::filesystem::path{file_path});
+
 #define VORTEX_DEBUG_PROFILER_END_TOFILE(path)\
 auto profile = Vortex::DebugProfiler::EndProfile();\
 Vortex::DebugProfiler::WriteToFile(path,profile);
@@ -150,6 +389,14 @@ VORTEX_DEBUG_PROFILER_END_TOFILE(std::filesystem::path{file_name})
 #define VORTEX_DEBUG_PROFILER_FRAME_BEGIN
 #define VORTEX_DEBUG_PROFILER_FRAME_END
 
+#define VORTEX_DEBUG_PROFILER_COUNTER(name, value)
+#define VORTEX_DEBUG_PROFILER_COUNTER_SET(name, value)
+
+#define VORTEX_DEBUG_PROFILER_THREAD(name)
+#define VORTEX_DEBUG_PROFILER_TIMELINE_BEGIN(frame_count)
+#define VORTEX_DEBUG_PROFILER_TIMELINE_END
+#define VORTEX_DEBUG_PROFILER_TIMELINE_CAPTURE(file_path)
+
 #define VORTEX_DEBUG_PROFILER_END_TOFILE(path)
 #define VORTEX_DEBUG_PROFILER_END_TOSTREAM(ostream)
 #define VORTEX_DEBUG_PROFILER_END
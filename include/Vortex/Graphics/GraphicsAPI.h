@@ -9,6 +9,7 @@ namespace Vortex {
 			None = 0,
 			OpenGL45,
 			Vulkan,
+			Null, // headless, counts instead of drawing
 
 			Count
 		};
@@ -16,6 +17,7 @@ namespace Vortex {
 			"None"
 			, "OpenGL45"
 			, "Vulkan"
+			, "Null"
 		};
 	}
 
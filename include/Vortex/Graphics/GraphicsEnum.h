@@ -175,7 +175,13 @@ namespace Vortex::Graphics {
 		enum Enum {
 			Undefined = 0,
 			Lit = 1 << 1,
-			Instanced = 1 << 2
+			// transform comes from the per-instance attribute at ShaderConstants::InstanceTransformLocation
+			// instead of the Transform uniform, equal draws are merged into one instanced draw
+			Instanced = 1 << 2,
+			// opaque and translucent draws of pooled meshes are collapsed into one multi draw indirect per shader,
+			// transform and material index come from the DrawData storage block indexed by the draw index attribute,
+			// set by the backend when the shader declares the block
+			MultiDraw = 1 << 3
 		};
 	}
 
@@ -499,10 +505,28 @@ namespace Vortex::Graphics {
 			"Transform"
 			, "View"
 			, "Projection"
-			, "ViewProjection"
 
 			, "Resolution"
 		};
+		VORTEX_STATIC_ASSERT_MSG(sizeof(ToString) / sizeof(*ToString) == Count, "ShaderConstants::ToString does not match Enum.")
+		VORTEX_STATIC_ASSERT_MSG(sizeof(Type) / sizeof(*Type) == Count, "ShaderConstants::Type does not match Enum.")
+		VORTEX_STATIC_ASSERT_MSG(sizeof(ToHashedString) / sizeof(*ToHashedString) == Count, "ShaderConstants::ToHashedString does not match Enum.")
+
+		// mat4 vertex attribute of ShaderTags::Instanced shaders, takes locations 12 to 15
+		// e.g. layout(location = 12) in mat4 a_InstanceTransform;
+		constexpr UInt32 InstanceTransformLocation = 12;
+
+		// ShaderTags::MultiDraw shaders:
+		//	layout(location = 11) in uint a_DrawIndex;
+		//	struct Draw { mat4 Transform; uint MaterialIndex; };
+		//	layout(std430, binding = 0) readonly buffer DrawData { Draw Draws[]; };
+		// optional, Material::Data of the frame's multi draw materials indexed by MaterialIndex, 256 bytes apart:
+		//	layout(std430, binding = 1) readonly buffer MaterialData { MyMaterial Materials[]; };
+		constexpr UInt32 DrawIndexLocation = 11;
+		constexpr UInt32 DrawDataBinding = 0;
+		constexpr const char* DrawDataBlockName = "DrawData";
+		constexpr UInt32 MaterialDataBinding = 1;
+		constexpr const char* MaterialDataBlockName = "MaterialData";
 	}
 
 }
\ No newline at end of file
@@ -60,14 +60,23 @@ namespace Vortex::Graphics {
 		Graphics::BufferLayout Layout;
 		bool Mutable;
 		SizeType Size;
+		SizeType Offset; // start of the contents in the API buffer, moves when the backend multi-buffers it
 
 		AdditionalData AdditionalData;
 	};
 
+	struct ShaderUniform {
+		HashedString Name;
+		Int32 Location{-1}; // uniform location or block index, -1 marks an unused slot
+		Int32 Binding{-1}; // texture unit or block binding point
+		Graphics::ElementType::Enum Type{Graphics::ElementType::Count};
+	};
+
 	struct Shader {
-		std::unordered_map<HashedString, int> Locations;
-		std::unordered_map<HashedString, Graphics::ElementType::Enum> Types;
-		std::unordered_map<HashedString, int> BindingPositions;
+		// engine uniforms resolved at link time, indexed by ShaderConstants::Enum
+		ShaderUniform ConstantUniforms[ShaderConstants::Count];
+		// all uniforms and blocks by name, see Renderer::FindShaderUniform
+		std::vector<ShaderUniform> Uniforms;
 		ShaderTags::Enum Tags;
 
 		AdditionalData AdditionalData;
@@ -88,6 +97,11 @@ namespace Vortex::Graphics {
 
 		Graphics::Topology::Enum Topology;
 
+		// meshes of a MeshPool share its buffers and vertex array, their data starts at these offsets
+		Handle PoolHandle;
+		SizeType BaseVertex;
+		SizeType FirstIndex;
+
 		AdditionalData AdditionalData;
 
 #ifdef VORTEX_DEBUG
@@ -95,6 +109,22 @@ namespace Vortex::Graphics {
 #endif
 	};
 
+	// Vertex and index buffers meshes are sub-allocated from, so draws of different meshes can share one multi draw.
+	// Allocation only moves forward, the space comes back when the pool is destroyed.
+	struct MeshPool {
+		Handle IndexBufferHandle;
+		std::vector<Handle> BufferHandles;
+
+		SizeType VertexCapacity;
+		SizeType IndexCapacity;
+		SizeType VertexCount;
+		SizeType IndexCount;
+
+		Graphics::Topology::Enum Topology;
+
+		AdditionalData AdditionalData;
+	};
+
 	struct DrawSurface {
 		Math::RectangleInt Area;
 		Math::Color ClearColor;
@@ -148,6 +178,7 @@ namespace Vortex::Graphics {
 
 		ComputeShader,
 		Mesh,
+		MeshPool,
 		Material,
 		DrawSurface,
 		View,
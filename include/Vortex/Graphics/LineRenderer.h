@@ -23,6 +23,7 @@ namespace Vortex::Graphics {
 		inline void Destroy(Handle line_mesh_handle) {
 			VORTEX_ASSERT(IsValid(line_mesh_handle))
 			const auto& line_mesh = m_LineMeshes.at(line_mesh_handle);
+			m_Renderer->WaitIdle();
 			m_Renderer->DestroyMesh(line_mesh_handle);
 			m_LineMeshes.erase(line_mesh_handle);
 		}
@@ -35,6 +36,9 @@ namespace Vortex::Graphics {
 		};
 
 	public:
+		//	End uploads the baked lines into the mesh. With a pipelined renderer it first calls WaitIdle, which
+		//	drains every frame in flight and takes the context back, so baking every frame removes the
+		//	overlap with the render thread. Bake once and redraw, or keep per-frame baking serial.
 		void Begin();
 		void Insert(const Math::Vector3& position1, const Math::Vector3& position2, const Math::Color& color);
 		void End(Handle line_mesh_handle);
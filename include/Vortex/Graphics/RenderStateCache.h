@@ -0,0 +1,125 @@
+#pragma once
+#include "Vortex/Memory/Memory.h"
+#include "Vortex/Graphics/GraphicsEnum.h"
+
+namespace Vortex::Graphics {
+	//	Shadow copy of the pipeline state a backend sets per view, draw surface, material and draw, without a graphics API.
+	//	A setter returns true when the value differs from the tracked one and the backend has to issue the call,
+	//	every call is counted as issued or filtered. Object names are opaque to the cache (API names, or handles
+	//	for the NullRenderer). State set behind the cache's back and names deleted and reused between frames are
+	//	not tracked, so backends invalidate the cache at the start of every frame and when they switch contexts.
+	class RenderStateCache {
+	public:
+		constexpr static SizeType MaxTextureUnits = 32; // higher units are always issued
+		using NameType = UInt32;
+
+		struct Counters {
+			SizeType Issued;
+			SizeType Filtered;
+		};
+
+	public:
+		RenderStateCache() { Invalidate(); }
+
+	public:
+		// forgets all tracked state, the next call of each setter is issued
+		inline void Invalidate() {
+			m_Blend = Unknown;
+			m_BlendMode = Blending::Count;
+			m_DepthTest = Unknown;
+			m_DepthMask = Unknown;
+			m_DepthFunc = DepthTesting::Count;
+			m_StencilMask = InvalidName;
+			m_ColorMask = Unknown;
+			m_ScissorTest = Unknown;
+			m_Scissor = {0, 0, -1, -1};
+			m_Viewport = {0, 0, -1, -1};
+			m_Program = InvalidName;
+			m_VertexArray = InvalidName;
+			m_Framebuffer = InvalidName;
+			for (auto& texture : m_TextureUnits) {
+				texture = InvalidName;
+			}
+		}
+		inline void ResetCounters() { m_Counters = {}; }
+		inline const Counters& GetCounters() const { return m_Counters; }
+
+	public:
+		inline bool SetBlend(bool enabled) { return Filter(m_Blend, enabled); }
+		// blend factors of a non opaque Blending mode
+		inline bool SetBlendMode(Blending::Enum blending) { return Filter(m_BlendMode, blending); }
+		inline bool SetDepthTest(bool enabled) { return Filter(m_DepthTest, enabled); }
+		inline bool SetDepthMask(bool enabled) { return Filter(m_DepthMask, enabled); }
+		inline bool SetDepthFunc(DepthTesting::Enum depth_test) { return Filter(m_DepthFunc, depth_test); }
+		inline bool SetStencilMask(UInt32 mask) { return Filter(m_StencilMask, mask); }
+		// all channels at once, the renderer never masks single channels
+		inline bool SetColorMask(bool enabled) { return Filter(m_ColorMask, enabled); }
+		inline bool SetScissorTest(bool enabled) { return Filter(m_ScissorTest, enabled); }
+		inline bool SetScissor(Int32 x, Int32 y, Int32 width, Int32 height) { return FilterRectangle(m_Scissor, x, y, width, height); }
+		inline bool SetViewport(Int32 x, Int32 y, Int32 width, Int32 height) { return FilterRectangle(m_Viewport, x, y, width, height); }
+
+	public:
+		inline bool UseProgram(NameType program) { return Filter(m_Program, program); }
+		inline bool BindVertexArray(NameType vertex_array) { return Filter(m_VertexArray, vertex_array); }
+		inline bool BindFramebuffer(NameType framebuffer) { return Filter(m_Framebuffer, framebuffer); }
+		inline bool BindTextureUnit(UInt32 unit, NameType texture) {
+			if (unit >= MaxTextureUnits) {
+				++m_Counters.Issued;
+				return true;
+			}
+			return Filter(m_TextureUnits[unit], texture);
+		}
+
+	private:
+		struct Rectangle {
+			Int32 X;
+			Int32 Y;
+			Int32 Width;
+			Int32 Height;
+		};
+
+		// true when the call has to be issued, the tracked value is updated then
+		template<typename T, typename V>
+		inline bool Filter(T& tracked, V value) {
+			auto new_value = static_cast<T>(value);
+			if (tracked == new_value) {
+				++m_Counters.Filtered;
+				return false;
+			}
+			tracked = new_value;
+			++m_Counters.Issued;
+			return true;
+		}
+		inline bool FilterRectangle(Rectangle& tracked, Int32 x, Int32 y, Int32 width, Int32 height) {
+			if (tracked.X == x && tracked.Y == y && tracked.Width == width && tracked.Height == height) {
+				++m_Counters.Filtered;
+				return false;
+			}
+			tracked = {x, y, width, height};
+			++m_Counters.Issued;
+			return true;
+		}
+
+	private:
+		constexpr static Int32 Unknown = -1; // toggles hold 0, 1 or Unknown
+		constexpr static NameType InvalidName = ~0u;
+
+		Int32 m_Blend;
+		Blending::Enum m_BlendMode;
+		Int32 m_DepthTest;
+		Int32 m_DepthMask;
+		DepthTesting::Enum m_DepthFunc;
+		UInt32 m_StencilMask;
+		Int32 m_ColorMask;
+		Int32 m_ScissorTest;
+		Rectangle m_Scissor;
+		Rectangle m_Viewport;
+
+		NameType m_Program;
+		NameType m_VertexArray;
+		NameType m_Framebuffer;
+		NameType m_TextureUnits[MaxTextureUnits];
+
+		Counters m_Counters{};
+	};
+}
\ No newline at end of file
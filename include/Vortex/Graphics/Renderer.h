@@ -1,5 +1,15 @@
 #pragma once
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "Vortex/Core/Event.h"
+#include "Vortex/Core/EventBus.h"
 
 #include "Vortex/Math/VortexMath.h"
 
@@ -10,10 +20,17 @@
 #include "Vortex/Graphics/MeshLayout.h"
 #include "Vortex/Graphics/GraphicsStructs.h"
 
+namespace Vortex {
+	class ThreadPool;
+}
+
 namespace Vortex::Graphics {
 	class Renderer {
 	public:
-		virtual ~Renderer() = default;
+		virtual ~Renderer() {
+			VORTEX_ASSERT_MSG(!m_RenderThread.joinable(), "Backends stop the render thread with SetFramesInFlight(0) in their destructor")
+			Unsubscribe();
+		}
 
 	public:    // Window
 		virtual Handle CreateWindow(const Resolution& resolution, const char* title) = 0;
@@ -91,6 +108,7 @@ namespace Vortex::Graphics {
 		virtual Handle CreateComputeShader(const char* source, OnComputeShaderBindFn on_compute_shader_bind) = 0;
 		template<typename T>
 		inline T& GetComputeShaderData(Handle compute_shader_handle) {
+			VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] GetComputeShaderData called while frames are in flight, call WaitIdle first.")
 			VORTEX_ASSERT(d_ComputeShaderChecks(compute_shader_handle))
 			return m_DataMap.Get<ComputeShader>(compute_shader_handle).Data.template Layout<T>();
 		}
@@ -115,6 +133,19 @@ namespace Vortex::Graphics {
 		virtual void SetMeshData(Handle mesh_handle, SizeType index, const void* data, SizeType size) = 0;
 		virtual void DestroyMesh(Handle mesh_handle) = 0;
 
+		// Shared buffers for meshes drawn by ShaderTags::MultiDraw shaders, see MeshPool.
+		virtual Handle CreateMeshPool(
+			Topology::Enum topology,
+			BufferUsage::Enum usage,
+			const MeshLayout& layout,
+			SizeType vertex_capacity,
+			SizeType index_capacity
+		) = 0;
+		// Mesh sub-allocated from the pool, used like any other mesh.
+		Handle CreateMesh(Handle mesh_pool_handle, SizeType vertex_capacity, SizeType index_capacity);
+		// after the meshes allocated from it
+		virtual void DestroyMeshPool(Handle mesh_pool_handle) = 0;
+
 	public: // Material
 		virtual Handle CreateMaterial(
 			Handle shader_handle,
@@ -224,9 +255,31 @@ namespace Vortex::Graphics {
 		virtual void DestroyDrawSurface(Handle draw_surface_handle) = 0;
 
 	public:
-		virtual void NextFrame() = 0;
-
-		virtual void OnEvent(const Event& event) = 0;
+		//	Ends the frame. Serially the submitted commands are executed before NextFrame returns.
+		//	Pipelined, they are handed to the render thread and the next frame is recorded while they execute,
+		//	NextFrame only blocks when FramesInFlight frames are still waiting for the render thread.
+		void NextFrame();
+
+		//	0 executes frames on the calling thread (default), otherwise up to frames_in_flight recorded frames are
+		//	executed on a dedicated render thread. Each frame keeps its command lists and a copy of the views, draw
+		//	surfaces and materials it draws with, those can be changed at any time. Other resources (create, update,
+		//	destroy, compute shader data) are changed after WaitIdle while pipelined, debug builds assert this in
+		//	every resource call, and bind callbacks run on the render thread.
+		void SetFramesInFlight(SizeType frames_in_flight);
+		inline SizeType GetFramesInFlight() const { return m_FramesInFlight; }
+		inline bool IsPipelined() const { return m_FramesInFlight > 0; }
+
+		//	Blocks until every submitted frame is executed and makes the backend usable from the calling thread.
+		//	Returns immediately when serial. Pipelined, the next NextFrame hands the context back to the render
+		//	thread, so a WaitIdle in every frame runs recording and execution back to back again.
+		void WaitIdle();
+
+		//	Receives the WindowResize events of event_bus (e.g. Application::GetEventBus) and resizes the default
+		//	view of the window. Subscribed until Unsubscribe or destruction, the bus must outlive the subscription.
+		void Subscribe(EventBus& event_bus);
+		void Unsubscribe();
+	protected:
+		void OnWindowResize(const Event& event);
 
 	protected:
 		using SortingKeyType = UInt64;
@@ -298,6 +351,17 @@ namespace Vortex::Graphics {
 			}
 		}
 
+		// the key without its depth, equal for draws that only differ in transform and depth
+		constexpr static SortingKeyType ClearDrawKeyDepth(SortingKeyType sorting_key) {
+			VORTEX_ASSERT(static_cast<ViewLayer::Enum>(OpaquePacker::Unpack<4>(sorting_key)) != ViewLayer::PostProcess)
+
+			if (static_cast<Blending::Enum>(OpaquePacker::Unpack<2>(sorting_key)) == Blending::Opaque) {
+				return sorting_key & ~(OpaquePacker::GetMaxValue<0>() << OpaquePacker::GetBitStart_r<0>());
+			} else {
+				return sorting_key & ~(TranslucentPacker::GetMaxValue<1>() << TranslucentPacker::GetBitStart_r<1>());
+			}
+		}
+
 		constexpr static SortingKeyType GeneratePostProcessKey(Handle postprocess_handle) {
 			SortingKeyType sorting_key{0};
 
@@ -359,15 +423,15 @@ namespace Vortex::Graphics {
 			Math::Vector3Int GroupCount;
 		};
 
-	public:
-		inline void SubmitDraw(
+	protected:
+		inline DrawCommand CreateDrawCommand(
 			Handle view_or_window_handle,
 			ViewLayer::Enum view_layer,
 			Handle draw_surface_handle,
 			Handle material_handle,
 			const Math::Matrix4& transform,
 			Handle mesh_handle
-		) {
+		) const {
 			VORTEX_ASSERT(d_MaterialChecks(material_handle))
 			VORTEX_ASSERT(d_DrawSurfaceChecks(draw_surface_handle))
 			VORTEX_ASSERT(d_MeshChecks(mesh_handle))
@@ -392,7 +456,70 @@ namespace Vortex::Graphics {
 			command.d_MaterialHandle = material_handle;
 			command.d_Depth = 0;
 #endif
-			m_DrawCommands.push_back(command);
+			return command;
+		}
+
+	public:
+		//	Draw submission for one thread, e.g. a culling job on a ThreadPool worker.
+		//	Each context appends to its own bucket without locks, the buckets keep their capacity between frames.
+		//	NextFrame merges the buckets of all contexts before the frame is executed, so submitting jobs must
+		//	finish before NextFrame and resources must not change while they run.
+		class SubmitContext {
+		public:
+			explicit SubmitContext(const Renderer& renderer): m_Renderer{renderer} {}
+
+			SubmitContext(const SubmitContext&) = delete;
+			SubmitContext(SubmitContext&&) = delete;
+
+		public:
+			inline void SubmitDraw(
+				Handle view_or_window_handle,
+				ViewLayer::Enum view_layer,
+				Handle draw_surface_handle,
+				Handle material_handle,
+				const Math::Matrix4& transform,
+				Handle mesh_handle
+			) {
+				m_DrawCommands.push_back(m_Renderer.CreateDrawCommand(
+					view_or_window_handle,
+					view_layer,
+					draw_surface_handle,
+					material_handle,
+					transform,
+					mesh_handle
+				));
+			}
+
+			inline SizeType GetDrawCount() const { return m_DrawCommands.size(); }
+
+		private:
+			friend class Renderer;
+
+			const Renderer& m_Renderer;
+			std::thread::id m_ThreadID;
+			std::vector<DrawCommand> m_DrawCommands;
+		};
+
+		// The calling thread's context, created on its first call and found without locking afterwards.
+		SubmitContext& GetSubmitContext();
+
+	public:
+		inline void SubmitDraw(
+			Handle view_or_window_handle,
+			ViewLayer::Enum view_layer,
+			Handle draw_surface_handle,
+			Handle material_handle,
+			const Math::Matrix4& transform,
+			Handle mesh_handle
+		) {
+			m_DrawCommands.push_back(CreateDrawCommand(
+				view_or_window_handle,
+				view_layer,
+				draw_surface_handle,
+				material_handle,
+				transform,
+				mesh_handle
+			));
 		}
 
 		inline void SubmitCompute(Handle compute_shader_handle, const Math::Vector3Int& num_of_groups) {
@@ -404,16 +531,247 @@ namespace Vortex::Graphics {
 			m_ComputeCommands.push_back(command);
 		}
 
+	public:
+		// Large sorts are split over the pool's workers, nullptr (default) sorts on the executing thread.
+		inline void SetSortThreadPool(ThreadPool* thread_pool) { m_SortThreadPool = thread_pool; }
+
+		// below this many commands the sort stays on one thread even with a pool
+		constexpr static SizeType ParallelSortThreshold = 32768;
+
+	protected:
+		// Writes view depths into the keys, then orders commands by draw handle and key.
+		// Backend independent, so every renderer processes commands in the same order.
+		// LSD radix sort over (draw handle, key) with the command index, commands are gathered once at the end.
+		// Stable, commands with equal keys keep their submission order.
+		void SortDrawCommands(std::vector<DrawCommand>& draw_commands);
+		inline void SortDrawCommands() { SortDrawCommands(m_DrawCommands); }
+
+		void WriteDrawDepths(DrawCommand* draw_commands, SizeType count) const;
+
+		//	Instancing: after sorting, consecutive commands with the same draw handle, key without depth and mesh
+		//	whose material shader is tagged ShaderTags::Instanced are drawn as one instanced draw.
+		//	Their transforms are gathered in draw order, each run reads its slice of that list.
+		bool IsInstancedMaterial(Handle material_handle) const;
+		// commands from `first` that form one instanced draw, at least 1
+		static SizeType GetInstanceRunLength(const std::vector<DrawCommand>& draw_commands, SizeType first);
+		// transforms of every instanced run, in the order ProcessDrawCommands draws them
+		void GatherInstanceTransforms(const std::vector<DrawCommand>& draw_commands, std::vector<Math::Matrix4>& transforms) const;
+
+		//	Multi draw: after sorting, consecutive commands with the same draw handle, view layer, draw surface,
+		//	blending and mesh pool whose material shader is tagged ShaderTags::MultiDraw become one batch, drawn by
+		//	one indirect multi draw. Materials change inside a batch only when neither has an OnBind callback,
+		//	shaders tell them apart by MaterialIndex into the frame's material table.
+		//	Equal meshes next to each other share one indirect command as instances.
+
+		// layout of DrawElementsIndirectCommand
+		struct DrawIndirectCommand {
+			UInt32 IndexCount;
+			UInt32 InstanceCount;
+			UInt32 FirstIndex;
+			Int32 BaseVertex;
+			UInt32 BaseInstance; // first DrawData entry, the draw index of instance i is BaseInstance + i
+		};
+		// std430 layout of the DrawData block entries
+		struct MultiDrawData {
+			Math::Matrix4 Transform;
+			UInt32 MaterialIndex; // into MultiDrawList::Materials, dense per frame
+			UInt32 Padding[3];
+		};
+		using MaterialData = decltype(Material::Data);
+		VORTEX_STATIC_ASSERT_MSG(sizeof(DrawIndirectCommand) == 20, "DrawIndirectCommand must match the API layout.")
+		VORTEX_STATIC_ASSERT_MSG(sizeof(MultiDrawData) == 80, "MultiDrawData must match the std430 layout.")
+		VORTEX_STATIC_ASSERT_MSG(sizeof(MaterialData) == 256, "MaterialData stride is documented in ShaderConstants.")
+		struct MultiDrawBatch {
+			SizeType FirstDraw;
+			SizeType DrawCount;
+			SizeType FirstIndirectCommand;
+			SizeType IndirectCommandCount;
+			Handle MeshPoolHandle;
+		};
+		struct MultiDrawList {
+			std::vector<DrawIndirectCommand> IndirectCommands;
+			std::vector<MultiDrawData> DrawData;
+			std::vector<MaterialData> Materials; // Material::Data of every multi draw material, first use order
+			std::vector<MultiDrawBatch> Batches; // in draw order
+
+			std::unordered_map<Handle, UInt32> MaterialIndices; // scratch, material handle to Materials index
+		};
+
+		bool IsMultiDrawMaterial(Handle material_handle) const;
+		void BuildMultiDraws(const std::vector<DrawCommand>& draw_commands, MultiDrawList& multi_draws) const;
+
+		//	Shader uniforms: Shader::Uniforms is open addressed by name hash with linear probing, a power of two
+		//	in size and at most half full. Engine uniforms are also copied into Shader::ConstantUniforms when
+		//	their type matches ShaderConstants::Type, so per-draw uploads index an array instead of hashing.
+		static void BuildShaderUniforms(Shader& shader, const std::vector<ShaderUniform>& uniforms);
+		// nullptr when the shader has no uniform of that name
+		static const ShaderUniform* FindShaderUniform(const Shader& shader, HashedString name);
+
+		// appends the submit context buckets to m_DrawCommands, called by NextFrame
+		void MergeSubmitContexts();
+
+		//	Frame walk shared by the backends, over the sorted commands after GatherInstanceTransforms and BuildMultiDraws.
+		//	View, draw surface and material changes are handed to the hooks below only when they change, followed by
+		//	each draw, instanced run and multi draw batch.
+		struct DrawCommandStats {
+			SizeType DrawCalls; // an instanced run or multi draw batch is one draw call
+			SizeType InstancedDrawCalls;
+			SizeType MultiDrawCalls;
+			SizeType IndirectCommands;
+			SizeType ViewChanges;
+			SizeType DrawSurfaceChanges;
+			SizeType MaterialChanges;
+		};
+		DrawCommandStats ProcessDrawCommands(const std::vector<DrawCommand>& draw_commands, const MultiDrawList& multi_draws, SizeType instance_count);
+
+		// draw_handle is the window or view the commands were submitted to, view the one drawn into
+		virtual void OnBindView(Handle draw_handle, const View& view) = 0;
+		virtual void OnBindDrawSurface(const DrawSurface& draw_surface, const View& view) = 0;
+		virtual void OnBindMaterial(const Material& material, const Math::Matrix4& view_matrix, const Math::Matrix4& projection_matrix) = 0;
+		virtual void OnDraw(const DrawCommand& draw_command, Handle shader_handle) = 0;
+		virtual void OnDrawInstanced(Handle mesh_handle, SizeType first_instance, SizeType instance_count) = 0;
+		virtual void OnDrawMultiDraw(const MultiDrawBatch& batch) = 0;
+
+		//	Pipeline state of a view, draw surface and material for the hooks, so every backend sets and filters the
+		//	same state. StateCache is RenderStateCache or a backend cache with the same setters.
+		template<typename StateCache>
+		static void SetViewState(StateCache& state_cache, const View& view, UInt32 framebuffer_name) {
+			state_cache.BindFramebuffer(framebuffer_name);
+			state_cache.SetScissorTest(view.FramebufferHandle == Map::NullHandle);
+			state_cache.SetViewport(view.Viewport.x, view.Viewport.y, view.Viewport.width, view.Viewport.height);
+
+			if (view.DepthTest == DepthTesting::Disabled) {
+				state_cache.SetDepthTest(false);
+			} else {
+				state_cache.SetDepthTest(true);
+				state_cache.SetDepthMask(true);
+				state_cache.SetDepthFunc(view.DepthTest);
+			}
+		}
+		// masks for clearing the draw surface
+		template<typename StateCache>
+		static void SetDrawSurfaceState(StateCache& state_cache, const DrawSurface& draw_surface, const View& view) {
+			state_cache.SetColorMask(true);
+			state_cache.SetScissor(
+				draw_surface.Area.x,
+				//translate scissor coordinates to top left origin
+				view.Viewport.height - draw_surface.Area.height - draw_surface.Area.y,
+				draw_surface.Area.width,
+				draw_surface.Area.height
+			);
+			state_cache.SetDepthMask(true);
+			state_cache.SetStencilMask(1);
+		}
+		template<typename StateCache>
+		static void SetMaterialState(StateCache& state_cache, const Material& material) {
+			if (material.Blending == Blending::Opaque) {
+				state_cache.SetBlend(false);
+				state_cache.SetDepthMask(true);
+			} else {
+				state_cache.SetBlend(true);
+				state_cache.SetDepthMask(false);
+				state_cache.SetBlendMode(material.Blending);
+			}
+		}
+
+	protected:
+		//	State of the executing frame, read by the frame walk and its helpers instead of m_DataMap: the frame's
+		//	copy while pipelined, m_DataMap when serial.
+		const View& GetFrameView(Handle view_handle) const;
+		const DrawSurface& GetFrameDrawSurface(Handle draw_surface_handle) const;
+		const Material& GetFrameMaterial(Handle material_handle) const;
+
+	protected:
+		// calling thread, start of NextFrame (window events)
+		virtual void BeginFrame() {}
+		// executes one frame's commands, on the render thread when pipelined, the lists are cleared afterwards
+		virtual void ExecuteFrame(std::vector<DrawCommand>& draw_commands, std::vector<ComputeCommand>& compute_commands) = 0;
+		// binds / unbinds the graphics context to the calling thread when execution moves between threads
+		virtual void AcquireContext() {}
+		virtual void ReleaseContext() {}
+
+	private:
+		// copies of the state a pipelined frame reads, values in the order of their handles
+		struct FrameState {
+			std::vector<Handle> ViewHandles;
+			std::vector<View> Views;
+			std::vector<Handle> DrawSurfaceHandles;
+			std::vector<DrawSurface> DrawSurfaces;
+			std::vector<Handle> MaterialHandles;
+			std::vector<Material> Materials;
+			std::vector<UInt16> Indices; // by handle value, position of a captured handle in its list
+		};
+		struct FrameCommands {
+			std::vector<DrawCommand> DrawCommands;
+			std::vector<ComputeCommand> ComputeCommands;
+			FrameState State;
+		};
+		// views (a window's default view), draw surfaces and materials of the commands, called by NextFrame
+		void CaptureFrameState(const std::vector<DrawCommand>& draw_commands, FrameState& state);
+		template<typename T>
+		static const T& FindFrameState(const FrameState& state, const std::vector<Handle>& handles, const std::vector<T>& values, Handle handle);
+
+		// 80 bit sort key (draw handle above the 64 bit key) and the command it came from, 16 bytes
+		struct SortEntry {
+			SortingKeyType Key;
+			UInt32 Index;
+			Handle DrawHandle;
+		};
+		constexpr static SizeType SortRadixBits = 8;
+		constexpr static SizeType SortRadixSize = 1 << SortRadixBits;
+		constexpr static SizeType SortPassCount = (sizeof(SortingKeyType) + sizeof(Handle)) * CHAR_BIT / SortRadixBits;
+
+		template<typename Fn>
+		void ForEachSortChunk(SizeType count, SizeType chunk_count, Fn&& fn);
+
+		void RenderThreadLoop();
+
 	protected:
 		std::vector<DrawCommand> m_DrawCommands;
 		std::vector<ComputeCommand> m_ComputeCommands;
 		Map m_DataMap;
 
+	private:
+		// submit contexts of every thread that submitted, merged in creation order
+		std::vector<std::unique_ptr<SubmitContext>> m_SubmitContexts;
+		std::mutex m_SubmitContextMutex;
+		SizeType m_InstanceID{s_NextInstanceID++};
+		inline static std::atomic<SizeType> s_NextInstanceID{1};
+
+		// sort scratch, kept between frames so sorting does not allocate
+		std::vector<SortEntry> m_SortEntries;
+		std::vector<SortEntry> m_SortScratch;
+		std::vector<UInt32> m_SortHistograms; // SortRadixSize per chunk
+		std::vector<DrawCommand> m_SortedDrawCommands;
+		ThreadPool* m_SortThreadPool{nullptr};
+
+		// recorded frames waiting for the render thread, frame n uses m_InFlightFrames[n % m_FramesInFlight]
+		std::vector<FrameCommands> m_InFlightFrames;
+		FrameState m_CapturedFrameState; // calling thread, swapped into the frame's slot
+		std::vector<bool> m_CapturedHandles; // by handle value, set only during CaptureFrameState
+		const FrameState* m_ExecutingFrameState{nullptr}; // render thread, nullptr when serial
+		SizeType m_FramesInFlight{0};
+		SizeType m_SubmittedFrameCount{0};
+		SizeType m_ExecutedFrameCount{0};
+		bool m_StopRenderThread{false};
+		bool m_ContextOnRenderThread{false};
+
+		std::thread m_RenderThread;
+		std::mutex m_FrameMutex;
+		std::condition_variable m_FrameSubmitted;
+		std::condition_variable m_FrameExecuted;
+
+		EventBus* m_EventBus{nullptr};
+		EventBus::Subscription m_WindowResizeSubscription{};
+
 #ifdef VORTEX_DEBUG
 	public:
-		inline bool d_DrawCommandChecks() const {
+		// resources are only changed while the calling thread holds the context, see SetFramesInFlight
+		inline bool d_ResourceThreadChecks() const { return !m_ContextOnRenderThread; }
+		inline bool d_DrawCommandChecks() const { return d_DrawCommandChecks(m_DrawCommands); }
+		inline bool d_DrawCommandChecks(const std::vector<DrawCommand>& draw_commands) const {
 			bool out{true};
-			for (const auto& cmd : m_DrawCommands) {
+			for (const auto& cmd : draw_commands) {
 				Blending::Enum blending;
 				Handle material_handle;
 				Handle draw_surface_handle;
@@ -517,6 +875,21 @@ namespace Vortex::Graphics {
 			VORTEX_ASSERT(out &= mesh.Topology < Topology::Count)
 			return out;
 		}
+		inline bool d_MeshPoolChecks(Handle mesh_pool_handle) const {
+			VORTEX_ASSERT(m_DataMap.Is<MeshPool>(mesh_pool_handle))
+			bool out{true};
+			const auto& mesh_pool = m_DataMap.Get<MeshPool>(mesh_pool_handle);
+			VORTEX_ASSERT(out &= d_BufferChecks(mesh_pool.IndexBufferHandle))
+
+			for (const auto& buffer_handle : mesh_pool.BufferHandles) {
+				VORTEX_ASSERT(d_BufferChecks(buffer_handle))
+			}
+
+			VORTEX_ASSERT(out &= mesh_pool.VertexCount <= mesh_pool.VertexCapacity)
+			VORTEX_ASSERT(out &= mesh_pool.IndexCount <= mesh_pool.IndexCapacity)
+			VORTEX_ASSERT(out &= mesh_pool.Topology < Topology::Count)
+			return out;
+		}
 		inline bool d_MaterialChecks(Handle material_handle) const {
 			VORTEX_ASSERT(m_DataMap.Is<Material>(material_handle))
 			bool out{true};
@@ -26,14 +26,14 @@ namespace Vortex {
 			bool out{true};
 			out &= serializer.Set<T>("x", obj.x);
 			out &= serializer.Set<T>("y", obj.y);
-			out &= serializer.Set<T>("z", obj.y);
+			out &= serializer.Set<T>("z", obj.z);
 			return out;
 		}
 		inline static bool Deserialize(Serializer& serializer, Math::BasicVector<T, 3>& obj) {
 			bool out{true};
 			out &= serializer.Get<T>("x", obj.x);
 			out &= serializer.Get<T>("y", obj.y);
-			out &= serializer.Get<T>("z", obj.y);
+			out &= serializer.Get<T>("z", obj.z);
 			return out;
 		}
 	};
@@ -43,16 +43,16 @@ namespace Vortex {
 			bool out{true};
 			out &= serializer.Set<T>("x", obj.x);
 			out &= serializer.Set<T>("y", obj.y);
-			out &= serializer.Set<T>("z", obj.y);
-			out &= serializer.Set<T>("w", obj.y);
+			out &= serializer.Set<T>("z", obj.z);
+			out &= serializer.Set<T>("w", obj.w);
 			return out;
 		}
 		inline static bool Deserialize(Serializer& serializer, Math::BasicVector<T, 4>& obj) {
 			bool out{true};
 			out &= serializer.Get<T>("x", obj.x);
 			out &= serializer.Get<T>("y", obj.y);
-			out &= serializer.Get<T>("z", obj.y);
-			out &= serializer.Get<T>("w", obj.y);
+			out &= serializer.Get<T>("z", obj.z);
+			out &= serializer.Get<T>("w", obj.w);
 			return out;
 		}
 	};
@@ -138,7 +138,7 @@ namespace Vortex {
 			out &= serializer.Set<T>("m33", obj.m33);
 			return out;
 		}
-		inline static bool Deserialize(Serializer& serializer, Math::BasicMatrix<T, 3, 3>& obj) {
+		inline static bool Deserialize(Serializer& serializer, Math::BasicMatrix<T, 4, 4>& obj) {
 			bool out{true};
 			out &= serializer.Get<T>("m00", obj.m00);
 			out &= serializer.Get<T>("m10", obj.m10);
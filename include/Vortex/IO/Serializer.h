@@ -1,6 +1,10 @@
 #pragma once
 #include <pugixml.hpp>
 #include <filesystem>
+#include <istream>
+#include <ostream>
+
+#include "Vortex/IO/Serializable.h"
 
 namespace Vortex {
 	class Serializer {
@@ -12,8 +16,20 @@ namespace Vortex {
 			doc.reset();
 			m_CurrentNode = doc.append_child("Vortex");
 		}
-		inline void Load(const std::filesystem::path& path) { doc.load_file(path.c_str()); }
-		inline void Save(const std::filesystem::path& path) const { doc.save_file(path.c_str()); }
+		//returns true on success
+		inline bool Load(const std::filesystem::path& path) {
+			auto result = doc.load_file(path.c_str());
+			m_CurrentNode = doc.child("Vortex");
+			return result && m_CurrentNode;
+		}
+		//returns true on success
+		inline bool Load(std::istream& istream) {
+			auto result = doc.load(istream);
+			m_CurrentNode = doc.child("Vortex");
+			return result && m_CurrentNode;
+		}
+		inline bool Save(const std::filesystem::path& path) const { return doc.save_file(path.c_str()); }
+		inline void Save(std::ostream& ostream) const { doc.save(ostream); }
 
 	public:
 		//returns true on success
@@ -52,19 +68,20 @@ namespace Vortex {
 		}
 		template<typename T>
 		SizeType DeserializeArray(const char* tag, T* obj, SizeType count) {
-			m_CurrentNode = m_CurrentNode.child(tag);
-			SizeType available_count = m_CurrentNode.attribute("count").as_uint();
+			auto array_node = m_CurrentNode.child(tag);
+			SizeType available_count = array_node.attribute("count").as_uint();
 
 			if (available_count > count) {
 				available_count = count;
 			}
 
-			m_CurrentNode = m_CurrentNode.child("element");
+			// the last next_sibling() is a null node, so keep the array node to step back out of it
+			m_CurrentNode = array_node.child("element");
 			for (SizeType i = 0; i < available_count; ++i) {
 				Serializable<T>::Deserialize(*this, obj[i]);
 				m_CurrentNode = m_CurrentNode.next_sibling();
 			}
-			m_CurrentNode = m_CurrentNode.parent();
+			m_CurrentNode = array_node.parent();
 
 			return available_count;
 		}
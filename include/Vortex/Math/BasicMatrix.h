@@ -286,7 +286,7 @@ namespace Vortex::Math {
 			SizeType Columns_ = Columns,
 			typename = EIF<(Rows_ >= 3 && Columns_ >= 4 && std::is_floating_point_v<T_>)>
 		>
-		constexpr void Extract3DTranslation(BasicVector<T_, 3>& vector) {
+		constexpr void Extract3DTranslation(BasicVector<T_, 3>& vector) const {
 			// |00  01  02 [03] . |
 			// |10  11  12 [13] . |
 			// |20  21  22 [23] . |
@@ -1,5 +1,6 @@
 #include "Vortex/Audio/OpenALBackend.h"
 #include "Vortex/Common/Logger.h"
+#include "Vortex/Debug/Profiler.h"
 
 #ifdef VORTEX_DEBUG
   #define VORTEX_WRAP_AL_CALLS
@@ -226,8 +227,18 @@ namespace Vortex::Audio {
 	}
 
 	void OpenALBackend::Update() {
-
-
+#ifdef VORTEX_DEBUG
+		SizeType playing_voice_count{0};
+		for (const auto& source : m_SourceDatas) {
+			ALint state;
+			alGetSourcei(static_cast<ALuint>(source.first.id), AL_SOURCE_STATE, &state);
+			if (state == AL_PLAYING) {
+				++playing_voice_count;
+			}
+		}
+		VORTEX_DEBUG_PROFILER_COUNTER_SET("Audio Voices", playing_voice_count)
+		VORTEX_DEBUG_PROFILER_COUNTER_SET("Audio Sources", m_SourceDatas.size())
+#endif
 	}
 
 	void OpenALBackend::Mute() {
@@ -1,4 +1,4 @@
-#include <fstream>
+#include <cstring>
 #include <utility>
 
 #include "Vortex/Common/Console.h"
@@ -6,69 +6,236 @@
 namespace Vortex {
 	Console* Console::s_Instance{nullptr};
 
-	Console::Console(std::filesystem::path file_path, SizeType max_value)
-		: m_LogFilePath{std::move(file_path)},
+	Console::Console(
+		std::filesystem::path file_path,
+		SizeType max_value,
+		SizeType record_capacity,
+		OverflowPolicy::Enum overflow_policy
+	)
+		: m_DebugOutput{false},
+		  m_CategoryLevels{},
+		  m_OverflowPolicy{overflow_policy},
+
+		  m_LogFilePath{std::move(file_path)},
 		  m_LogFileBufferEntryCount{max_value},
-		  m_LogFileBuffer{},
 
 		  m_Entries(),
+		  m_Mutex(),
 
+		  m_Records{record_capacity},
 		  m_TotalEntryCount{0},
-		  m_Mutex(),
+		  m_DroppedEntryCount{0},
+		  m_ReportedDroppedEntryCount{0},
+
+		  m_DrainMutex(),
+		  m_LogFile{},
+
+		  m_WriterMutex(),
+		  m_WriterSignal(),
+		  m_WriterWaiting{false},
+		  m_Running{true},
+		  m_WriterThread{},
 
-		  m_DebugOutput{false} {
+		  m_FlightRecorder{nullptr} {
 
 #if VORTEX_DEBUG
 		m_DebugOutput = true;
 #endif
+		for (auto& level : m_CategoryLevels) {
+			level.store(EntryType::Debug, std::memory_order_relaxed);
+		}
+		// per uniform/attribute lines on every shader (re)load, enable when debugging shaders
+		m_CategoryLevels[LogCategory::Shader].store(EntryType::Info, std::memory_order_relaxed);
 
-		std::ofstream file{m_LogFilePath};
-		if (file.is_open()) {
-			file << "\nVortex Engine Console Log\n\n";
+		m_LogFile.open(m_LogFilePath);
+		if (m_LogFile.is_open()) {
+			m_LogFile << "\nVortex Engine Console Log\n";
 		}
 		printf("Vortex Engine Console Log");
+
+		m_WriterThread = std::thread{[this]() { WriterLoop_(); }};
 	}
 	Console::~Console() {
+		{
+			std::unique_lock lock{m_WriterMutex};
+			m_Running = false;
+		}
+		m_WriterSignal.notify_one();
+		m_WriterThread.join();
+
 		Flush();
+		if (m_LogFile.is_open()) {
+			m_LogFile << "\n";
+		}
+		delete m_FlightRecorder.load(std::memory_order_relaxed);
+	}
+
+	void Console::SetLogFilePath(const std::filesystem::path& file_path) {
+		std::unique_lock drain_lock{m_DrainMutex};
+		m_LogFile.flush();
+		m_LogFile.close();
+
+		m_LogFilePath = file_path;
+		m_LogFile.open(m_LogFilePath, std::ios_base::app);
 	}
 
 	void Console::Flush() {
-		std::shared_lock read_lock{m_Mutex};
-		if (m_Entries.empty()) {
-			return;
+		std::unique_lock drain_lock{m_DrainMutex};
+		FlushLocked_();
+	}
+
+	bool Console::TryFlush() {
+		std::unique_lock drain_lock{m_DrainMutex, std::try_to_lock};
+		if (drain_lock.owns_lock()) {
+			FlushLocked_();
+			return true;
 		}
-		read_lock.unlock();
 
-		std::ofstream file{m_LogFilePath, std::ios_base::app};
-		if (file.is_open()) {
-			std::unique_lock write_lock{m_Mutex};
-			std::swap(m_LogFileBuffer, m_Entries);
-			write_lock.unlock();
+		// queued records stay in the ring, with a flight recorder they are already in the mapped file
+		fflush(stdout);
+		if (auto* flight_recorder = m_FlightRecorder.load(std::memory_order_acquire)) {
+			flight_recorder->Sync();
+		}
+		return false;
+	}
 
-			for (const auto& entry : m_LogFileBuffer) {
-				file << "[" << EntryType::ToString[entry.Type] << "] " << entry.Log << "\n";
-			}
-			m_LogFileBuffer.clear();
+	void Console::FlushLocked_() {
+		while (DrainLocked_(m_Records.GetCapacity()) > 0) {}
+
+		m_LogFile.flush();
+		fflush(stdout);
+
+		if (auto* flight_recorder = m_FlightRecorder.load(std::memory_order_acquire)) {
+			flight_recorder->Sync();
 		}
 	}
 
-	void Console::Write_(EntryType::Enum log_type, const char* log) {
-		printf("\n[%-7s] %s", EntryType::ToString[log_type], log);
+	bool Console::EnableFlightRecorder(const std::filesystem::path& path, SizeType capacity) {
+		VORTEX_ASSERT_MSG(!IsFlightRecorderEnabled(), "Flight recorder is already enabled")
+		if (IsFlightRecorderEnabled()) {
+			return false;
+		}
 
-		Console::Entry entry{log, log_type};
+		auto* flight_recorder = new FlightRecorder(path, capacity);
+		if (!flight_recorder->IsOpen()) {
+			delete flight_recorder;
+			return false;
+		}
+		m_FlightRecorder.store(flight_recorder, std::memory_order_release);
+		return true;
+	}
 
-		std::unique_lock lock{m_Mutex};
-		m_Entries.push_back(entry);
-		++m_TotalEntryCount;
-		auto size = m_Entries.size();
-		lock.unlock();
+	void Console::RecordFlight_(FlightRecorder& flight_recorder, const Record& record) {
+		if (record.Deferred) {
+			flight_recorder.Write(record.Type, record.Category, record.Append, record.FormatID, record.Text, record.DataSize);
+		} else {
+			flight_recorder.Write(record.Type, record.Category, record.Append, FlightRecorder::TextFormatID, record.Text, std::strlen(record.Text));
+		}
+	}
 
-		if (size > m_LogFileBufferEntryCount) { Flush(); }
+	void Console::Write_(EntryType::Enum log_type, const char* log) {
+		Push_([&](Record& record) {
+			record.Type = log_type;
+			record.Category = LogCategory::General;
+			record.Append = false;
+			record.Deferred = false;
+			std::strncpy(record.Text, log, RecordTextSize - 1);
+			record.Text[RecordTextSize - 1] = '\0';
+		});
 	}
 	void Console::Append_(const char* log) {
-		printf("%s", log);
-		std::unique_lock write_lock{m_Mutex};
-		m_Entries.back().Log.append(log);
+		Push_([&](Record& record) {
+			record.Type = EntryType::Info;
+			record.Category = LogCategory::General;
+			record.Append = true;
+			record.Deferred = false;
+			std::strncpy(record.Text, log, RecordTextSize - 1);
+			record.Text[RecordTextSize - 1] = '\0';
+		});
+	}
+
+	void Console::WakeWriter_() {
+		m_WriterSignal.notify_one();
+	}
+
+	void Console::WriterLoop_() {
+		// large enough to amortize the file write, small enough to keep GetEntries fresh
+		constexpr static SizeType batch_size = 256;
+
+		while (m_Running) {
+			if (Drain_(batch_size) > 0) {
+				continue;
+			}
+
+			// producers only notify while m_WriterWaiting is set, the timeout covers a notify
+			// racing with the flag being raised
+			std::unique_lock lock{m_WriterMutex};
+			m_WriterWaiting = true;
+			m_WriterSignal.wait_for(lock, std::chrono::milliseconds{10}, [this]() {
+				return !m_Running || !m_Records.IsEmpty();
+			});
+			m_WriterWaiting = false;
+		}
 	}
 
-}
\ No newline at end of file
+	SizeType Console::Drain_(SizeType max_count) {
+		std::unique_lock drain_lock{m_DrainMutex};
+		return DrainLocked_(max_count);
+	}
+
+	SizeType Console::DrainLocked_(SizeType max_count) {
+		auto dropped_count = m_DroppedEntryCount.load(std::memory_order_relaxed);
+		if (dropped_count != m_ReportedDroppedEntryCount) {
+			char text[128];
+			snprintf(text, sizeof(text), "[Console] %zu log entries dropped, log ring is full.", dropped_count - m_ReportedDroppedEntryCount);
+			WriteText_(EntryType::Warning, LogCategory::General, false, text);
+			m_ReportedDroppedEntryCount = dropped_count;
+		}
+
+		SizeType count{0};
+		while (count < max_count && m_Records.TryPop([this](const Record& record) { WriteRecord_(record); })) {
+			++count;
+		}
+
+		if (count > 0) {
+			m_LogFile.flush();
+			fflush(stdout);
+		}
+		return count;
+	}
+
+	void Console::WriteRecord_(const Record& record) {
+		if (!record.Deferred) {
+			WriteText_(record.Type, record.Category, record.Append, record.Text);
+			return;
+		}
+
+		char text[2 * RecordTextSize];
+		LogFormat::Format(text, sizeof(text), LogFormat::GetFormat(record.FormatID), record.Text, record.DataSize);
+		WriteText_(record.Type, record.Category, record.Append, text);
+	}
+
+	void Console::WriteText_(EntryType::Enum type, LogCategory::Enum category, bool append, const char* text) {
+		if (append) {
+			printf("%s", text);
+			m_LogFile << text;
+		} else if (category == LogCategory::General) {
+			printf("\n[%-7s] %s", EntryType::ToString[type], text);
+			m_LogFile << "\n[" << EntryType::ToString[type] << "] " << text;
+		} else {
+			printf("\n[%-7s] [%s] %s", EntryType::ToString[type], LogCategory::ToString[category], text);
+			m_LogFile << "\n[" << EntryType::ToString[type] << "] [" << LogCategory::ToString[category] << "] " << text;
+		}
+
+		std::unique_lock write_lock{m_Mutex};
+		if (append && !m_Entries.empty()) {
+			m_Entries.back().Log.append(text);
+			return;
+		}
+
+		m_Entries.push_back(Console::Entry{text, type, category});
+		if (m_Entries.size() > 2 * m_LogFileBufferEntryCount) {
+			m_Entries.erase(m_Entries.begin(), m_Entries.end() - m_LogFileBufferEntryCount);
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#include "Vortex/Common/CycleClock.h"
+
+namespace Vortex {
+	double CycleClock::s_NanosecondsPerTick{1.0};
+	UInt64 CycleClock::s_BaseTicks{0};
+
+	void CycleClock::Calibrate(std::chrono::milliseconds calibration_time) {
+#if defined(VORTEX_CYCLE_CLOCK_ARM64)
+		// generic timer reports its own frequency
+		UInt64 frequency;
+		asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+		s_NanosecondsPerTick = 1e9 / static_cast<double>(frequency);
+		s_BaseTicks = ReadCounter();
+#elif defined(VORTEX_CYCLE_CLOCK_X86)
+		// busy wait instead of sleeping, so frequency scaling does not kick in halfway through
+		auto begin_time = std::chrono::steady_clock::now();
+		auto begin_ticks = ReadCounterOrdered();
+
+		auto end_time = begin_time;
+		while (end_time - begin_time < calibration_time) {
+			end_time = std::chrono::steady_clock::now();
+		}
+		auto end_ticks = ReadCounterOrdered();
+
+		auto elapsed_ns = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(end_time - begin_time).count();
+		s_NanosecondsPerTick = elapsed_ns / static_cast<double>(end_ticks - begin_ticks);
+		s_BaseTicks = begin_ticks;
+#else
+		using SteadyPeriod = std::chrono::steady_clock::period;
+		s_NanosecondsPerTick = 1e9 * static_cast<double>(SteadyPeriod::num) / static_cast<double>(SteadyPeriod::den);
+		s_BaseTicks = ReadCounter();
+		(void) calibration_time;
+#endif
+	}
+
+	namespace {
+		const bool s_CycleClockCalibrated = (CycleClock::Calibrate(), true);
+	}
+}
@@ -0,0 +1,340 @@
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+  #error "Platform not implemented"
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#include "Vortex/Common/FlightRecorder.h"
+#include "Vortex/Common/LogFormat.h"
+
+namespace Vortex {
+	VORTEX_STATIC_ASSERT_MSG(sizeof(FlightRecorder::FileHeader) <= FlightRecorder::HeaderSize, "File header does not fit")
+	VORTEX_STATIC_ASSERT_MSG(sizeof(FlightRecorder::RecordHeader) % FlightRecorder::RecordAlignment == 0, "Record header must keep records aligned")
+	VORTEX_STATIC_ASSERT_MSG(std::atomic<UInt64>::is_always_lock_free, "Shared mapping needs lock-free 64 bit atomics")
+
+	namespace {
+		constexpr SizeType RecordHeaderSize = sizeof(FlightRecorder::RecordHeader);
+		constexpr SizeType PositionOffset = offsetof(FlightRecorder::RecordHeader, Position);
+
+		constexpr SizeType AlignUp(SizeType value, SizeType alignment) {
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	FlightRecorder::FlightRecorder(const std::filesystem::path& path, SizeType capacity)
+		: m_Header{nullptr},
+		  m_FormatTable{nullptr},
+		  m_Ring{nullptr},
+		  m_Capacity{AlignUp(capacity < 4096 ? 4096 : capacity, RecordAlignment)},
+		  m_StartTime{CycleClock::now()},
+
+		  m_Mapping{nullptr},
+		  m_MappingSize{0},
+		  m_File{-1},
+		  m_MappingObject{0},
+
+		  m_FormatMutex(),
+		  m_FormatWritten{} {
+
+		std::error_code error;
+		if (std::filesystem::exists(path, error)) {
+			auto previous_path = path;
+			previous_path.replace_extension(".prev" + path.extension().string());
+			std::filesystem::rename(path, previous_path, error);
+		}
+
+		if (!Map_(path, HeaderSize + FormatTableSize + m_Capacity)) {
+			return;
+		}
+
+		auto* base = static_cast<char*>(m_Mapping);
+		m_FormatTable = base + HeaderSize;
+		m_Ring = m_FormatTable + FormatTableSize;
+
+		// the mapping of a new file is zeroed, only the header needs to be written
+		m_Header = new(base) FileHeader{};
+		m_Header->Version = Version;
+		m_Header->HeaderSize = static_cast<UInt32>(HeaderSize);
+		m_Header->FormatTableSize = FormatTableSize;
+		m_Header->Capacity = m_Capacity;
+		m_Header->StartTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		m_Header->WritePosition.store(0, std::memory_order_relaxed);
+		m_Header->FormatTablePosition.store(0, std::memory_order_relaxed);
+
+		// written last, a file without magic is not decoded
+		std::atomic_thread_fence(std::memory_order_release);
+		m_Header->Magic = Magic;
+	}
+	FlightRecorder::~FlightRecorder() {
+		Unmap_();
+	}
+
+	void FlightRecorder::Write(UInt8 type, UInt8 category, bool append, UInt32 format_id, const char* data, SizeType data_size) {
+		if (!IsOpen()) { return; }
+
+		if (format_id != TextFormatID) {
+			if (format_id >= MaxFormatCount) {
+				// no table slot, formatted here and kept as a text record
+				char text[1024];
+				auto text_size = LogFormat::Format(text, sizeof(text), LogFormat::GetFormat(format_id), data, data_size);
+				Write(type, category, append, TextFormatID, text, text_size);
+				return;
+			}
+			if (!m_FormatWritten[format_id].load(std::memory_order_acquire)) {
+				WriteFormat_(format_id);
+			}
+		}
+
+		constexpr SizeType max_data_size = 0xFFFF - RecordHeaderSize - RecordAlignment;
+		if (data_size > max_data_size) { data_size = max_data_size; }
+
+		auto size = AlignUp(RecordHeaderSize + data_size, RecordAlignment);
+		auto position = m_Header->WritePosition.fetch_add(size, std::memory_order_relaxed);
+
+		RecordHeader header{};
+		header.Magic = RecordMagic;
+		header.Size = static_cast<UInt16>(size);
+		header.DataSize = static_cast<UInt16>(data_size);
+		header.FormatID = format_id;
+		header.Type = type;
+		header.Category = category;
+		header.Append = append ? 1 : 0;
+		header.Timestamp = static_cast<UInt64>(std::chrono::duration_cast<std::chrono::nanoseconds>(CycleClock::now() - m_StartTime).count());
+		header.Position = ~position; // never matches until committed below
+
+		CopyToRing_(position, &header, RecordHeaderSize);
+		CopyToRing_(position + RecordHeaderSize, data, data_size);
+
+		auto* commit = reinterpret_cast<std::atomic<UInt64>*>(m_Ring + (position + PositionOffset) % m_Capacity);
+		commit->store(position, std::memory_order_release);
+	}
+
+	void FlightRecorder::Sync() {
+		if (!IsOpen()) { return; }
+#ifdef _WIN32
+		FlushViewOfFile(m_Mapping, m_MappingSize);
+#else
+		msync(m_Mapping, m_MappingSize, MS_ASYNC);
+#endif
+	}
+
+	void FlightRecorder::WriteFormat_(UInt32 format_id) {
+		std::unique_lock lock{m_FormatMutex};
+		if (m_FormatWritten[format_id].load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		const char* format = LogFormat::GetFormat(format_id);
+		auto length = std::strlen(format);
+		if (length > 0xFFFF) { length = 0xFFFF; }
+
+		auto table_position = m_Header->FormatTablePosition.load(std::memory_order_relaxed);
+		auto entry_size = sizeof(UInt32) + sizeof(UInt16) + length;
+		if (table_position + entry_size <= FormatTableSize) {
+			auto id = static_cast<UInt32>(format_id);
+			auto length16 = static_cast<UInt16>(length);
+			char* entry = m_FormatTable + table_position;
+			std::memcpy(entry, &id, sizeof(id));
+			std::memcpy(entry + sizeof(id), &length16, sizeof(length16));
+			std::memcpy(entry + sizeof(id) + sizeof(length16), format, length);
+			m_Header->FormatTablePosition.store(table_position + entry_size, std::memory_order_release);
+		}
+		// a full table is not retried on every record, the decoder prints the raw id instead
+		m_FormatWritten[format_id].store(true, std::memory_order_release);
+	}
+
+	void FlightRecorder::CopyToRing_(UInt64 position, const void* data, SizeType size) {
+		auto offset = static_cast<SizeType>(position % m_Capacity);
+		auto first_size = size < m_Capacity - offset ? size : m_Capacity - offset;
+
+		std::memcpy(m_Ring + offset, data, first_size);
+		if (first_size < size) {
+			std::memcpy(m_Ring, static_cast<const char*>(data) + first_size, size - first_size);
+		}
+	}
+
+#ifdef _WIN32
+	bool FlightRecorder::Map_(const std::filesystem::path& path, SizeType size) {
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		// sizes the file and zero fills it
+		HANDLE mapping_object = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<UInt64>(size) >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+		if (mapping_object == nullptr) {
+			CloseHandle(file);
+			return false;
+		}
+
+		void* mapping = MapViewOfFile(mapping_object, FILE_MAP_ALL_ACCESS, 0, 0, size);
+		if (mapping == nullptr) {
+			CloseHandle(mapping_object);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_File = reinterpret_cast<std::intptr_t>(file);
+		m_MappingObject = reinterpret_cast<std::intptr_t>(mapping_object);
+		m_Mapping = mapping;
+		m_MappingSize = size;
+		return true;
+	}
+
+	void FlightRecorder::Unmap_() {
+		if (m_Mapping == nullptr) { return; }
+
+		FlushViewOfFile(m_Mapping, m_MappingSize);
+		UnmapViewOfFile(m_Mapping);
+		CloseHandle(reinterpret_cast<HANDLE>(m_MappingObject));
+		CloseHandle(reinterpret_cast<HANDLE>(m_File));
+
+		m_Mapping = nullptr;
+		m_Header = nullptr;
+	}
+#else
+	bool FlightRecorder::Map_(const std::filesystem::path& path, SizeType size) {
+		int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (file < 0) {
+			return false;
+		}
+
+		// sizes the file and zero fills it
+		if (ftruncate(file, static_cast<off_t>(size)) != 0) {
+			close(file);
+			return false;
+		}
+
+		void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+		if (mapping == MAP_FAILED) {
+			close(file);
+			return false;
+		}
+
+		m_File = file;
+		m_Mapping = mapping;
+		m_MappingSize = size;
+		return true;
+	}
+
+	void FlightRecorder::Unmap_() {
+		if (m_Mapping == nullptr) { return; }
+
+		msync(m_Mapping, m_MappingSize, MS_ASYNC);
+		munmap(m_Mapping, m_MappingSize);
+		close(static_cast<int>(m_File));
+
+		m_Mapping = nullptr;
+		m_Header = nullptr;
+	}
+#endif
+
+	bool FlightRecorder::Decode(const std::filesystem::path& path, const DecodeFn& decode_fn) {
+		std::ifstream file{path, std::ios::binary};
+		if (!file.is_open()) {
+			return false;
+		}
+		std::vector<char> content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+		// read the header field by field, the atomics in FileHeader are not copyable
+		auto read = [&content](SizeType offset, auto& value) {
+			if (offset + sizeof(value) > content.size()) { return false; }
+			std::memcpy(&value, content.data() + offset, sizeof(value));
+			return true;
+		};
+
+		UInt64 magic{0};
+		UInt32 version{0};
+		UInt32 header_size{0};
+		UInt64 format_table_size{0};
+		UInt64 capacity{0};
+		UInt64 write_position{0};
+		UInt64 format_table_position{0};
+		if (!read(offsetof(FileHeader, Magic), magic) || magic != Magic
+			|| !read(offsetof(FileHeader, Version), version) || version != Version
+			|| !read(offsetof(FileHeader, HeaderSize), header_size)
+			|| !read(offsetof(FileHeader, FormatTableSize), format_table_size)
+			|| !read(offsetof(FileHeader, Capacity), capacity)
+			|| !read(offsetof(FileHeader, WritePosition), write_position)
+			|| !read(offsetof(FileHeader, FormatTablePosition), format_table_position)) {
+			return false;
+		}
+		if (header_size + format_table_size + capacity > content.size() || capacity % RecordAlignment != 0 || format_table_position > format_table_size) {
+			return false;
+		}
+
+		const char* format_table = content.data() + header_size;
+		const char* ring = format_table + format_table_size;
+
+		std::unordered_map<UInt32, String> formats;
+		for (SizeType offset = 0; offset + sizeof(UInt32) + sizeof(UInt16) <= format_table_position;) {
+			UInt32 id;
+			UInt16 length;
+			std::memcpy(&id, format_table + offset, sizeof(id));
+			std::memcpy(&length, format_table + offset + sizeof(id), sizeof(length));
+			offset += sizeof(id) + sizeof(length);
+			if (offset + length > format_table_position) { break; }
+
+			formats.emplace(id, String{format_table + offset, length});
+			offset += length;
+		}
+
+		auto copy_from_ring = [&](UInt64 position, void* out, SizeType size) {
+			auto offset = static_cast<SizeType>(position % capacity);
+			auto first_size = size < capacity - offset ? size : capacity - offset;
+			std::memcpy(out, ring + offset, first_size);
+			if (first_size < size) {
+				std::memcpy(static_cast<char*>(out) + first_size, ring, size - first_size);
+			}
+		};
+
+		// older records were overwritten, the first one still intact is found by scanning for its commit marker
+		UInt64 position = write_position > capacity ? write_position - capacity : 0;
+		std::vector<char> data;
+		while (position + RecordHeaderSize <= write_position) {
+			RecordHeader header;
+			copy_from_ring(position, &header, RecordHeaderSize);
+
+			bool is_valid = header.Magic == RecordMagic && header.Position == position
+				&& header.Size >= RecordHeaderSize && header.Size % RecordAlignment == 0
+				&& header.DataSize <= header.Size - RecordHeaderSize
+				&& position + header.Size <= write_position;
+			if (!is_valid) {
+				position += RecordAlignment;
+				continue;
+			}
+
+			data.resize(header.DataSize);
+			copy_from_ring(position + RecordHeaderSize, data.data(), header.DataSize);
+
+			DecodedRecord record{};
+			record.Timestamp = header.Timestamp;
+			record.Type = header.Type;
+			record.Category = header.Category;
+			record.Append = header.Append != 0;
+			record.FormatID = header.FormatID;
+			if (header.FormatID != TextFormatID) {
+				auto it = formats.find(header.FormatID);
+				record.Format = it != formats.end() ? it->second.c_str() : nullptr;
+			}
+			record.Data = data.data();
+			record.DataSize = data.size();
+			decode_fn(record);
+
+			position += header.Size;
+		}
+		return true;
+	}
+}
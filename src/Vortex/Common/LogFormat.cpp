@@ -0,0 +1,154 @@
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "Vortex/Common/LogFormat.h"
+
+namespace Vortex::LogFormat {
+	namespace {
+		std::mutex s_FormatMutex;
+		std::vector<const char*> s_Formats;
+
+		struct Argument {
+			ArgumentType::Enum Type;
+			UInt8 Size;
+			const char* Payload;
+		};
+
+		bool ReadArgument(const char*& cursor, const char* end, Argument& argument) {
+			if (end - cursor < 2) { return false; }
+
+			argument.Type = static_cast<ArgumentType::Enum>(cursor[0]);
+			argument.Size = static_cast<UInt8>(cursor[1]);
+			argument.Payload = cursor + 2;
+
+			SizeType payload_size = argument.Type == ArgumentType::String ? argument.Size : 8;
+			if (argument.Type >= ArgumentType::Count || end - argument.Payload < static_cast<std::ptrdiff_t>(payload_size)) {
+				return false;
+			}
+			cursor = argument.Payload + payload_size;
+			return true;
+		}
+
+		// Formats one conversion. The length modifier of the original specification is replaced,
+		// encoded values are always 64 bit wide.
+		int FormatArgument(char* out, SizeType out_size, const char* specification, SizeType specification_length, char conversion, const Argument& argument) {
+			char spec[32];
+			SizeType length{0};
+			for (SizeType i = 0; i < specification_length && length < sizeof(spec) - 4; ++i) {
+				if (!IsLengthModifier(specification[i])) {
+					spec[length++] = specification[i];
+				}
+			}
+
+			switch (argument.Type) {
+				case ArgumentType::Int64:
+				case ArgumentType::UInt64: {
+					UInt64 value;
+					std::memcpy(&value, argument.Payload, 8);
+
+					// unsigned conversions of narrower signed values print like the original width
+					if (argument.Size < 8) {
+						bool is_signed_conversion = conversion == 'd' || conversion == 'i';
+						if (!is_signed_conversion || argument.Type == ArgumentType::UInt64) {
+							value &= (UInt64{1} << (argument.Size * 8)) - 1;
+						}
+					}
+
+					if (conversion == 'c') {
+						spec[length++] = 'c';
+						spec[length] = '\0';
+						return snprintf(out, out_size, spec, static_cast<int>(value));
+					}
+					spec[length++] = 'l';
+					spec[length++] = 'l';
+					spec[length++] = conversion;
+					spec[length] = '\0';
+					return snprintf(out, out_size, spec, static_cast<unsigned long long>(value));
+				}
+				case ArgumentType::Double: {
+					double value;
+					std::memcpy(&value, argument.Payload, 8);
+					spec[length++] = conversion;
+					spec[length] = '\0';
+					return snprintf(out, out_size, spec, value);
+				}
+				case ArgumentType::Pointer: {
+					UInt64 value;
+					std::memcpy(&value, argument.Payload, 8);
+					spec[length++] = 'p';
+					spec[length] = '\0';
+					return snprintf(out, out_size, spec, reinterpret_cast<void*>(static_cast<std::uintptr_t>(value)));
+				}
+				case ArgumentType::String: {
+					char text[256];
+					std::memcpy(text, argument.Payload, argument.Size);
+					text[argument.Size] = '\0';
+					spec[length++] = 's';
+					spec[length] = '\0';
+					return snprintf(out, out_size, spec, text);
+				}
+				default: return 0;
+			}
+		}
+	}
+
+	SizeType Format(char* out, SizeType out_size, const char* format, const char* data, SizeType data_size) {
+		VORTEX_ASSERT(out_size > 0)
+
+		const char* cursor = data;
+		const char* end = data + data_size;
+		SizeType written{0};
+
+		auto put = [&](char c) {
+			if (written + 1 < out_size) { out[written++] = c; }
+		};
+
+		for (SizeType i = 0; format[i] != '\0'; ++i) {
+			if (format[i] != '%') {
+				put(format[i]);
+				continue;
+			}
+			if (format[i + 1] == '%') {
+				put('%');
+				++i;
+				continue;
+			}
+
+			auto specification_begin = i;
+			++i;
+			while (IsFlagOrWidth(format[i])) { ++i; }
+			while (IsLengthModifier(format[i])) { ++i; }
+			if (format[i] == '\0') { break; }
+
+			Argument argument{};
+			if (!ReadArgument(cursor, end, argument)) {
+				for (auto c : {'<', '?', '>'}) { put(c); }
+				continue;
+			}
+
+			auto result = FormatArgument(out + written, out_size - written, format + specification_begin, i - specification_begin, format[i], argument);
+			if (result > 0) {
+				written += static_cast<SizeType>(result);
+				if (written >= out_size) { written = out_size - 1; }
+			}
+		}
+
+		out[written] = '\0';
+		return written;
+	}
+
+	UInt32 RegisterFormat(const char* format) {
+		std::unique_lock lock{s_FormatMutex};
+		s_Formats.push_back(format);
+		return static_cast<UInt32>(s_Formats.size() - 1);
+	}
+	const char* GetFormat(UInt32 format_id) {
+		std::unique_lock lock{s_FormatMutex};
+		return format_id < s_Formats.size() ? s_Formats[format_id] : "<unknown log format>";
+	}
+	SizeType GetFormatCount() {
+		std::unique_lock lock{s_FormatMutex};
+		return s_Formats.size();
+	}
+}
@@ -1,10 +1,12 @@
 #include "Vortex/Common/ThreadPool.h"
 #include "Vortex/Common/Console.h"
+#include "Vortex/Debug/Profiler.h"
 
 namespace Vortex {
 	ThreadPool::ThreadPool(SizeType thread_count)
-		: m_Threads{thread_count},
-		  m_Running{true} {
+		: m_Threads{},
+		  m_Running{true},
+		  m_ActiveJobCount{0} {
 
 		auto thread_job = [this]() {
 			ThreadPoolJob* thread_job;
@@ -16,24 +18,28 @@ namespace Vortex {
 
 				thread_job = m_JobQueue.front();
 				m_JobQueue.pop();
+				++m_ActiveJobCount; // under the lock, so Await never sees an empty queue with the job not counted yet
 				lock.unlock();
 
-				++m_ActiveJobCount;
 				try {
 					thread_job->Execute();
 				} catch (const std::exception& e) {
 					Console::WriteError("Exception raised when executing job.\n%s\n", e.what());
 				}
 				delete thread_job;
-				--m_ActiveJobCount;
+				VORTEX_DEBUG_PROFILER_COUNTER("ThreadPool Jobs", 1)
 
+				lock.lock();
+				--m_ActiveJobCount;
+				lock.unlock();
 				m_JobCompleteSignal.notify_all();
 			}
 
 		};
 
-		for (SizeType i = 0; i < m_Threads.capacity(); ++i) {
-			m_Threads.emplace(m_Threads.begin() + i, thread_job);
+		m_Threads.reserve(thread_count);
+		for (SizeType i = 0; i < thread_count; ++i) {
+			m_Threads.emplace_back(thread_job);
 		}
 	}
 
@@ -56,14 +62,17 @@ namespace Vortex {
 	}
 
 	void ThreadPool::Join() {
-		m_Running = false;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Running = false;
+		}
 		m_StateSignal.notify_all();
 
 		for (auto& thread : m_Threads) {
 			thread.join();
 		}
 
-		while (m_JobQueue.empty()) {
+		while (!m_JobQueue.empty()) {
 			delete m_JobQueue.front();
 			m_JobQueue.pop();
 		}
@@ -79,10 +88,7 @@ namespace Vortex {
 	}
 
 	void ThreadPool::SplitForEach(SizeType array_count, SizeType& chunk_size, SizeType& job_count) {
-		auto chunk_count = m_Threads.size() > array_count ? array_count : m_Threads.size(); //min(m_Threads.Size(),array_count)
-		chunk_size = array_count / chunk_count;
-		auto remaining_chunk_size = array_count % chunk_count;
-		auto remaining_chunk_count = remaining_chunk_size / chunk_size;
-		job_count = chunk_count + remaining_chunk_count;
+		job_count = m_Threads.size() > array_count ? array_count : m_Threads.size(); //min(m_Threads.Size(),array_count)
+		chunk_size = job_count > 0 ? array_count / job_count : 0;
 	}
 }
\ No newline at end of file
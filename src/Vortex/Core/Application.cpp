@@ -1,5 +1,15 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <thread>
+
 #include "Vortex/Core/Application.h"
 #include "Vortex/Common/Console.h"
+#include "Vortex/Debug/Profiler.h"
+
+#ifndef VORTEX_DEBUG_PROFILER_CAPTURE_KEY
+  #define VORTEX_DEBUG_PROFILER_CAPTURE_KEY Vortex::KeyCode::F11
+#endif
 
 namespace Vortex {
 	Application* Application::s_Instance{nullptr};
@@ -11,30 +21,202 @@ namespace Vortex {
 
 		s_Instance = this;
 
+		VORTEX_DEBUG_PROFILER_BEGIN
 		OnStart();
 
-		Timer<float> frame_timer;
+		using Seconds = TimerTraits::Seconds<float>;
+
 		bool running = true;
+		auto last_frame_begin = TimerTraits::TimeNow();
+
+		m_EventBatch.reserve(m_EventQueue.GetCapacity());
 
 		do {
-			frame_timer.Start();
+			VORTEX_DEBUG_PROFILER_FRAME_BEGIN
+			auto frame_begin = TimerTraits::TimeNow();
+			FrameTiming timing{};
+
+			// time between frame starts, pacing included
+			auto dt = std::chrono::duration_cast<Seconds>(frame_begin - last_frame_begin).count();
+			last_frame_begin = frame_begin;
+
+			m_EventBatch.clear();
+			dt = GatherFrameEvents_(dt);
 
-			while (!m_EventQueue.empty()) {
-				auto& event = m_EventQueue.front();
-				OnEvent(event);
+			auto dropped_event_count = m_EventQueue.GetDroppedEventCount();
+			if (dropped_event_count != m_ReportedDroppedEventCount) {
+				Console::WriteWarning("[Application] %zu events dropped, event queue is full.", dropped_event_count - m_ReportedDroppedEventCount);
+				m_ReportedDroppedEventCount = dropped_event_count;
+			}
+
+			if (m_EventCoalescing) {
+				EventQueue::Coalesce(m_EventBatch);
+			}
+			OnEvents(m_EventBatch.data(), m_EventBatch.size());
+
+			// in posting order, a key released and pressed again within the frame must end up pressed
+			for (const auto& event : m_EventBatch) {
+				m_EventBus.Publish(event);
+			}
+
+			for (const auto& event : m_EventBatch) {
 				if (event.Type == EventType::ApplicationClose) {
 					running = false;
 				}
-				m_EventQueue.pop();
+#ifdef VORTEX_DEBUG
+				if (event.Type == EventType::KeyPress && event.KeyPress.Keycode == VORTEX_DEBUG_PROFILER_CAPTURE_KEY) {
+					VORTEX_DEBUG_PROFILER_TIMELINE_CAPTURE("Profiler_Timeline.json")
+				}
+#endif
 			}
 
-			OnUpdate(frame_timer.Get());
+			UpdateFixed_(dt, timing);
+			OnUpdate(dt);
+
+			timing.FrameTime = dt;
+			timing.WorkTime = std::chrono::duration_cast<Seconds>(TimerTraits::TimeNow() - frame_begin).count();
+
+			// a replay runs as fast as possible
+			if (m_SessionPlayer != nullptr) {
+				m_ReplayFrameTimes.push_back(timing.WorkTime);
+			} else {
+				timing.PacingTime = PaceFrame_(frame_begin);
+			}
 
-			frame_timer.Stop();
+			m_FrameTimings[m_FrameIndex % FrameTimingHistorySize] = timing;
+			++m_FrameIndex;
+			// samples the frame's counters and writes requested timeline captures
+			VORTEX_DEBUG_PROFILER_FRAME_END
 		} while (running);
 
+		if (m_SessionPlayer != nullptr) {
+			ReportReplay_();
+		}
+		m_SessionRecorder.reset();
+		m_SessionPlayer.reset();
+
 		OnStop();
 		s_Instance = nullptr;
 		Console::Shutdown();
 	}
+
+	bool Application::RecordSession(const std::filesystem::path& path) {
+		VORTEX_ASSERT_MSG(s_Instance == nullptr, "Sessions are recorded from the start of Run")
+		VORTEX_ASSERT_MSG(m_SessionPlayer == nullptr, "Can not record while replaying a session")
+
+		m_SessionRecorder = std::make_unique<SessionRecorder>(path);
+		if (!m_SessionRecorder->IsOpen()) {
+			m_SessionRecorder.reset();
+			return false;
+		}
+		return true;
+	}
+
+	bool Application::ReplaySession(const std::filesystem::path& path) {
+		VORTEX_ASSERT_MSG(s_Instance == nullptr, "Sessions are replayed from the start of Run")
+		VORTEX_ASSERT_MSG(m_SessionRecorder == nullptr, "Can not replay while recording a session")
+
+		m_SessionPlayer = std::make_unique<SessionPlayer>(path);
+		if (!m_SessionPlayer->IsOpen()) {
+			m_SessionPlayer.reset();
+			return false;
+		}
+		return true;
+	}
+
+	float Application::GatherFrameEvents_(float dt) {
+		// one batch per frame, bounded by the queue capacity
+		m_EventQueue.Drain(m_EventBatch, m_EventQueue.GetCapacity());
+		if (m_SessionPlayer == nullptr && m_SessionRecorder == nullptr) {
+			return dt;
+		}
+
+		auto is_external = [](const Event& event) {
+			return event.Source != EventSource::Application && event.Source != EventSource::User;
+		};
+
+		m_SessionEventBatch.clear();
+		if (m_SessionRecorder != nullptr) {
+			std::copy_if(m_EventBatch.begin(), m_EventBatch.end(), std::back_inserter(m_SessionEventBatch), is_external);
+			m_SessionRecorder->WriteFrame(m_SessionEventBatch.data(), m_SessionEventBatch.size(), dt);
+			return dt;
+		}
+
+		// only what the application posts itself happens again, everything else comes from the session
+		std::remove_copy_if(m_EventBatch.begin(), m_EventBatch.end(), std::back_inserter(m_SessionEventBatch), is_external);
+		m_EventBatch.clear();
+		if (!m_SessionPlayer->ReadFrame(m_EventBatch, dt)) {
+			m_EventBatch.push_back(Event::CreateApplicationClose());
+		}
+		m_EventBatch.insert(m_EventBatch.end(), m_SessionEventBatch.begin(), m_SessionEventBatch.end());
+		return dt;
+	}
+
+	void Application::UpdateFixed_(float dt, FrameTiming& timing) {
+		auto step = m_LoopSettings.FixedTimeStep;
+		if (step <= 0.0f) {
+			m_InterpolationAlpha = 0.0f;
+			return;
+		}
+
+		m_Accumulator += dt;
+		while (m_Accumulator >= step && timing.FixedStepCount < m_LoopSettings.MaxFixedSteps) {
+			OnFixedUpdate(step);
+			m_Accumulator -= step;
+			++timing.FixedStepCount;
+		}
+
+		// behind by more than MaxFixedSteps, keep only the partial step
+		if (m_Accumulator >= step) {
+			auto remainder = std::fmod(m_Accumulator, step);
+			timing.DroppedTime = m_Accumulator - remainder;
+			m_Accumulator = remainder;
+		}
+		m_InterpolationAlpha = m_Accumulator / step;
+	}
+
+	float Application::PaceFrame_(TimerTraits::Timepoint frame_begin) {
+		if (m_LoopSettings.TargetFrameRate <= 0.0f) {
+			return 0.0f;
+		}
+
+		using Seconds = TimerTraits::Seconds<float>;
+		auto frame_end = frame_begin + std::chrono::duration_cast<TimerTraits::ClockType::duration>(Seconds{1.0f / m_LoopSettings.TargetFrameRate});
+		auto spin_time = std::chrono::duration_cast<TimerTraits::ClockType::duration>(Seconds{m_LoopSettings.SpinTime});
+
+		auto pacing_begin = TimerTraits::TimeNow();
+		if (frame_end - pacing_begin > spin_time) {
+			std::this_thread::sleep_for(frame_end - pacing_begin - spin_time);
+		}
+		while (TimerTraits::TimeNow() < frame_end) {}
+
+		return std::chrono::duration_cast<Seconds>(TimerTraits::TimeNow() - pacing_begin).count();
+	}
+
+	void Application::ReportReplay_() {
+		if (m_ReplayFrameTimes.empty()) {
+			return;
+		}
+
+		auto frame_times = m_ReplayFrameTimes;
+		std::sort(frame_times.begin(), frame_times.end());
+
+		double total{0};
+		for (auto frame_time : frame_times) {
+			total += frame_time;
+		}
+		auto percentile = [&frame_times](double p) {
+			return frame_times[std::min(frame_times.size() - 1, static_cast<SizeType>(p * static_cast<double>(frame_times.size())))];
+		};
+
+		Console::WriteInfo(
+			"[Application] Replayed %zu frames in %.3f s: mean %.3f ms, median %.3f ms, p99 %.3f ms, max %.3f ms",
+			frame_times.size(),
+			total,
+			total / static_cast<double>(frame_times.size()) * 1000.0,
+			percentile(0.5) * 1000.0,
+			percentile(0.99) * 1000.0,
+			frame_times.back() * 1000.0
+		);
+	}
 }
\ No newline at end of file
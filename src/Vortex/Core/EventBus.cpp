@@ -0,0 +1,31 @@
+#include "Vortex/Core/EventBus.h"
+
+namespace Vortex {
+	void EventBus::Dispatch() {
+		// take every pending list first, events enqueued by listeners wait for the next Dispatch
+		for (SizeType type = 0; type < EventType::Count; ++type) {
+			std::swap(m_Pending[type], m_Dispatching[type]);
+		}
+
+		for (SizeType type = 0; type < EventType::Count; ++type) {
+			auto& dispatching = m_Dispatching[type];
+			if (dispatching.empty()) {
+				continue;
+			}
+
+			const auto* events = dispatching.data();
+			auto count = dispatching.size();
+
+			m_BatchListeners[type](events, count);
+
+			const auto& listeners = m_Listeners[type];
+			if (!listeners.Empty()) {
+				for (SizeType i = 0; i < count; ++i) {
+					listeners(events[i]);
+				}
+			}
+
+			dispatching.clear();
+		}
+	}
+}
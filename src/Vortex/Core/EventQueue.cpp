@@ -0,0 +1,72 @@
+#include "Vortex/Core/EventQueue.h"
+
+namespace Vortex {
+	namespace {
+		constexpr SizeType NoEvent = ~SizeType{0};
+
+		// open runs of one window, windows are few so a linear search beats a map
+		struct CoalesceRun {
+			UInt16 Handle;
+			SizeType MouseMove;
+			SizeType ScrollChange;
+		};
+
+		// every input and window event starts with its window handle
+		inline UInt16 GetHandle(const Event& event) {
+			return event.KeyPress.Handle;
+		}
+	}
+
+	SizeType EventQueue::Coalesce(std::vector<Event>& batch) {
+		constexpr static SizeType max_run_count = 16;
+		CoalesceRun runs[max_run_count];
+		SizeType run_count{0};
+
+		auto find_run = [&](UInt16 handle) -> CoalesceRun* {
+			for (SizeType i = 0; i < run_count; ++i) {
+				if (runs[i].Handle == handle) { return &runs[i]; }
+			}
+			if (run_count == max_run_count) { return nullptr; }
+			runs[run_count] = CoalesceRun{handle, NoEvent, NoEvent};
+			return &runs[run_count++];
+		};
+
+		SizeType write_index{0};
+		for (SizeType read_index = 0; read_index < batch.size(); ++read_index) {
+			const auto& event = batch[read_index];
+
+			if (event.Type == EventType::None || event.Type >= EventType::WindowEventCount) {
+				batch[write_index++] = event;
+				continue;
+			}
+
+			auto* run = find_run(GetHandle(event));
+			if (event.Type == EventType::MouseMove && run != nullptr) {
+				if (run->MouseMove != NoEvent) {
+					auto& merged = batch[run->MouseMove];
+					merged.MouseMove.Delta = event.MouseMove.Delta;
+					merged.Timestamp = event.Timestamp;
+					continue;
+				}
+				run->MouseMove = write_index;
+			} else if (event.Type == EventType::ScrollChange && run != nullptr) {
+				if (run->ScrollChange != NoEvent) {
+					auto& merged = batch[run->ScrollChange];
+					merged.ScrollChange.Delta.x += event.ScrollChange.Delta.x;
+					merged.ScrollChange.Delta.y += event.ScrollChange.Delta.y;
+					merged.Timestamp = event.Timestamp;
+					continue;
+				}
+				run->ScrollChange = write_index;
+			} else if (run != nullptr) {
+				run->MouseMove = NoEvent;
+				run->ScrollChange = NoEvent;
+			}
+			batch[write_index++] = event;
+		}
+
+		auto removed_count = batch.size() - write_index;
+		batch.resize(write_index);
+		return removed_count;
+	}
+}
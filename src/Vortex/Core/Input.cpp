@@ -25,7 +25,9 @@ namespace Vortex {
 		m_LastChar{'\0'} {
 	}
 
-	Input::~Input() = default;
+	Input::~Input() {
+		Unsubscribe();
+	}
 
 	void Input::Update() {
 		if (CursorInputMode == CursorInputMode::Emulated) {
@@ -54,19 +56,34 @@ namespace Vortex {
 		m_LastChar = '\0';
 	}
 
-	void Input::OnEvent(const Event& event) {
-		switch (event.Type) {
-			case EventType::None:
-			case EventType::MouseEventCount:
-			case EventType::WindowResize:
-			case EventType::WindowPathDrop:
-			case EventType::WindowEventCount:
-			case EventType::WindowFocusLost:
-			case EventType::WindowFocusGain:
-			case EventType::ApplicationClose:
-			case EventType::Count:
-			case EventType::KeyboardEventCount:break;
+	void Input::Subscribe(EventBus& event_bus) {
+		Unsubscribe();
+		m_EventBus = &event_bus;
+		m_Subscriptions = {
+			event_bus.Subscribe<&Input::OnKeyEvent>(EventType::KeyPress, this),
+			event_bus.Subscribe<&Input::OnKeyEvent>(EventType::KeyRelease, this),
+			event_bus.Subscribe<&Input::OnKeyEvent>(EventType::KeyRepeat, this),
+			event_bus.Subscribe<&Input::OnCharInput>(EventType::CharInput, this),
+			event_bus.Subscribe<&Input::OnMouseButtonEvent>(EventType::MousePress, this),
+			event_bus.Subscribe<&Input::OnMouseButtonEvent>(EventType::MouseRelease, this),
+			event_bus.Subscribe<&Input::OnMouseMove>(EventType::MouseMove, this),
+			event_bus.Subscribe<&Input::OnScrollChange>(EventType::ScrollChange, this)
+		};
+	}
+
+	void Input::Unsubscribe() {
+		if (m_EventBus == nullptr) {
+			return;
+		}
+		for (const auto& subscription : m_Subscriptions) {
+			m_EventBus->Unsubscribe(subscription);
+		}
+		m_Subscriptions.clear();
+		m_EventBus = nullptr;
+	}
 
+	void Input::OnKeyEvent(const Event& event) {
+		switch (event.Type) {
 			case EventType::KeyPress: {
 				m_Keyboard[event.KeyPress.Keycode] = StateDown | StateChanged;
 				break;
@@ -79,35 +96,37 @@ namespace Vortex {
 				m_Keyboard[event.KeyRepeat.Keycode] = StateDown | StateChanged;
 				break;
 			}
-			case EventType::CharInput: {
-				m_LastChar = event.CharInput.Character;
-				break;
-			}
-			case EventType::MousePress: {
-				m_MouseButton[event.MousePress.Button] = StateDown | StateChanged;
-				break;
-			}
-			case EventType::MouseRelease: {
-				m_MouseButton[event.MouseRelease.Button] = StateUp | StateChanged;
-				break;
-			}
-			case EventType::MouseMove: {
-				m_CursorDelta[0] = event.MouseMove.Delta[0] - m_LastCursorPosition[0];
-				m_CursorDelta[1] = event.MouseMove.Delta[1] - m_LastCursorPosition[1];
-				m_LastCursorPosition[0] = event.MouseMove.Delta[0];
-				m_LastCursorPosition[1] = event.MouseMove.Delta[1];
-
-				if (CursorInputMode == CursorInputMode::OS) {
-					m_CursorPosition[0] = Math::Clamp(event.MouseMove.Delta[0], CursorLimits[0], CursorLimits[2]);
-					m_CursorPosition[1] = Math::Clamp(event.MouseMove.Delta[1], CursorLimits[1], CursorLimits[3]);
-				}
-				break;
-			}
-			case EventType::ScrollChange: {
-				m_ScrollDelta[0] = event.ScrollChange.Delta[0];
-				m_ScrollDelta[1] = event.ScrollChange.Delta[1];
-				break;
-			}
+			default: break;
+		}
+	}
+
+	void Input::OnCharInput(const Event& event) {
+		m_LastChar = event.CharInput.Character;
+	}
+
+	void Input::OnMouseButtonEvent(const Event& event) {
+		if (event.Type == EventType::MousePress) {
+			m_MouseButton[event.MousePress.Button] = StateDown | StateChanged;
+		} else {
+			m_MouseButton[event.MouseRelease.Button] = StateUp | StateChanged;
 		}
 	}
+
+	void Input::OnMouseMove(const Event& event) {
+		// MouseMove carries the cursor position, deltas of every move since the last Update add up
+		m_CursorDelta[0] += event.MouseMove.Delta[0] - m_LastCursorPosition[0];
+		m_CursorDelta[1] += event.MouseMove.Delta[1] - m_LastCursorPosition[1];
+		m_LastCursorPosition[0] = event.MouseMove.Delta[0];
+		m_LastCursorPosition[1] = event.MouseMove.Delta[1];
+
+		if (CursorInputMode == CursorInputMode::OS) {
+			m_CursorPosition[0] = Math::Clamp(event.MouseMove.Delta[0], CursorLimits[0], CursorLimits[2]);
+			m_CursorPosition[1] = Math::Clamp(event.MouseMove.Delta[1], CursorLimits[1], CursorLimits[3]);
+		}
+	}
+
+	void Input::OnScrollChange(const Event& event) {
+		m_ScrollDelta[0] += event.ScrollChange.Delta[0];
+		m_ScrollDelta[1] += event.ScrollChange.Delta[1];
+	}
 }
\ No newline at end of file
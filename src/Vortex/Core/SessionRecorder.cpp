@@ -0,0 +1,115 @@
+#include "Vortex/Core/SessionRecorder.h"
+
+namespace Vortex {
+	namespace Session {
+		SizeType GetPayloadSize(EventType::Enum type) {
+			switch (type) {
+				case EventType::KeyPress: return sizeof(Event::KeyPress);
+				case EventType::KeyRelease: return sizeof(Event::KeyRelease);
+				case EventType::KeyRepeat: return sizeof(Event::KeyRepeat);
+				case EventType::CharInput: return sizeof(Event::CharInput);
+				case EventType::MousePress: return sizeof(Event::MousePress);
+				case EventType::MouseRelease: return sizeof(Event::MouseRelease);
+				case EventType::MouseMove: return sizeof(Event::MouseMove);
+				case EventType::ScrollChange: return sizeof(Event::ScrollChange);
+				case EventType::WindowResize: return sizeof(Event::WindowResize);
+				case EventType::WindowFocusLost: return sizeof(Event::WindowFocusLost);
+				case EventType::WindowFocusGain: return sizeof(Event::WindowFocusGain);
+				case EventType::WindowClose: return sizeof(Event::WindowClose);
+				default: return 0;
+			}
+		}
+
+		inline bool IsRecorded(EventType::Enum type) {
+			return type != EventType::WindowPathDrop && type < EventType::Count;
+		}
+	}
+
+	SessionRecorder::SessionRecorder(const std::filesystem::path& path)
+		: m_File{path, std::ios::binary | std::ios::trunc},
+		  m_FrameCount{0} {
+
+		if (!m_File.is_open()) {
+			return;
+		}
+
+		UInt32 reserved{0};
+		m_File.write(reinterpret_cast<const char*>(&Session::Magic), sizeof(Session::Magic));
+		m_File.write(reinterpret_cast<const char*>(&Session::Version), sizeof(Session::Version));
+		m_File.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+	}
+	SessionRecorder::~SessionRecorder() {
+		m_File.flush();
+	}
+
+	void SessionRecorder::WriteFrame(const Event* events, SizeType count, float dt) {
+		if (!IsOpen()) { return; }
+
+		UInt32 recorded_count{0};
+		for (SizeType i = 0; i < count; ++i) {
+			recorded_count += Session::IsRecorded(events[i].Type);
+		}
+
+		m_File.write(reinterpret_cast<const char*>(&recorded_count), sizeof(recorded_count));
+		m_File.write(reinterpret_cast<const char*>(&dt), sizeof(dt));
+
+		for (SizeType i = 0; i < count; ++i) {
+			const auto& event = events[i];
+			if (!Session::IsRecorded(event.Type)) { continue; }
+
+			UInt8 header[2]{static_cast<UInt8>(event.Type), static_cast<UInt8>(event.Source)};
+			m_File.write(reinterpret_cast<const char*>(header), sizeof(header));
+			m_File.write(reinterpret_cast<const char*>(&event.KeyPress), static_cast<std::streamsize>(Session::GetPayloadSize(event.Type)));
+		}
+		++m_FrameCount;
+	}
+
+	SessionPlayer::SessionPlayer(const std::filesystem::path& path)
+		: m_File{path, std::ios::binary},
+		  m_Valid{false},
+		  m_FrameCount{0} {
+
+		UInt64 magic{0};
+		UInt32 version{0};
+		UInt32 reserved{0};
+		m_File.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+		m_File.read(reinterpret_cast<char*>(&version), sizeof(version));
+		m_File.read(reinterpret_cast<char*>(&reserved), sizeof(reserved));
+		m_Valid = m_File.good() && magic == Session::Magic && version == Session::Version;
+	}
+
+	bool SessionPlayer::ReadFrame(std::vector<Event>& events, float& dt) {
+		if (!m_Valid) { return false; }
+
+		UInt32 count{0};
+		m_File.read(reinterpret_cast<char*>(&count), sizeof(count));
+		m_File.read(reinterpret_cast<char*>(&dt), sizeof(dt));
+		if (!m_File.good()) {
+			m_Valid = false;
+			return false;
+		}
+
+		for (UInt32 i = 0; i < count; ++i) {
+			UInt8 header[2];
+			m_File.read(reinterpret_cast<char*>(header), sizeof(header));
+
+			auto type = static_cast<EventType::Enum>(header[0]);
+			if (!m_File.good() || !Session::IsRecorded(type)) {
+				m_Valid = false;
+				return false;
+			}
+
+			Event event{type};
+			event.Source = static_cast<EventSource::Enum>(header[1]);
+			m_File.read(reinterpret_cast<char*>(&event.KeyPress), static_cast<std::streamsize>(Session::GetPayloadSize(type)));
+			events.push_back(event);
+		}
+
+		if (!m_File.good()) {
+			m_Valid = false;
+			return false;
+		}
+		++m_FrameCount;
+		return true;
+	}
+}
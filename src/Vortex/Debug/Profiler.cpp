@@ -1,44 +1,353 @@
 #ifdef VORTEX_DEBUG
 #include "Vortex/Debug/Profiler.h"
 
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
 namespace Vortex::DebugProfiler {
-	MapType ProfileMap;
-	MapType FrameProfileMap;
-	std::chrono::steady_clock::time_point ProfileStartTime;
-	std::chrono::steady_clock::time_point FrameStartTime;
+	struct CallTreeNode {
+		NameType Name;
+		NodeIndexType Parent;
+		std::vector<NodeIndexType> Children;
+
+		DurationType InclusiveTime{0};
+		DurationType ChildTime{0};
+		CallCountType CallCount{0};
+	};
+
+	struct ThreadProfileData {
+		std::mutex Mutex;
+		ThreadIDType ThreadID;
+		NameType Name;
+		std::uint32_t Depth{0};
+		std::vector<TimelineEvent> Events;
+
+		// zone totals of this thread, merged across threads when results are queried
+		MapType ProfileMap;
+		MapType FrameProfileMap;
+
+		// node 0 is the thread root, nodes are never removed so indices stay valid across profiles
+		std::vector<CallTreeNode> CallTree{CallTreeNode{"", 0, {}}};
+		NodeIndexType CurrentNode{0};
+	};
+
+	// written lock-free by any thread, one cache line per counter so hot counters do not share lines
+	struct alignas(64) CounterValue {
+		std::atomic<double> Value{0};
+		std::atomic<bool> Persistent{false}; // set counters keep their value across frames, added ones restart at zero
+	};
+
+	struct RawCounterData {
+		NameType Name;
+
+		std::vector<double> History;
+		std::size_t HistoryHead{0};
+		std::size_t HistoryCount{0};
+
+		double MinValue{0};
+		double MaxValue{0};
+		double SumValue{0};
+		CallCountType SampleCount{0};
+
+		void Sample(double value);
+		void ResetStatistics();
+	};
 
-	bool FrameCall{false};
+	// CounterMutex guards registration and the sampled data, CounterValues are only indexed by registered ids
+	std::mutex CounterMutex;
+	std::unordered_map<KeyType, CounterIDType> CounterIDs;
+	std::vector<RawCounterData> Counters;
+	std::array<CounterValue, VORTEX_DEBUG_PROFILER_MAX_COUNTERS> CounterValues;
+
+	std::mutex ThreadRegistryMutex;
+	std::vector<std::unique_ptr<ThreadProfileData>> ThreadRegistry;
+	thread_local ThreadProfileData* CurrentThreadData{nullptr};
+
+	std::atomic<bool> TimelineActive{false};
+	std::vector<TimelineFrame> TimelineFrames;
+	std::size_t TimelineFrameHead{0};
+	std::size_t TimelineFrameCount{0};
+
+	bool TimelineCaptureRequested{false};
+	bool TimelineCaptureOwnsTimeline{false};
+	std::size_t TimelineCaptureRemaining{0};
+	std::filesystem::path TimelineCapturePath;
+
+	ClockType::time_point ProfileStartTime;
+	ClockType::time_point FrameStartTime;
+
+	// zones on any thread count as frame zones while the game thread is between BeginFrame and EndFrame
+	std::atomic<bool> FrameCall{false};
 	std::size_t FrameCount{0};
 	DurationType TotalFrameTime{0};
+	LatencyHistogram FrameTimeHistogram;
 
 	ProfilerResultData::ProfilerResultData(NameType name,
 										   DurationType total_time,
 										   DurationType max_time,
 										   DurationType average_time,
 										   CallCountType call_count,
+										   const LatencyStatistics& latency,
 										   double utilization):
 		Name{std::move(name)},
 		TotalTime{total_time},
 		MaxTime{max_time},
 		AverageTime{average_time},
 		CallCount{call_count},
+		Latency{latency},
 		Utilization{utilization} {}
 
+	std::uint32_t LatencyHistogram::GetBucketIndex(std::uint64_t value) {
+		if (value < SubBucketCount) {
+			return static_cast<std::uint32_t>(value);
+		}
+
+		std::uint32_t exponent = 63;
+		while ((value >> exponent) == 0) {
+			--exponent;
+		}
+		if (exponent > MaxExponent) {
+			return BucketCount - 1;
+		}
+
+		auto shift = exponent - SubBucketBits;
+		auto sub_bucket = static_cast<std::uint32_t>(value >> shift) - SubBucketCount;
+		return SubBucketCount * (shift + 1) + sub_bucket;
+	}
+
+	std::uint64_t LatencyHistogram::GetBucketLowerBound(std::uint32_t index) {
+		if (index < SubBucketCount) {
+			return index;
+		}
+		auto shift = index / SubBucketCount - 1;
+		auto sub_bucket = index % SubBucketCount;
+		return static_cast<std::uint64_t>(SubBucketCount + sub_bucket) << shift;
+	}
+
+	std::uint64_t LatencyHistogram::GetBucketUpperBound(std::uint32_t index) {
+		if (index < SubBucketCount) {
+			return index;
+		}
+		auto shift = index / SubBucketCount - 1;
+		return GetBucketLowerBound(index) + (std::uint64_t{1} << shift) - 1;
+	}
+
+	void LatencyHistogram::Record(const DurationType& elapsed) {
+		auto value = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+		++m_Buckets[GetBucketIndex(value)];
+		++m_Count;
+
+		m_Min = std::min(m_Min, value);
+		m_Max = std::max(m_Max, value);
+
+		// Welford's online algorithm, stable over long runs
+		auto delta = static_cast<double>(value) - m_Mean;
+		m_Mean += delta / static_cast<double>(m_Count);
+		m_M2 += delta * (static_cast<double>(value) - m_Mean);
+	}
+
+	void LatencyHistogram::Merge(const LatencyHistogram& other) {
+		if (other.m_Count == 0) {
+			return;
+		}
+
+		for (std::uint32_t i = 0; i < BucketCount; ++i) {
+			m_Buckets[i] += other.m_Buckets[i];
+		}
+
+		auto count_a = static_cast<double>(m_Count);
+		auto count_b = static_cast<double>(other.m_Count);
+		auto count = count_a + count_b;
+		auto delta = other.m_Mean - m_Mean;
+
+		m_Mean += delta * count_b / count;
+		m_M2 += other.m_M2 + delta * delta * count_a * count_b / count;
+		m_Count += other.m_Count;
+		m_Min = std::min(m_Min, other.m_Min);
+		m_Max = std::max(m_Max, other.m_Max);
+	}
+
+	void LatencyHistogram::Reset() {
+		*this = LatencyHistogram{};
+	}
+
+	DurationType LatencyHistogram::GetValueAtPercentile(double percentile) const {
+		if (m_Count == 0) {
+			return DurationType{0};
+		}
+
+		auto rank = static_cast<CallCountType>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(m_Count)));
+		rank = std::max<CallCountType>(rank, 1);
+
+		CallCountType seen = 0;
+		std::uint32_t index = 0;
+		for (; index < BucketCount; ++index) {
+			seen += m_Buckets[index];
+			if (seen >= rank) {
+				break;
+			}
+		}
+
+		// report the middle of the bucket, but never outside of what was actually recorded
+		auto lower = GetBucketLowerBound(index);
+		auto value = lower + (GetBucketUpperBound(index) - lower) / 2;
+		value = std::clamp(value, m_Min, m_Max);
+		return std::chrono::duration_cast<DurationType>(std::chrono::nanoseconds{value});
+	}
+
+	LatencyStatistics LatencyHistogram::GetStatistics() const {
+		LatencyStatistics statistics;
+		if (m_Count == 0) {
+			return statistics;
+		}
+
+		constexpr static double ns_to_ms = 1.0 / 1000000.0;
+		statistics.MinTime = DurationType{static_cast<double>(m_Min) * ns_to_ms};
+		statistics.MaxTime = DurationType{static_cast<double>(m_Max) * ns_to_ms};
+		statistics.MeanTime = DurationType{m_Mean * ns_to_ms};
+		statistics.Variance = m_M2 / static_cast<double>(m_Count) * ns_to_ms * ns_to_ms;
+
+		statistics.P50 = GetValueAtPercentile(50.0);
+		statistics.P90 = GetValueAtPercentile(90.0);
+		statistics.P99 = GetValueAtPercentile(99.0);
+		statistics.P999 = GetValueAtPercentile(99.9);
+		return statistics;
+	}
+
+	void RawCounterData::Sample(double value) {
+		if (History.empty()) {
+			History.resize(VORTEX_DEBUG_PROFILER_COUNTER_FRAMES);
+		}
+		History[HistoryHead] = value;
+		HistoryHead = (HistoryHead + 1) % History.size();
+		if (HistoryCount < History.size()) {
+			++HistoryCount;
+		}
+
+		MinValue = SampleCount == 0 ? value : std::min(MinValue, value);
+		MaxValue = SampleCount == 0 ? value : std::max(MaxValue, value);
+		SumValue += value;
+		++SampleCount;
+	}
+
+	void RawCounterData::ResetStatistics() {
+		HistoryHead = 0;
+		HistoryCount = 0;
+		MinValue = 0;
+		MaxValue = 0;
+		SumValue = 0;
+		SampleCount = 0;
+	}
+
+	void GetHistory(const RawCounterData& counter_data, std::vector<double>& history) {
+		history.clear();
+		history.reserve(counter_data.HistoryCount);
+		auto size = counter_data.History.size();
+		for (std::size_t i = 0; i < counter_data.HistoryCount; ++i) {
+			history.push_back(counter_data.History[(counter_data.HistoryHead + size - counter_data.HistoryCount + i) % size]);
+		}
+	}
+
+	void SampleCounters(std::vector<TimelineCounter>* timeline_counters) {
+		std::unique_lock lock{CounterMutex};
+		for (CounterIDType counter_id = 0; counter_id < Counters.size(); ++counter_id) {
+			auto& counter_value = CounterValues[counter_id];
+			auto value = counter_value.Persistent.load(std::memory_order_relaxed)
+				? counter_value.Value.load(std::memory_order_relaxed)
+				: counter_value.Value.exchange(0, std::memory_order_relaxed);
+
+			auto& counter_data = Counters[counter_id];
+			if (timeline_counters != nullptr) {
+				timeline_counters->push_back(TimelineCounter{counter_data.Name, value});
+			}
+			counter_data.Sample(value);
+		}
+	}
+
 	void BeginProfile() {
-		ProfileMap.clear();
-		ProfileStartTime = std::chrono::steady_clock::now();
+		FrameTimeHistogram.Reset();
+		{
+			std::unique_lock lock{CounterMutex};
+			for (auto& counter_data : Counters) {
+				counter_data.ResetStatistics();
+			}
+		}
+		{
+			std::unique_lock registry_lock{ThreadRegistryMutex};
+			for (auto& thread_data : ThreadRegistry) {
+				std::unique_lock lock{thread_data->Mutex};
+				thread_data->ProfileMap.clear();
+				for (auto& node : thread_data->CallTree) {
+					node.InclusiveTime = DurationType{0};
+					node.ChildTime = DurationType{0};
+					node.CallCount = 0;
+				}
+			}
+		}
+		ProfileStartTime = ClockType::now();
+	}
+
+	void CollectCallTree(const ThreadProfileData& thread_data, NodeIndexType node_index, NodeIndexType parent, std::uint32_t depth, std::size_t frame_count, CallTreeResult& result) {
+		const auto& node = thread_data.CallTree[node_index];
+		if (node.CallCount == 0) {
+			return;
+		}
+
+		auto frames = static_cast<double>(frame_count > 0 ? frame_count : 1);
+		auto exclusive_time = node.InclusiveTime - node.ChildTime;
+
+		auto index = static_cast<NodeIndexType>(result.Nodes.size());
+		result.Nodes.push_back(CallTreeResultData{
+			node.Name,
+			depth == 0 ? index : parent,
+			depth,
+			node.InclusiveTime,
+			exclusive_time,
+			node.InclusiveTime / frames,
+			exclusive_time / frames,
+			node.CallCount,
+			static_cast<double>(node.CallCount) / frames
+		});
+
+		for (auto child : node.Children) {
+			CollectCallTree(thread_data, child, index, depth + 1, frame_count, result);
+		}
+	}
+
+	void MergeProfileMaps(MapType& profile_map, MapType& frame_profile_map) {
+		std::unique_lock registry_lock{ThreadRegistryMutex};
+		for (auto& thread_data : ThreadRegistry) {
+			std::unique_lock lock{thread_data->Mutex};
+			for (const auto& data : thread_data->ProfileMap) {
+				profile_map[data.first].Merge(data.second);
+			}
+			for (const auto& data : thread_data->FrameProfileMap) {
+				frame_profile_map[data.first].Merge(data.second);
+			}
+		}
 	}
 
 	ProfilerResult EndProfile() {
-		auto profile_duration = std::chrono::steady_clock::now() - ProfileStartTime;
+		auto profile_duration = ClockType::now() - ProfileStartTime;
 
 		ProfilerResult results;
 		results.TotalTime = std::chrono::duration_cast<DurationType>(profile_duration);
 		results.TotalFrameTime = TotalFrameTime;
 		results.FrameCount = FrameCount;
+		results.FrameTimeStatistics = FrameTimeHistogram.GetStatistics();
+		results.FrameTimeHistogram = FrameTimeHistogram;
 
-		results.Data.reserve(ProfileMap.size());
-		for (const auto& data : ProfileMap) {
+		MapType profile_map;
+		MapType frame_profile_map;
+		MergeProfileMaps(profile_map, frame_profile_map);
+
+		results.Data.reserve(profile_map.size());
+		for (const auto& data : profile_map) {
 			const auto& name = data.first;
 			const auto& profile_data = data.second;
 
@@ -51,12 +360,13 @@ namespace Vortex::DebugProfiler {
 				profile_data.MaxTime,
 				average_time,
 				profile_data.CallCount,
+				profile_data.Histogram.GetStatistics(),
 				utilization
 			);
 		}
 
-		results.FrameData.reserve(FrameProfileMap.size());
-		for (const auto& data : FrameProfileMap) {
+		results.FrameData.reserve(frame_profile_map.size());
+		for (const auto& data : frame_profile_map) {
 			const auto& name = data.first;
 			const auto& profile_data = data.second;
 
@@ -69,29 +379,596 @@ namespace Vortex::DebugProfiler {
 				profile_data.MaxTime,
 				average_time,
 				profile_data.CallCount,
+				profile_data.Histogram.GetStatistics(),
 				utilization
 			);
 		}
+
+		{
+			std::unique_lock lock{CounterMutex};
+			results.Counters.reserve(Counters.size());
+			for (const auto& counter_data : Counters) {
+				if (counter_data.SampleCount == 0) {
+					continue;
+				}
+
+				CounterResultData counter_result{
+					counter_data.Name,
+					counter_data.MinValue,
+					counter_data.MaxValue,
+					counter_data.SumValue / static_cast<double>(counter_data.SampleCount),
+					counter_data.History[(counter_data.HistoryHead + counter_data.History.size() - 1) % counter_data.History.size()],
+					counter_data.SampleCount,
+					{}
+				};
+				GetHistory(counter_data, counter_result.History);
+				results.Counters.push_back(std::move(counter_result));
+			}
+			std::sort(results.Counters.begin(), results.Counters.end(), [](const CounterResultData& a, const CounterResultData& b) {
+				return a.Name < b.Name;
+			});
+		}
+
+		std::unique_lock registry_lock{ThreadRegistryMutex};
+		results.CallTrees.reserve(ThreadRegistry.size());
+		for (auto& thread_data : ThreadRegistry) {
+			std::unique_lock lock{thread_data->Mutex};
+
+			CallTreeResult call_tree;
+			call_tree.ThreadID = thread_data->ThreadID;
+			call_tree.ThreadName = thread_data->Name;
+			for (auto child : thread_data->CallTree[0].Children) {
+				CollectCallTree(*thread_data, child, 0, 0, FrameCount, call_tree);
+			}
+
+			if (!call_tree.Nodes.empty()) {
+				results.CallTrees.push_back(std::move(call_tree));
+			}
+		}
 		return results;
 	}
 
+	TimestampType ToTimestamp(ClockType::time_point time_point) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point - ProfileStartTime).count();
+	}
+
+	ThreadProfileData& GetThreadData() {
+		if (CurrentThreadData == nullptr) {
+			std::unique_lock lock{ThreadRegistryMutex};
+			auto& thread_data = ThreadRegistry.emplace_back(std::make_unique<ThreadProfileData>());
+			thread_data->ThreadID = static_cast<ThreadIDType>(ThreadRegistry.size());
+			thread_data->Name = "Thread " + std::to_string(thread_data->ThreadID);
+			CurrentThreadData = thread_data.get();
+		}
+		return *CurrentThreadData;
+	}
+
+	void CollectTimelineFrame(ClockType::time_point frame_end_time) {
+		auto& frame = TimelineFrames[TimelineFrameHead];
+		frame.FrameIndex = FrameCount;
+		frame.Start = ToTimestamp(FrameStartTime);
+		frame.Duration = ToTimestamp(frame_end_time) - frame.Start;
+		frame.Events.clear();
+		frame.Counters.clear();
+		SampleCounters(&frame.Counters);
+
+		std::unique_lock registry_lock{ThreadRegistryMutex};
+		for (auto& thread_data : ThreadRegistry) {
+			std::unique_lock lock{thread_data->Mutex};
+			frame.Events.insert(frame.Events.end(), thread_data->Events.begin(), thread_data->Events.end());
+			thread_data->Events.clear();
+		}
+		registry_lock.unlock();
+
+		std::sort(frame.Events.begin(), frame.Events.end(), [](const TimelineEvent& a, const TimelineEvent& b) {
+			return a.Start < b.Start || (a.Start == b.Start && a.Depth < b.Depth);
+		});
+
+		TimelineFrameHead = (TimelineFrameHead + 1) % TimelineFrames.size();
+		if (TimelineFrameCount < TimelineFrames.size()) {
+			++TimelineFrameCount;
+		}
+	}
+
 	void BeginFrame() {
 		FrameCall = true;
-		FrameStartTime = std::chrono::steady_clock::now();
+		FrameStartTime = ClockType::now();
 	}
 
 	void EndFrame() {
-		TotalFrameTime += std::chrono::duration_cast<DebugProfiler::DurationType>(std::chrono::steady_clock::now() - FrameStartTime);;
+		auto frame_end_time = ClockType::now();
+		auto frame_time = std::chrono::duration_cast<DebugProfiler::DurationType>(frame_end_time - FrameStartTime);
+		TotalFrameTime += frame_time;
+		FrameTimeHistogram.Record(frame_time);
+
+		if (TimelineActive) {
+			CollectTimelineFrame(frame_end_time);
+
+			if (TimelineCaptureRequested && (TimelineCaptureRemaining == 0 || --TimelineCaptureRemaining == 0)) {
+				WriteTimelineToFile(TimelineCapturePath, CaptureTimeline());
+				TimelineCaptureRequested = false;
+
+				if (TimelineCaptureOwnsTimeline) {
+					TimelineCaptureOwnsTimeline = false;
+					EndTimeline();
+				}
+			}
+		} else {
+			SampleCounters(nullptr);
+		}
+
 		FrameCall = false;
 		++FrameCount;
 	}
 
+	LatencyStatistics QueryFrameStatistics() {
+		return FrameTimeHistogram.GetStatistics();
+	}
+
+	LatencyStatistics QueryZoneStatistics(const KeyType& name) {
+		LatencyHistogram histogram;
+		GetZoneHistogram(name, histogram);
+		return histogram.GetStatistics();
+	}
+
+	const LatencyHistogram& GetFrameHistogram() {
+		return FrameTimeHistogram;
+	}
+
+	bool GetZoneHistogram(const KeyType& name, LatencyHistogram& histogram) {
+		histogram.Reset();
+
+		bool found = false;
+		std::unique_lock registry_lock{ThreadRegistryMutex};
+		for (auto& thread_data : ThreadRegistry) {
+			std::unique_lock lock{thread_data->Mutex};
+			for (const auto* map : {&thread_data->FrameProfileMap, &thread_data->ProfileMap}) {
+				auto it = map->find(name);
+				if (it != map->end()) {
+					histogram.Merge(it->second.Histogram);
+					found = true;
+				}
+			}
+		}
+		return found;
+	}
+
+	CounterIDType RegisterCounter(const KeyType& name) {
+		std::unique_lock lock{CounterMutex};
+		auto it = CounterIDs.find(name);
+		if (it != CounterIDs.end()) {
+			return it->second;
+		}
+
+		if (Counters.size() == CounterValues.size()) {
+			std::fprintf(stderr, "[Profiler] Counter \"%s\" ignored, VORTEX_DEBUG_PROFILER_MAX_COUNTERS (%u) reached.\n", name.c_str(), VORTEX_DEBUG_PROFILER_MAX_COUNTERS);
+			CounterIDs.emplace(name, InvalidCounterID);
+			return InvalidCounterID;
+		}
+
+		auto counter_id = static_cast<CounterIDType>(Counters.size());
+		Counters.push_back(RawCounterData{name});
+		CounterIDs.emplace(name, counter_id);
+		return counter_id;
+	}
+
+	void AddCounter(CounterIDType counter_id, double value) {
+		if (counter_id == InvalidCounterID) {
+			return;
+		}
+		auto& counter_value = CounterValues[counter_id].Value;
+		auto current = counter_value.load(std::memory_order_relaxed);
+		while (!counter_value.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+		}
+	}
+
+	void SetCounter(CounterIDType counter_id, double value) {
+		if (counter_id == InvalidCounterID) {
+			return;
+		}
+		auto& counter_value = CounterValues[counter_id];
+		counter_value.Value.store(value, std::memory_order_relaxed);
+		counter_value.Persistent.store(true, std::memory_order_relaxed);
+	}
+
+	void AddCounter(const KeyType& name, double value) {
+		AddCounter(RegisterCounter(name), value);
+	}
+
+	void SetCounter(const KeyType& name, double value) {
+		SetCounter(RegisterCounter(name), value);
+	}
+
+	bool GetCounterHistory(const KeyType& name, std::vector<double>& history) {
+		std::unique_lock lock{CounterMutex};
+		auto it = CounterIDs.find(name);
+		if (it == CounterIDs.end() || it->second == InvalidCounterID) {
+			history.clear();
+			return false;
+		}
+		GetHistory(Counters[it->second], history);
+		return true;
+	}
+
+	void SetThreadName(const NameType& name) {
+		auto& thread_data = GetThreadData();
+		std::unique_lock lock{thread_data.Mutex};
+		thread_data.Name = name;
+	}
+
+	void BeginTimeline(std::size_t frame_count) {
+		EndTimeline();
+		TimelineFrames.resize(frame_count > 0 ? frame_count : 1);
+		TimelineFrameHead = 0;
+		TimelineFrameCount = 0;
+		TimelineActive = true;
+	}
+
+	void EndTimeline() {
+		TimelineActive = false;
+		TimelineFrames.clear();
+		TimelineFrameHead = 0;
+		TimelineFrameCount = 0;
+
+		std::unique_lock registry_lock{ThreadRegistryMutex};
+		for (auto& thread_data : ThreadRegistry) {
+			std::unique_lock lock{thread_data->Mutex};
+			thread_data->Events.clear();
+		}
+	}
+
+	bool IsTimelineActive() {
+		return TimelineActive;
+	}
+
+	TimelineCapture CaptureTimeline() {
+		TimelineCapture capture;
+		{
+			std::unique_lock registry_lock{ThreadRegistryMutex};
+			capture.Threads.reserve(ThreadRegistry.size());
+			for (auto& thread_data : ThreadRegistry) {
+				std::unique_lock lock{thread_data->Mutex};
+				capture.Threads.push_back(TimelineThread{thread_data->ThreadID, thread_data->Name});
+			}
+		}
+
+		capture.Frames.reserve(TimelineFrameCount);
+		auto oldest = (TimelineFrameHead + TimelineFrames.size() - TimelineFrameCount) % (TimelineFrames.empty() ? 1 : TimelineFrames.size());
+		for (std::size_t i = 0; i < TimelineFrameCount; ++i) {
+			capture.Frames.push_back(TimelineFrames[(oldest + i) % TimelineFrames.size()]);
+		}
+		return capture;
+	}
+
+	void RequestTimelineCapture(const std::filesystem::path& path, std::size_t frame_count) {
+		if (TimelineCaptureRequested) {
+			return;
+		}
+
+		TimelineCapturePath = path;
+		TimelineCaptureRequested = true;
+		if (TimelineActive) {
+			TimelineCaptureRemaining = 0;
+		} else {
+			BeginTimeline(frame_count);
+			TimelineCaptureOwnsTimeline = true;
+			TimelineCaptureRemaining = frame_count;
+		}
+	}
+
+	void WriteJsonString(std::ostream& ostream, const NameType& str) {
+		ostream << '"';
+		for (char c : str) {
+			switch (c) {
+				case '"': ostream << "\\\""; break;
+				case '\\': ostream << "\\\\"; break;
+				case '\n': ostream << "\\n"; break;
+				case '\t': ostream << "\\t"; break;
+				default: {
+					if (static_cast<unsigned char>(c) < 0x20) {
+						char escape_buffer[8];
+						sprintf_s(escape_buffer, "\\u%04x", c);
+						ostream << escape_buffer;
+					} else {
+						ostream << c;
+					}
+				}
+			}
+		}
+		ostream << '"';
+	}
+
+	void WriteChromeTrace(std::ostream& ostream, const TimelineCapture& capture) {
+		constexpr static int process_id = 1;
+		constexpr static int frame_thread_id = 0;
+
+		ostream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		ostream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << process_id << ",\"args\":{\"name\":\"Vortex\"}}";
+		ostream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << process_id << ",\"tid\":" << frame_thread_id << ",\"args\":{\"name\":\"Frames\"}}";
+
+		for (const auto& thread : capture.Threads) {
+			ostream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << process_id << ",\"tid\":" << thread.ThreadID << ",\"args\":{\"name\":";
+			WriteJsonString(ostream, thread.Name);
+			ostream << "}}";
+		}
+
+		char line_buffer[256];
+		for (const auto& frame : capture.Frames) {
+			sprintf_s(line_buffer, ",\n{\"name\":\"Frame %zu\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+					  frame.FrameIndex,
+					  static_cast<double>(frame.Start) / 1000.0,
+					  static_cast<double>(frame.Duration) / 1000.0,
+					  process_id,
+					  frame_thread_id);
+			ostream << line_buffer;
+
+			for (const auto& event : frame.Events) {
+				ostream << ",\n{\"name\":";
+				WriteJsonString(ostream, event.Name);
+				sprintf_s(line_buffer, ",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u,\"args\":{\"depth\":%u}}",
+						  static_cast<double>(event.Start) / 1000.0,
+						  static_cast<double>(event.Duration) / 1000.0,
+						  process_id,
+						  event.ThreadID,
+						  event.Depth);
+				ostream << line_buffer;
+			}
+
+			for (const auto& counter : frame.Counters) {
+				ostream << ",\n{\"name\":";
+				WriteJsonString(ostream, counter.Name);
+				sprintf_s(line_buffer, ",\"cat\":\"counter\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%d,\"args\":{\"value\":%.17g}}",
+						  static_cast<double>(frame.Start) / 1000.0,
+						  process_id,
+						  counter.Value);
+				ostream << line_buffer;
+			}
+		}
+		ostream << "\n]}\n";
+	}
+
+	// Minimal protobuf writer for the subset of perfetto/trace/trace.proto used below.
+	namespace Protobuf {
+		enum WireType {
+			Varint = 0,
+			Fixed64 = 1,
+			LengthDelimited = 2
+		};
+
+		void WriteVarint(std::string& out, std::uint64_t value) {
+			while (value >= 0x80) {
+				out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+				value >>= 7;
+			}
+			out.push_back(static_cast<char>(value));
+		}
+		void WriteTag(std::string& out, std::uint32_t field, WireType type) {
+			WriteVarint(out, (static_cast<std::uint64_t>(field) << 3) | type);
+		}
+		void WriteVarintField(std::string& out, std::uint32_t field, std::uint64_t value) {
+			WriteTag(out, field, Varint);
+			WriteVarint(out, value);
+		}
+		void WriteDoubleField(std::string& out, std::uint32_t field, double value) {
+			std::uint64_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			WriteTag(out, field, Fixed64);
+			for (int i = 0; i < 8; ++i) {
+				out.push_back(static_cast<char>((bits >> (i * 8)) & 0xFF)); // little endian
+			}
+		}
+		void WriteBytesField(std::string& out, std::uint32_t field, const std::string& bytes) {
+			WriteTag(out, field, LengthDelimited);
+			WriteVarint(out, bytes.size());
+			out.append(bytes);
+		}
+	}
+
+	namespace Perfetto {
+		// field numbers from perfetto/trace/*.proto
+		constexpr static std::uint32_t TracePacket = 1;                 // Trace
+
+		constexpr static std::uint32_t Timestamp = 8;                   // TracePacket
+		constexpr static std::uint32_t TrustedPacketSequenceID = 10;    // TracePacket
+		constexpr static std::uint32_t TrackEvent = 11;                 // TracePacket
+		constexpr static std::uint32_t SequenceFlags = 13;              // TracePacket
+		constexpr static std::uint32_t TrackDescriptor = 60;            // TracePacket
+
+		constexpr static std::uint32_t TrackUUID = 1;                   // TrackDescriptor
+		constexpr static std::uint32_t TrackName = 2;                   // TrackDescriptor
+		constexpr static std::uint32_t TrackProcess = 3;                // TrackDescriptor
+		constexpr static std::uint32_t TrackThread = 4;                 // TrackDescriptor
+		constexpr static std::uint32_t TrackParentUUID = 5;             // TrackDescriptor
+		constexpr static std::uint32_t TrackCounter = 8;                // TrackDescriptor
+
+		constexpr static std::uint32_t ProcessID = 1;                   // ProcessDescriptor, ThreadDescriptor
+		constexpr static std::uint32_t ThreadID = 2;                    // ThreadDescriptor
+		constexpr static std::uint32_t ThreadName = 5;                  // ThreadDescriptor
+		constexpr static std::uint32_t ProcessName = 6;                 // ProcessDescriptor
+
+		constexpr static std::uint32_t EventType = 9;                   // TrackEvent
+		constexpr static std::uint32_t EventTrackUUID = 11;             // TrackEvent
+		constexpr static std::uint32_t EventName = 23;                  // TrackEvent
+		constexpr static std::uint32_t EventDoubleCounterValue = 44;    // TrackEvent
+
+		constexpr static std::uint64_t SliceBegin = 1;                  // TrackEvent::Type
+		constexpr static std::uint64_t SliceEnd = 2;                    // TrackEvent::Type
+		constexpr static std::uint64_t Counter = 4;                     // TrackEvent::Type
+
+		constexpr static std::uint64_t IncrementalStateCleared = 1;     // TracePacket::SequenceFlags
+		constexpr static std::uint32_t SequenceID = 1;
+
+		constexpr static std::uint64_t ProcessTrackUUID = 1;
+		constexpr static std::uint64_t FrameTrackUUID = 2;
+		constexpr static std::uint64_t ThreadTrackUUIDBase = 16;
+		constexpr static std::uint64_t CounterTrackUUIDBase = std::uint64_t{1} << 32;
+
+		void WritePacket(std::ostream& ostream, const std::string& packet) {
+			std::string trace;
+			Protobuf::WriteBytesField(trace, TracePacket, packet);
+			ostream.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+		}
+
+		void WriteSlice(std::ostream& ostream, std::uint64_t track_uuid, TimestampType timestamp, std::uint64_t type, const NameType* name) {
+			std::string track_event;
+			Protobuf::WriteVarintField(track_event, EventType, type);
+			Protobuf::WriteVarintField(track_event, EventTrackUUID, track_uuid);
+			if (name != nullptr) {
+				Protobuf::WriteBytesField(track_event, EventName, *name);
+			}
+
+			std::string packet;
+			Protobuf::WriteVarintField(packet, Timestamp, static_cast<std::uint64_t>(timestamp));
+			Protobuf::WriteVarintField(packet, TrustedPacketSequenceID, SequenceID);
+			Protobuf::WriteBytesField(packet, TrackEvent, track_event);
+			WritePacket(ostream, packet);
+		}
+
+		void WriteCounter(std::ostream& ostream, std::uint64_t track_uuid, TimestampType timestamp, double value) {
+			std::string track_event;
+			Protobuf::WriteVarintField(track_event, EventType, Counter);
+			Protobuf::WriteVarintField(track_event, EventTrackUUID, track_uuid);
+			Protobuf::WriteDoubleField(track_event, EventDoubleCounterValue, value);
+
+			std::string packet;
+			Protobuf::WriteVarintField(packet, Timestamp, static_cast<std::uint64_t>(timestamp));
+			Protobuf::WriteVarintField(packet, TrustedPacketSequenceID, SequenceID);
+			Protobuf::WriteBytesField(packet, TrackEvent, track_event);
+			WritePacket(ostream, packet);
+		}
+	}
+
+	void WritePerfettoTrace(std::ostream& ostream, const TimelineCapture& capture) {
+		constexpr static int process_id = 1;
+		{
+			std::string process;
+			Protobuf::WriteVarintField(process, Perfetto::ProcessID, process_id);
+			Protobuf::WriteBytesField(process, Perfetto::ProcessName, "Vortex");
+
+			std::string descriptor;
+			Protobuf::WriteVarintField(descriptor, Perfetto::TrackUUID, Perfetto::ProcessTrackUUID);
+			Protobuf::WriteBytesField(descriptor, Perfetto::TrackProcess, process);
+
+			std::string packet;
+			Protobuf::WriteVarintField(packet, Perfetto::TrustedPacketSequenceID, Perfetto::SequenceID);
+			Protobuf::WriteVarintField(packet, Perfetto::SequenceFlags, Perfetto::IncrementalStateCleared);
+			Protobuf::WriteBytesField(packet, Perfetto::TrackDescriptor, descriptor);
+			Perfetto::WritePacket(ostream, packet);
+		}
+		{
+			std::string descriptor;
+			Protobuf::WriteVarintField(descriptor, Perfetto::TrackUUID, Perfetto::FrameTrackUUID);
+			Protobuf::WriteBytesField(descriptor, Perfetto::TrackName, "Frames");
+			Protobuf::WriteVarintField(descriptor, Perfetto::TrackParentUUID, Perfetto::ProcessTrackUUID);
+
+			std::string packet;
+			Protobuf::WriteVarintField(packet, Perfetto::TrustedPacketSequenceID, Perfetto::SequenceID);
+			Protobuf::WriteBytesField(packet, Perfetto::TrackDescriptor, descriptor);
+			Perfetto::WritePacket(ostream, packet);
+		}
+		for (const auto& thread : capture.Threads) {
+			std::string thread_descriptor;
+			Protobuf::WriteVarintField(thread_descriptor, Perfetto::ProcessID, process_id);
+			Protobuf::WriteVarintField(thread_descriptor, Perfetto::ThreadID, thread.ThreadID);
+			Protobuf::WriteBytesField(thread_descriptor, Perfetto::ThreadName, thread.Name);
+
+			std::string descriptor;
+			Protobuf::WriteVarintField(descriptor, Perfetto::TrackUUID, Perfetto::ThreadTrackUUIDBase + thread.ThreadID);
+			Protobuf::WriteBytesField(descriptor, Perfetto::TrackThread, thread_descriptor);
+
+			std::string packet;
+			Protobuf::WriteVarintField(packet, Perfetto::TrustedPacketSequenceID, Perfetto::SequenceID);
+			Protobuf::WriteBytesField(packet, Perfetto::TrackDescriptor, descriptor);
+			Perfetto::WritePacket(ostream, packet);
+		}
+
+		std::map<NameType, std::uint64_t> counter_tracks;
+		for (const auto& frame : capture.Frames) {
+			for (const auto& counter : frame.Counters) {
+				counter_tracks.emplace(counter.Name, 0);
+			}
+		}
+		auto next_counter_track_uuid = Perfetto::CounterTrackUUIDBase;
+		for (auto& [name, track_uuid] : counter_tracks) {
+			track_uuid = next_counter_track_uuid++;
+
+			std::string descriptor;
+			Protobuf::WriteVarintField(descriptor, Perfetto::TrackUUID, track_uuid);
+			Protobuf::WriteBytesField(descriptor, Perfetto::TrackName, name);
+			Protobuf::WriteVarintField(descriptor, Perfetto::TrackParentUUID, Perfetto::ProcessTrackUUID);
+			Protobuf::WriteBytesField(descriptor, Perfetto::TrackCounter, "");
+
+			std::string packet;
+			Protobuf::WriteVarintField(packet, Perfetto::TrustedPacketSequenceID, Perfetto::SequenceID);
+			Protobuf::WriteBytesField(packet, Perfetto::TrackDescriptor, descriptor);
+			Perfetto::WritePacket(ostream, packet);
+		}
+
+		struct SliceEdge {
+			TimestampType Timestamp;
+			std::uint64_t Type;
+			std::uint32_t Depth;
+			const TimelineEvent* Event;
+		};
+		std::vector<SliceEdge> edges;
+
+		for (const auto& frame : capture.Frames) {
+			auto frame_name = "Frame " + std::to_string(frame.FrameIndex);
+			Perfetto::WriteSlice(ostream, Perfetto::FrameTrackUUID, frame.Start, Perfetto::SliceBegin, &frame_name);
+			Perfetto::WriteSlice(ostream, Perfetto::FrameTrackUUID, frame.Start + frame.Duration, Perfetto::SliceEnd, nullptr);
+
+			// slices on a track must be properly nested: ends before begins on ties, children inside parents
+			edges.clear();
+			for (const auto& event : frame.Events) {
+				edges.push_back(SliceEdge{event.Start, Perfetto::SliceBegin, event.Depth, &event});
+				edges.push_back(SliceEdge{event.Start + event.Duration, Perfetto::SliceEnd, event.Depth, &event});
+			}
+			std::stable_sort(edges.begin(), edges.end(), [](const SliceEdge& a, const SliceEdge& b) {
+				if (a.Timestamp != b.Timestamp) { return a.Timestamp < b.Timestamp; }
+				if (a.Type != b.Type) { return a.Type == Perfetto::SliceEnd; }
+				return a.Type == Perfetto::SliceBegin ? a.Depth < b.Depth : a.Depth > b.Depth;
+			});
+
+			for (const auto& edge : edges) {
+				auto track_uuid = Perfetto::ThreadTrackUUIDBase + edge.Event->ThreadID;
+				const NameType* name = edge.Type == Perfetto::SliceBegin ? &edge.Event->Name : nullptr;
+				Perfetto::WriteSlice(ostream, track_uuid, edge.Timestamp, edge.Type, name);
+			}
+
+			for (const auto& counter : frame.Counters) {
+				Perfetto::WriteCounter(ostream, counter_tracks[counter.Name], frame.Start, counter.Value);
+			}
+		}
+	}
+
+	void WriteTimelineToFile(const std::filesystem::path& path, const TimelineCapture& capture) {
+		auto extension = path.extension();
+		if (extension == ".pftrace" || extension == ".perfetto-trace") {
+			std::ofstream file{path, std::ios_base::binary};
+			WritePerfettoTrace(file, capture);
+		} else {
+			std::ofstream file{path};
+			WriteChromeTrace(file, capture);
+		}
+	}
+
 	void RawProfileData::AddTime(const DurationType& elapsed) {
 		if (MaxTime < elapsed) {
 			MaxTime = elapsed;
 		}
 		TotalTime += elapsed;
 		++CallCount;
+		Histogram.Record(elapsed);
+	}
+
+	void RawProfileData::Merge(const RawProfileData& other) {
+		if (MaxTime < other.MaxTime) {
+			MaxTime = other.MaxTime;
+		}
+		TotalTime += other.TotalTime;
+		CallCount += other.CallCount;
+		Histogram.Merge(other.Histogram);
 	}
 
 	void WriteResultsSorted(std::ostream& ostream, const std::vector<ProfilerResultData>& result, std::size_t count) {
@@ -140,34 +1017,156 @@ namespace Vortex::DebugProfiler {
 		});
 
 		char line_buffer[1024];
-		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-16s\n",
+		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-12s | %-12s | %-12s | %-12s | %-16s\n",
 				  "Call Count",
 				  "Utilization (%)",
 				  "AverageTime (ms)",
 				  "MaximumTime (ms)",
+				  "p50 (ms)",
+				  "p90 (ms)",
+				  "p99 (ms)",
+				  "p99.9 (ms)",
 				  "Method Name");
 		ostream << "\t" << line_buffer;
 
-		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-16s\n",
+		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-12s | %-12s | %-12s | %-12s | %-16s\n",
 				  "----------------",
 				  "----------------",
 				  "----------------",
 				  "----------------",
+				  "------------",
+				  "------------",
+				  "------------",
+				  "------------",
 				  "----------------");
 		ostream << "\t" << line_buffer;
 
 		for (auto& i : sorted_data) {
-			sprintf_s(line_buffer, "%-16llu | %-16.3f | %-16f | %-16f | %s\n",
+			sprintf_s(line_buffer, "%-16llu | %-16.3f | %-16f | %-16f | %-12f | %-12f | %-12f | %-12f | %s\n",
 					  i.CallCount,
 					  i.Utilization * 100,
 					  i.AverageTime.count(),
 					  i.MaxTime.count(),
+					  i.Latency.P50.count(),
+					  i.Latency.P90.count(),
+					  i.Latency.P99.count(),
+					  i.Latency.P999.count(),
 					  i.Name.c_str()
 			);
 			ostream << "\t" << line_buffer;
 		}
 	}
 
+	void WriteCallTreeTable(std::ostream& ostream, const CallTreeResult& call_tree) {
+		char line_buffer[1024];
+		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-16s | %-16s\n",
+				  "Call Count",
+				  "Calls / Frame",
+				  "Inclusive (ms)",
+				  "Exclusive (ms)",
+				  "Incl. / Frame",
+				  "Excl. / Frame");
+		ostream << "\t" << line_buffer;
+
+		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-16s | %-16s\n",
+				  "----------------",
+				  "----------------",
+				  "----------------",
+				  "----------------",
+				  "----------------",
+				  "----------------");
+		ostream << "\t" << line_buffer;
+
+		for (const auto& node : call_tree.Nodes) {
+			sprintf_s(line_buffer, "%-16llu | %-16.3f | %-16f | %-16f | %-16f | %-16f | %*s%s\n",
+					  static_cast<unsigned long long>(node.CallCount),
+					  node.CallsPerFrame,
+					  node.InclusiveTime.count(),
+					  node.ExclusiveTime.count(),
+					  node.InclusiveTimePerFrame.count(),
+					  node.ExclusiveTimePerFrame.count(),
+					  static_cast<int>(node.Depth * 2), "",
+					  node.Name.c_str()
+			);
+			ostream << "\t" << line_buffer;
+		}
+	}
+
+	void WriteCounterTable(std::ostream& ostream, const std::vector<CounterResultData>& counters) {
+		char line_buffer[1024];
+		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-16s | %-16s\n",
+				  "Samples",
+				  "Minimum",
+				  "Mean",
+				  "Maximum",
+				  "Last",
+				  "Counter Name");
+		ostream << "\t" << line_buffer;
+
+		sprintf_s(line_buffer, "%-16s | %-16s | %-16s | %-16s | %-16s | %-16s\n",
+				  "----------------",
+				  "----------------",
+				  "----------------",
+				  "----------------",
+				  "----------------",
+				  "----------------");
+		ostream << "\t" << line_buffer;
+
+		for (const auto& counter : counters) {
+			sprintf_s(line_buffer, "%-16llu | %-16.3f | %-16.3f | %-16.3f | %-16.3f | %s\n",
+					  static_cast<unsigned long long>(counter.SampleCount),
+					  counter.MinValue,
+					  counter.MeanValue,
+					  counter.MaxValue,
+					  counter.LastValue,
+					  counter.Name.c_str()
+			);
+			ostream << "\t" << line_buffer;
+		}
+	}
+
+	void WriteFrameTimeHistogram(std::ostream& ostream, const LatencyHistogram& histogram) {
+		constexpr static std::size_t bar_width = 50;
+		if (histogram.GetCount() == 0) {
+			return;
+		}
+
+		// group the fine buckets per power of two, that is detailed enough to spot stutter
+		std::vector<std::pair<std::uint64_t, CallCountType>> rows;
+		for (std::uint32_t i = 0; i < LatencyHistogram::BucketCount; ++i) {
+			auto count = histogram.GetBucketCount(i);
+			if (count == 0) {
+				continue;
+			}
+
+			auto lower = LatencyHistogram::GetBucketLowerBound(i);
+			std::uint64_t octave = 1;
+			while (octave * 2 <= lower) {
+				octave *= 2;
+			}
+			if (rows.empty() || rows.back().first != octave) {
+				rows.emplace_back(octave, 0);
+			}
+			rows.back().second += count;
+		}
+
+		CallCountType max_count = 0;
+		for (const auto& row : rows) {
+			max_count = std::max(max_count, row.second);
+		}
+
+		char line_buffer[1024];
+		for (const auto& row : rows) {
+			auto bar_length = static_cast<std::size_t>(row.second * bar_width / max_count);
+			sprintf_s(line_buffer, "%10.3f - %-10.3f ms | %-8llu | %s\n",
+					  static_cast<double>(row.first) / 1000000.0,
+					  static_cast<double>(row.first * 2) / 1000000.0,
+					  static_cast<unsigned long long>(row.second),
+					  std::string(bar_length > 0 ? bar_length : 1, '#').c_str());
+			ostream << "\t" << line_buffer;
+		}
+	}
+
 	void WriteToStream(std::ostream& ostream, const ProfilerResult& result) {
 		auto finish_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
@@ -187,6 +1186,26 @@ namespace Vortex::DebugProfiler {
 		ostream << "\t" << "Frame Count      : " << frame_count << "\n";
 		ostream << "\t" << "Average FPS      : " << static_cast<double>(frame_count) / (frame_time.count() / 1000) << "\n";
 
+		const auto& frame_statistics = result.FrameTimeStatistics;
+		char line_buffer[256];
+		sprintf_s(line_buffer, "min %.3f / mean %.3f / max %.3f ms, std dev %.3f ms (variance %.3f ms^2)",
+				  frame_statistics.MinTime.count(),
+				  frame_statistics.MeanTime.count(),
+				  frame_statistics.MaxTime.count(),
+				  std::sqrt(frame_statistics.Variance),
+				  frame_statistics.Variance);
+		ostream << "\t" << "Frame Time Stats : " << line_buffer << "\n";
+		sprintf_s(line_buffer, "p50 %.3f / p90 %.3f / p99 %.3f / p99.9 %.3f ms",
+				  frame_statistics.P50.count(),
+				  frame_statistics.P90.count(),
+				  frame_statistics.P99.count(),
+				  frame_statistics.P999.count());
+		ostream << "\t" << "Frame Time Pct.  : " << line_buffer << "\n";
+
+		ostream << "\n";
+		ostream << "Frame Time Histogram:\n";
+		WriteFrameTimeHistogram(ostream, result.FrameTimeHistogram);
+
 		ostream << "\n";
 		ostream << "Frame Profiling Data:\n";
 		WriteResultsSorted(ostream, result.FrameData, 5);
@@ -199,26 +1218,112 @@ namespace Vortex::DebugProfiler {
 		ostream << "\n";
 		WriteExtendedTable(ostream, result.Data);
 
+		if (!result.Counters.empty()) {
+			ostream << "\n";
+			ostream << "Counters (per frame):\n";
+			WriteCounterTable(ostream, result.Counters);
+		}
+
+		for (const auto& call_tree : result.CallTrees) {
+			ostream << "\n";
+			ostream << "Call Tree (" << call_tree.ThreadName << "):\n";
+			WriteCallTreeTable(ostream, call_tree);
+		}
 	}
+
 	void WriteToFile(const std::filesystem::path& path, const ProfilerResult& result) {
-		std::ofstream file{path};
-		WriteToStream(file, result);
+		{
+			std::ofstream file{path};
+			WriteToStream(file, result);
+		}
+
+		auto folded_path = path;
+		folded_path += ".folded";
+		std::ofstream folded_file{folded_path};
+		WriteCollapsedStacks(folded_file, result);
+	}
+
+	void WriteCollapsedStacks(std::ostream& ostream, const ProfilerResult& result) {
+		std::vector<std::size_t> stack_lengths;
+		std::string stack;
+
+		for (const auto& call_tree : result.CallTrees) {
+			stack_lengths.clear();
+			for (const auto& node : call_tree.Nodes) {
+				// nodes are depth-first, so the stack above this node is the first Depth entries
+				stack_lengths.resize(node.Depth);
+				stack.resize(stack_lengths.empty() ? 0 : stack_lengths.back());
+				if (stack.empty()) {
+					stack = call_tree.ThreadName;
+				}
+				stack += ';';
+				stack += node.Name;
+				stack_lengths.push_back(stack.size());
+
+				auto exclusive_us = static_cast<std::uint64_t>(node.ExclusiveTime.count() * 1000.0);
+				if (exclusive_us > 0) {
+					ostream << stack << ' ' << exclusive_us << '\n';
+				}
+			}
+		}
 	}
 }
 
 namespace Vortex {
 	UniqueProfiler::UniqueProfiler(DebugProfiler::KeyType name):
 		m_Name(std::move(name)),
-		m_Start(std::chrono::steady_clock::now()) {}
+		m_ThreadData(&DebugProfiler::GetThreadData()),
+		m_Node(0),
+		m_Depth(m_ThreadData->Depth++),
+		m_Start() {
+		{
+			std::unique_lock lock{m_ThreadData->Mutex};
+			auto& call_tree = m_ThreadData->CallTree;
+			auto parent = m_ThreadData->CurrentNode;
+
+			auto& children = call_tree[parent].Children;
+			auto it = std::find_if(children.begin(), children.end(), [&](DebugProfiler::NodeIndexType child) {
+				return call_tree[child].Name == m_Name;
+			});
+			if (it != children.end()) {
+				m_Node = *it;
+			} else {
+				m_Node = static_cast<DebugProfiler::NodeIndexType>(call_tree.size());
+				call_tree[parent].Children.push_back(m_Node);
+				call_tree.push_back(DebugProfiler::CallTreeNode{m_Name, parent, {}});
+			}
+			m_ThreadData->CurrentNode = m_Node;
+		}
+		m_Start = DebugProfiler::ClockType::now();
+	}
 
 	UniqueProfiler::~UniqueProfiler() {
-		auto end_time = std::chrono::steady_clock::now();
+		auto end_time = DebugProfiler::ClockType::now();
 		auto duration = std::chrono::duration_cast<DebugProfiler::DurationType>(end_time - m_Start);
 
-		if (DebugProfiler::FrameCall) {
-			DebugProfiler::FrameProfileMap[m_Name].AddTime(duration);
-		} else {
-			DebugProfiler::ProfileMap[m_Name].AddTime(duration);
+		--m_ThreadData->Depth;
+		{
+			std::unique_lock lock{m_ThreadData->Mutex};
+			auto& call_tree = m_ThreadData->CallTree;
+			auto& node = call_tree[m_Node];
+			node.InclusiveTime += duration;
+			++node.CallCount;
+			call_tree[node.Parent].ChildTime += duration;
+			m_ThreadData->CurrentNode = node.Parent;
+
+			if (DebugProfiler::TimelineActive) {
+				auto start = DebugProfiler::ToTimestamp(m_Start);
+				m_ThreadData->Events.push_back(DebugProfiler::TimelineEvent{
+					m_Name,
+					start,
+					DebugProfiler::ToTimestamp(end_time) - start,
+					m_ThreadData->ThreadID,
+					m_Depth
+				});
+			}
+
+			auto& profile_map = DebugProfiler::FrameCall ? m_ThreadData->FrameProfileMap : m_ThreadData->ProfileMap;
+			profile_map[m_Name].AddTime(duration);
 		}
 	}
 }
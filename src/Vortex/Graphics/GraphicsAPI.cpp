@@ -1,6 +1,7 @@
 #include "Vortex/Graphics/GraphicsAPI.h"
 
 #include "../Platform/OpenGL45/OpenGL45Renderer.h"
+#include "../Platform/Null/NullRenderer.h"
 
 namespace Vortex {
 	Graphics::Renderer* s_Renderer = nullptr;
@@ -11,6 +12,8 @@ namespace Vortex {
 		if (graphics == GraphicsType::OpenGL45) {
 			Vortex::s_Renderer = new Vortex::Graphics::OpenGL45Renderer();
 		} else if (graphics == GraphicsType::Vulkan) {
+		} else if (graphics == GraphicsType::Null) {
+			Vortex::s_Renderer = new Vortex::Graphics::NullRenderer();
 		}
 	}
 
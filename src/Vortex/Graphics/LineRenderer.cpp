@@ -21,6 +21,7 @@ namespace Vortex::Graphics {
 		  m_CurrentVertexIndex{0} {
 
 		if (s_InstanceCount == 0) {
+			m_Renderer->WaitIdle();
 			const char* sources[]{
 				R"(
 #version 450 core
@@ -64,6 +65,7 @@ void main() {
 
 	}
 	LineRenderer::~LineRenderer() {
+		m_Renderer->WaitIdle();
 		for (const auto& mesh : m_LineMeshes) {
 			Vortex::Console::WriteDebug("[LineRenderer] Mesh %u cleaned automatically.", mesh.first);
 			m_Renderer->DestroyMesh(mesh.first);
@@ -90,6 +92,7 @@ void main() {
 			m_TotalLineCapacity = line_capacity;
 		}
 
+		m_Renderer->WaitIdle();
 		MeshLayout layout = CreateMeshLayout(
 			ElementType::Float3,
 			ElementType::Float4
@@ -146,6 +149,7 @@ void main() {
 		auto index_count = m_CurrentVertexIndex * IndexPerLine;
 
 		const auto& line_mesh = m_LineMeshes[line_mesh_handle];
+		m_Renderer->WaitIdle();
 		m_Renderer->SetMeshIndexCount(line_mesh_handle, index_count);
 		m_Renderer->SetMeshData(
 			line_mesh_handle,
@@ -178,7 +182,7 @@ void main() {
 		Vortex::Math::Vector3 last_pos{start_pos};
 
 		Begin();
-		for (Vortex::SizeType i = 0; i <= number_of_segments; i++) {
+		for (Vortex::SizeType i = 1; i <= number_of_segments; i++) {
 			float theta = Vortex::Math::TwoPi<float>() * static_cast<float>(i) / static_cast<float>(number_of_segments); //get the current angle
 
 			Vortex::Math::Vector3 current_pos{
@@ -215,7 +219,7 @@ void main() {
 		};
 		Begin();
 		Insert(center_pos, last_pos, color);
-		for (Vortex::SizeType i = 0; i <= number_of_segments; i++) {
+		for (Vortex::SizeType i = 1; i <= number_of_segments; i++) {
 			float theta = angle.ToRadians() * static_cast<float>(i) / static_cast<float>(number_of_segments);
 
 			Vortex::Math::Vector3 current_pos{
@@ -254,7 +258,7 @@ void main() {
 		};
 		Begin();
 		Insert(center_pos, last_pos, color);
-		for (Vortex::SizeType i = 0; i <= number_of_segments; i++) {
+		for (Vortex::SizeType i = 1; i <= number_of_segments; i++) {
 			float theta = start_angle.ToRadians() - (angle.ToRadians() * static_cast<float>(i) / static_cast<float>(number_of_segments));
 
 			Vortex::Math::Vector3 current_pos{
@@ -0,0 +1,772 @@
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <limits>
+
+#include "Vortex/Graphics/Renderer.h"
+#include "Vortex/Common/Console.h"
+#include "Vortex/Common/ThreadPool.h"
+#include "Vortex/Debug/Profiler.h"
+
+namespace Vortex::Graphics {
+	template<typename T>
+	const T& Renderer::FindFrameState(const FrameState& state, const std::vector<Handle>& handles, const std::vector<T>& values, Handle handle) {
+		auto index = state.Indices[handle];
+		VORTEX_ASSERT_MSG(index < handles.size() && handles[index] == handle, "[Renderer] Handle is not part of the executing frame.")
+		return values[index];
+	}
+
+	void Renderer::WriteDrawDepths(DrawCommand* draw_commands, SizeType count) const {
+		// commands of one view mostly follow each other, its position is only extracted on a change
+		Handle view_handle{Map::NullHandle};
+		Math::Vector3 view_position;
+		for (SizeType i = 0; i < count; ++i) {
+			auto& cmd = draw_commands[i];
+			ViewLayer::Enum cmd_view_layer{GetSortingKeyViewLayer(cmd.Key)};
+
+			//calculate depths
+			if (cmd_view_layer != ViewLayer::PostProcess && m_DataMap.Is<View>(cmd.DrawHandle)) {
+				if (view_handle != cmd.DrawHandle) {
+					view_handle = cmd.DrawHandle;
+					GetFrameView(view_handle).ViewMatrix.Extract3DTranslation(view_position);
+				}
+
+				Math::Vector3 mesh_position;
+				cmd.TransformMatrix.Extract3DTranslation(mesh_position);
+
+				float distance{Math::Vector3::Distance(mesh_position, view_position)};
+
+				SetDrawKeyDepth(cmd.Key, static_cast<UInt16>(distance));
+
+#ifdef VORTEX_DEBUG
+				cmd.d_Depth = static_cast<UInt16>(distance);
+#endif
+			}
+		}
+	}
+
+	template<typename Fn>
+	void Renderer::ForEachSortChunk(SizeType count, SizeType chunk_count, Fn&& fn) {
+		auto chunk_size = count / chunk_count;
+		if (chunk_count == 1) {
+			fn(0, 0, count);
+			return;
+		}
+
+		for (SizeType chunk = 0; chunk < chunk_count; ++chunk) {
+			auto begin = chunk * chunk_size;
+			auto end = chunk + 1 == chunk_count ? count : begin + chunk_size; // last chunk takes the remainder
+			m_SortThreadPool->DoTask([&fn, chunk, begin, end]() { fn(chunk, begin, end); });
+		}
+		m_SortThreadPool->Dispatch().Await();
+	}
+
+	void Renderer::SortDrawCommands(std::vector<DrawCommand>& draw_commands) {
+		auto count = draw_commands.size();
+		VORTEX_ASSERT_MSG(count <= std::numeric_limits<UInt32>::max(), "Too many draw commands to sort")
+
+		SizeType chunk_count{1};
+		if (m_SortThreadPool != nullptr && count >= ParallelSortThreshold) {
+			chunk_count = std::max<SizeType>(1, std::min(m_SortThreadPool->GetThreadCount(), count / (ParallelSortThreshold / 4)));
+		}
+
+		m_SortEntries.resize(count);
+		m_SortScratch.resize(count);
+		m_SortHistograms.resize(chunk_count * SortPassCount * SortRadixSize);
+
+		auto get_digit = [](const SortEntry& entry, SizeType pass) -> SizeType {
+			constexpr static SizeType key_pass_count = sizeof(SortingKeyType) * CHAR_BIT / SortRadixBits;
+			if (pass < key_pass_count) {
+				return (entry.Key >> (pass * SortRadixBits)) & (SortRadixSize - 1);
+			}
+			return (entry.DrawHandle >> ((pass - key_pass_count) * SortRadixBits)) & (SortRadixSize - 1);
+		};
+		auto get_histogram = [this, chunk_count](SizeType chunk, SizeType pass) {
+			return m_SortHistograms.data() + (pass * chunk_count + chunk) * SortRadixSize;
+		};
+
+		// one read of the commands: depths, entries and the digit counts of every pass
+		ForEachSortChunk(count, chunk_count, [this, &draw_commands, &get_digit, &get_histogram](SizeType chunk, SizeType begin, SizeType end) {
+			WriteDrawDepths(draw_commands.data() + begin, end - begin);
+			for (SizeType pass = 0; pass < SortPassCount; ++pass) {
+				std::fill(get_histogram(chunk, pass), get_histogram(chunk, pass) + SortRadixSize, 0);
+			}
+
+			for (auto i = begin; i < end; ++i) {
+				const auto& entry = m_SortEntries[i] = SortEntry{draw_commands[i].Key, static_cast<UInt32>(i), draw_commands[i].DrawHandle};
+				for (SizeType pass = 0; pass < SortPassCount; ++pass) {
+					++get_histogram(chunk, pass)[get_digit(entry, pass)];
+				}
+			}
+		});
+
+		auto* source = &m_SortEntries;
+		auto* destination = &m_SortScratch;
+		bool reordered{false};
+		for (SizeType pass = 0; pass < SortPassCount; ++pass) {
+			// bucket sizes do not depend on the order, a pass where all keys share the digit would not move anything
+			bool single_bucket{false};
+			for (SizeType digit = 0; digit < SortRadixSize && !single_bucket; ++digit) {
+				SizeType bucket_count{0};
+				for (SizeType chunk = 0; chunk < chunk_count; ++chunk) {
+					bucket_count += get_histogram(chunk, pass)[digit];
+				}
+				single_bucket = bucket_count == count;
+			}
+			if (single_bucket) {
+				continue;
+			}
+
+			// chunk counts only hold for the order they were taken in
+			if (reordered && chunk_count > 1) {
+				ForEachSortChunk(count, chunk_count, [source, pass, &get_digit, &get_histogram](SizeType chunk, SizeType begin, SizeType end) {
+					auto* histogram = get_histogram(chunk, pass);
+					std::fill(histogram, histogram + SortRadixSize, 0);
+					for (auto i = begin; i < end; ++i) {
+						++histogram[get_digit((*source)[i], pass)];
+					}
+				});
+			}
+
+			// counts to write offsets, bucket major so each chunk scatters after the previous ones
+			UInt32 offset{0};
+			for (SizeType digit = 0; digit < SortRadixSize; ++digit) {
+				for (SizeType chunk = 0; chunk < chunk_count; ++chunk) {
+					auto& histogram_entry = get_histogram(chunk, pass)[digit];
+					auto chunk_bucket_count = histogram_entry;
+					histogram_entry = offset;
+					offset += chunk_bucket_count;
+				}
+			}
+
+			ForEachSortChunk(count, chunk_count, [source, destination, pass, &get_digit, &get_histogram](SizeType chunk, SizeType begin, SizeType end) {
+				auto* offsets = get_histogram(chunk, pass);
+				for (auto i = begin; i < end; ++i) {
+					const auto& entry = (*source)[i];
+					(*destination)[offsets[get_digit(entry, pass)]++] = entry;
+				}
+			});
+			std::swap(source, destination);
+			reordered = true;
+		}
+
+		m_SortedDrawCommands.resize(count);
+		ForEachSortChunk(count, chunk_count, [this, source, &draw_commands](SizeType, SizeType begin, SizeType end) {
+			for (auto i = begin; i < end; ++i) {
+				m_SortedDrawCommands[i] = draw_commands[(*source)[i].Index];
+			}
+		});
+		draw_commands.swap(m_SortedDrawCommands);
+	}
+
+	Handle Renderer::CreateMesh(Handle mesh_pool_handle, SizeType vertex_capacity, SizeType index_capacity) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateMesh called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MeshPoolChecks(mesh_pool_handle))
+		VORTEX_ASSERT(index_capacity > 0)
+		auto& mesh_pool = m_DataMap.Get<MeshPool>(mesh_pool_handle);
+
+		if (mesh_pool.VertexCount + vertex_capacity > mesh_pool.VertexCapacity
+			|| mesh_pool.IndexCount + index_capacity > mesh_pool.IndexCapacity) {
+			Console::WriteError("[Renderer] Mesh pool %u is full.", mesh_pool_handle);
+			return Map::NullHandle;
+		}
+
+		Mesh mesh{};
+		mesh.IndexBufferHandle = mesh_pool.IndexBufferHandle;
+		mesh.BufferHandles = mesh_pool.BufferHandles;
+		mesh.IndexCount = 0;
+		mesh.IndexCapacity = index_capacity;
+		mesh.Topology = mesh_pool.Topology;
+		mesh.PoolHandle = mesh_pool_handle;
+		mesh.BaseVertex = mesh_pool.VertexCount;
+		mesh.FirstIndex = mesh_pool.IndexCount;
+		mesh.AdditionalData = mesh_pool.AdditionalData;
+
+#ifdef VORTEX_DEBUG
+		for (auto buffer_handle : mesh.BufferHandles) {
+			mesh.d_BufferSizes.emplace_back(m_DataMap.Get<Buffer>(buffer_handle).Layout.Stride * vertex_capacity);
+		}
+#endif
+
+		mesh_pool.VertexCount += vertex_capacity;
+		mesh_pool.IndexCount += index_capacity;
+		return m_DataMap.Insert<Mesh>(mesh);
+	}
+
+	bool Renderer::IsInstancedMaterial(Handle material_handle) const {
+		const auto& material = GetFrameMaterial(material_handle);
+		const auto& shader = m_DataMap.Get<Shader>(material.ShaderHandle);
+		// multi draw takes precedence, it instances equal meshes itself
+		return (shader.Tags & ShaderTags::Instanced) != 0 && (shader.Tags & ShaderTags::MultiDraw) == 0;
+	}
+	SizeType Renderer::GetInstanceRunLength(const std::vector<DrawCommand>& draw_commands, SizeType first) {
+		VORTEX_ASSERT(first < draw_commands.size())
+		const auto& first_cmd = draw_commands[first];
+		auto view_layer = GetSortingKeyViewLayer(first_cmd.Key);
+		if (view_layer == ViewLayer::PostProcess) {
+			return 1;
+		}
+
+		// depth only decides the order, instances are drawn in the same order as separate draws would be
+		auto state_key = ClearDrawKeyDepth(first_cmd.Key);
+		auto last = first + 1;
+		for (; last < draw_commands.size(); ++last) {
+			const auto& cmd = draw_commands[last];
+			if (cmd.DrawHandle != first_cmd.DrawHandle
+				|| cmd.MeshHandle != first_cmd.MeshHandle
+				|| GetSortingKeyViewLayer(cmd.Key) != view_layer
+				|| ClearDrawKeyDepth(cmd.Key) != state_key) {
+				break;
+			}
+		}
+		return last - first;
+	}
+	bool Renderer::IsMultiDrawMaterial(Handle material_handle) const {
+		const auto& material = GetFrameMaterial(material_handle);
+		const auto& shader = m_DataMap.Get<Shader>(material.ShaderHandle);
+		return (shader.Tags & ShaderTags::MultiDraw) != 0;
+	}
+	void Renderer::BuildMultiDraws(const std::vector<DrawCommand>& draw_commands, MultiDrawList& multi_draws) const {
+		multi_draws.IndirectCommands.clear();
+		multi_draws.DrawData.clear();
+		multi_draws.Materials.clear();
+		multi_draws.Batches.clear();
+		multi_draws.MaterialIndices.clear();
+
+		// consecutive draws mostly share a material, only a change looks the table up
+		Handle indexed_material_handle{Map::NullHandle};
+		UInt32 material_index{0};
+
+		Handle current_material_handle{Map::NullHandle};
+		bool current_material_multi_draw{false};
+		for (SizeType i = 0; i < draw_commands.size();) {
+			const auto& cmd = draw_commands[i];
+			auto view_layer = GetSortingKeyViewLayer(cmd.Key);
+			if (view_layer == ViewLayer::PostProcess) {
+				++i;
+				continue;
+			}
+
+			Handle cmd_draw_surface_handle{Map::NullHandle};
+			Blending::Enum cmd_blending{Blending::Count};
+			Handle cmd_material_handle{Map::NullHandle};
+			GetDrawKeyData(cmd.Key, cmd_draw_surface_handle, cmd_blending, cmd_material_handle);
+			if (current_material_handle != cmd_material_handle) {
+				current_material_handle = cmd_material_handle;
+				current_material_multi_draw = IsMultiDrawMaterial(cmd_material_handle);
+			}
+
+			if (!current_material_multi_draw) {
+				++i;
+				continue;
+			}
+
+			auto shader_handle = GetFrameMaterial(cmd_material_handle).ShaderHandle;
+			const auto& first_mesh = m_DataMap.Get<Mesh>(cmd.MeshHandle);
+			VORTEX_ASSERT_MSG(first_mesh.PoolHandle != Map::NullHandle, "MultiDraw shaders only draw meshes created from a mesh pool.")
+
+			MultiDrawBatch batch{};
+			batch.FirstDraw = i;
+			batch.FirstIndirectCommand = multi_draws.IndirectCommands.size();
+			batch.MeshPoolHandle = first_mesh.PoolHandle;
+			auto first_index_offset = m_DataMap.Get<Buffer>(first_mesh.IndexBufferHandle).Offset / sizeof(UInt32);
+
+			for (; i < draw_commands.size(); ++i) {
+				const auto& batch_cmd = draw_commands[i];
+				if (batch_cmd.DrawHandle != cmd.DrawHandle || GetSortingKeyViewLayer(batch_cmd.Key) != view_layer) {
+					break;
+				}
+
+				Handle draw_surface_handle{Map::NullHandle};
+				Blending::Enum blending{Blending::Count};
+				Handle material_handle{Map::NullHandle};
+				GetDrawKeyData(batch_cmd.Key, draw_surface_handle, blending, material_handle);
+				if (draw_surface_handle != cmd_draw_surface_handle || blending != cmd_blending) {
+					break;
+				}
+
+				// material state set by a bind callback can not change inside one draw
+				if (material_handle != current_material_handle) {
+					const auto& material = GetFrameMaterial(material_handle);
+					const auto& current_material = GetFrameMaterial(current_material_handle);
+					if (material.ShaderHandle != shader_handle || material.OnBind != nullptr || current_material.OnBind != nullptr) {
+						break;
+					}
+					current_material_handle = material_handle;
+				}
+
+				const auto& mesh = m_DataMap.Get<Mesh>(batch_cmd.MeshHandle);
+				if (mesh.PoolHandle != batch.MeshPoolHandle) {
+					break;
+				}
+
+				if (i > batch.FirstDraw && batch_cmd.MeshHandle == draw_commands[i - 1].MeshHandle) {
+					++multi_draws.IndirectCommands.back().InstanceCount;
+				} else {
+					DrawIndirectCommand indirect_command{};
+					indirect_command.IndexCount = static_cast<UInt32>(mesh.IndexCount);
+					indirect_command.InstanceCount = 1;
+					indirect_command.FirstIndex = static_cast<UInt32>(first_index_offset + mesh.FirstIndex);
+					indirect_command.BaseVertex = static_cast<Int32>(mesh.BaseVertex);
+					indirect_command.BaseInstance = static_cast<UInt32>(multi_draws.DrawData.size());
+					multi_draws.IndirectCommands.push_back(indirect_command);
+				}
+
+				if (material_handle != indexed_material_handle) {
+					auto [it, inserted] = multi_draws.MaterialIndices.try_emplace(material_handle, static_cast<UInt32>(multi_draws.Materials.size()));
+					if (inserted) {
+						multi_draws.Materials.push_back(GetFrameMaterial(material_handle).Data);
+					}
+					indexed_material_handle = material_handle;
+					material_index = it->second;
+				}
+
+				MultiDrawData draw_data{};
+				draw_data.Transform = batch_cmd.TransformMatrix;
+				draw_data.MaterialIndex = material_index;
+				multi_draws.DrawData.push_back(draw_data);
+			}
+
+			batch.DrawCount = i - batch.FirstDraw;
+			batch.IndirectCommandCount = multi_draws.IndirectCommands.size() - batch.FirstIndirectCommand;
+			multi_draws.Batches.push_back(batch);
+		}
+	}
+	void Renderer::GatherInstanceTransforms(const std::vector<DrawCommand>& draw_commands, std::vector<Math::Matrix4>& transforms) const {
+		transforms.clear();
+
+		Handle current_material_handle{Map::NullHandle};
+		bool current_material_instanced{false};
+		for (SizeType i = 0; i < draw_commands.size();) {
+			const auto& cmd = draw_commands[i];
+			if (GetSortingKeyViewLayer(cmd.Key) == ViewLayer::PostProcess) {
+				++i;
+				continue;
+			}
+
+			Handle cmd_draw_surface_handle{Map::NullHandle};
+			Blending::Enum cmd_blending{Blending::Count};
+			Handle cmd_material_handle{Map::NullHandle};
+			GetDrawKeyData(cmd.Key, cmd_draw_surface_handle, cmd_blending, cmd_material_handle);
+			if (current_material_handle != cmd_material_handle) {
+				current_material_handle = cmd_material_handle;
+				current_material_instanced = IsInstancedMaterial(cmd_material_handle);
+			}
+
+			if (!current_material_instanced) {
+				++i;
+				continue;
+			}
+
+			auto run_length = GetInstanceRunLength(draw_commands, i);
+			for (auto end = i + run_length; i < end; ++i) {
+				transforms.push_back(draw_commands[i].TransformMatrix);
+			}
+		}
+	}
+
+	Renderer::DrawCommandStats Renderer::ProcessDrawCommands(const std::vector<DrawCommand>& draw_commands, const MultiDrawList& multi_draws, SizeType instance_count) {
+		DrawCommandStats stats{};
+
+		Handle current_draw_handle{Map::NullHandle};
+		const View* current_view{nullptr};
+		Math::Matrix4 current_view_matrix = Math::Matrix4::Identity();
+
+		Handle current_draw_surface_handle{Map::NullHandle};
+		ViewLayer::Enum current_view_layer{ViewLayer::Count};
+		Handle current_material_handle{Map::NullHandle};
+		Handle current_material_shader_handle{Map::NullHandle};
+		bool current_material_instanced{false};
+		bool current_material_multi_draw{false};
+		SizeType instance_offset{0};
+		SizeType multi_draw_batch{0};
+
+		for (SizeType i = 0; i < draw_commands.size();) {
+			const auto& cmd = draw_commands[i];
+			// - View
+			//		draw handle is either window or view
+			if (current_draw_handle != cmd.DrawHandle) {
+				current_draw_handle = cmd.DrawHandle;
+				++stats.ViewChanges;
+
+				auto view_handle = m_DataMap.Is<Window>(cmd.DrawHandle) ? m_DataMap.Get<Window>(cmd.DrawHandle).DefaultViewHandle : cmd.DrawHandle;
+				current_view = &GetFrameView(view_handle);
+				OnBindView(cmd.DrawHandle, *current_view);
+			}
+
+			// - ViewLayer
+			//		Set View Matrix
+			//		Apply PostProcess
+			ViewLayer::Enum cmd_view_layer{GetSortingKeyViewLayer(cmd.Key)};
+			if (current_view_layer != cmd_view_layer) {
+				current_view_layer = cmd_view_layer;
+
+				if (current_view_layer == ViewLayer::HUD) {
+					current_view_matrix = Math::Matrix4::Identity();
+				} else if (current_view_layer == ViewLayer::World) {
+					current_view_matrix = current_view->ViewMatrix;
+					current_view_matrix.Invert();
+				} else if (current_view_layer == ViewLayer::PostProcess) {
+					++i;
+					continue;
+				}
+			}
+
+			Handle cmd_draw_surface_handle{Map::NullHandle};
+			Blending::Enum cmd_blending{Blending::Count};
+			Handle cmd_material_handle{Map::NullHandle};
+			GetDrawKeyData(cmd.Key, cmd_draw_surface_handle, cmd_blending, cmd_material_handle);
+
+			// - DrawingSurface
+			//		Clear Color, Depth, Stencil
+			//		Set Draw area
+			if (current_draw_surface_handle != cmd_draw_surface_handle) {
+				current_draw_surface_handle = cmd_draw_surface_handle;
+				++stats.DrawSurfaceChanges;
+				OnBindDrawSurface(GetFrameDrawSurface(cmd_draw_surface_handle), *current_view);
+			}
+
+			// - Material
+			//		Set Blending
+			//		SetUniform: ViewMatrix
+			//		SetUniform: ProjectionMatrix
+			if (current_material_handle != cmd_material_handle) {
+				current_material_handle = cmd_material_handle;
+				++stats.MaterialChanges;
+
+				const auto& material = GetFrameMaterial(cmd_material_handle);
+				current_material_shader_handle = material.ShaderHandle;
+				current_material_instanced = IsInstancedMaterial(cmd_material_handle);
+				current_material_multi_draw = IsMultiDrawMaterial(cmd_material_handle);
+				OnBindMaterial(material, current_view_matrix, current_view->ProjectionMatrix);
+			}
+
+			// - Draw Mesh
+			//		MultiDraw: one indirect draw for the batch, transforms from the DrawData block
+			//		Instanced: one draw for the run, transforms from the instance buffer
+			//		Otherwise: SetUniform: ModelMatrix
+			VORTEX_ASSERT(d_MeshChecks(cmd.MeshHandle))
+			if (current_material_multi_draw) {
+				const auto& batch = multi_draws.Batches[multi_draw_batch++];
+				VORTEX_ASSERT(batch.FirstDraw == i)
+				OnDrawMultiDraw(batch);
+				i += batch.DrawCount;
+				stats.IndirectCommands += batch.IndirectCommandCount;
+				++stats.MultiDrawCalls;
+			} else if (current_material_instanced) {
+				auto run_length = GetInstanceRunLength(draw_commands, i);
+				OnDrawInstanced(cmd.MeshHandle, instance_offset, run_length);
+				instance_offset += run_length;
+				i += run_length;
+				++stats.InstancedDrawCalls;
+			} else {
+				OnDraw(cmd, current_material_shader_handle);
+				++i;
+			}
+			++stats.DrawCalls;
+		}
+		VORTEX_ASSERT(instance_offset == instance_count)
+		VORTEX_ASSERT(multi_draw_batch == multi_draws.Batches.size())
+
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer Draw Calls", stats.DrawCalls)
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer Instanced Draw Calls", stats.InstancedDrawCalls)
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer Multi Draw Calls", stats.MultiDrawCalls)
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer State Changes", stats.ViewChanges + stats.DrawSurfaceChanges + stats.MaterialChanges)
+		return stats;
+	}
+
+	void Renderer::BuildShaderUniforms(Shader& shader, const std::vector<ShaderUniform>& uniforms) {
+		for (auto& constant_uniform : shader.ConstantUniforms) {
+			constant_uniform = ShaderUniform{};
+		}
+
+		SizeType slot_count = 1;
+		while (slot_count < uniforms.size() * 2) {
+			slot_count *= 2;
+		}
+		shader.Uniforms.assign(slot_count, ShaderUniform{});
+
+		auto slot_mask = slot_count - 1;
+		for (const auto& uniform : uniforms) {
+			VORTEX_ASSERT(uniform.Location != -1)
+
+			auto slot = static_cast<SizeType>(uniform.Name.Get()) & slot_mask;
+			while (shader.Uniforms[slot].Location != -1 && !(shader.Uniforms[slot].Name == uniform.Name)) {
+				slot = (slot + 1) & slot_mask;
+			}
+			// a repeated name keeps its first entry
+			if (shader.Uniforms[slot].Location != -1) {
+				continue;
+			}
+			shader.Uniforms[slot] = uniform;
+
+			for (SizeType i = 0; i < ShaderConstants::Count; ++i) {
+				if (uniform.Name == ShaderConstants::ToHashedString[i]) {
+					if (uniform.Type == ShaderConstants::Type[i]) {
+						shader.ConstantUniforms[i] = uniform;
+					} else {
+						Console::WriteWarning("[Renderer] Shader uniform %s is not a %s, the renderer does not set it.", ShaderConstants::ToString[i], ElementType::ToString[ShaderConstants::Type[i]]);
+					}
+					break;
+				}
+			}
+		}
+	}
+	const ShaderUniform* Renderer::FindShaderUniform(const Shader& shader, HashedString name) {
+		if (shader.Uniforms.empty()) {
+			return nullptr;
+		}
+
+		// at most half full, so probing always ends on an unused slot
+		auto slot_mask = shader.Uniforms.size() - 1;
+		for (auto slot = static_cast<SizeType>(name.Get()) & slot_mask;; slot = (slot + 1) & slot_mask) {
+			const auto& uniform = shader.Uniforms[slot];
+			if (uniform.Location == -1) {
+				return nullptr;
+			}
+			if (uniform.Name == name) {
+				return &uniform;
+			}
+		}
+	}
+
+	Renderer::SubmitContext& Renderer::GetSubmitContext() {
+		// keyed by instance id and not by address, a new renderer may reuse a destroyed one's address
+		struct CachedContext {
+			SizeType InstanceID;
+			SubmitContext* Context;
+		};
+		thread_local CachedContext cached_context{0, nullptr};
+
+		if (cached_context.InstanceID != m_InstanceID) {
+			std::lock_guard<std::mutex> lock{m_SubmitContextMutex};
+			auto thread_id = std::this_thread::get_id();
+			auto it = std::find_if(m_SubmitContexts.begin(), m_SubmitContexts.end(), [thread_id](const auto& context) {
+				return context->m_ThreadID == thread_id;
+			});
+
+			// a thread switching between renderers finds its context again
+			if (it == m_SubmitContexts.end()) {
+				m_SubmitContexts.push_back(std::make_unique<SubmitContext>(*this));
+				m_SubmitContexts.back()->m_ThreadID = thread_id;
+				it = std::prev(m_SubmitContexts.end());
+			}
+			cached_context = CachedContext{m_InstanceID, it->get()};
+		}
+		return *cached_context.Context;
+	}
+
+	void Renderer::MergeSubmitContexts() {
+		std::lock_guard<std::mutex> lock{m_SubmitContextMutex};
+		for (auto& context : m_SubmitContexts) {
+			m_DrawCommands.insert(m_DrawCommands.end(), context->m_DrawCommands.begin(), context->m_DrawCommands.end());
+			context->m_DrawCommands.clear();
+		}
+	}
+
+	void Renderer::NextFrame() {
+		BeginFrame();
+		MergeSubmitContexts();
+
+		if (!IsPipelined()) {
+			ExecuteFrame(m_DrawCommands, m_ComputeCommands);
+			m_DrawCommands.clear();
+			m_ComputeCommands.clear();
+			return;
+		}
+
+		if (!m_ContextOnRenderThread) {
+			ReleaseContext();
+			m_ContextOnRenderThread = true;
+		}
+		// copied before waiting for the slot, views, draw surfaces and materials may change while the frame executes
+		CaptureFrameState(m_DrawCommands, m_CapturedFrameState);
+
+		std::unique_lock<std::mutex> lock{m_FrameMutex};
+		m_FrameExecuted.wait(lock, [this] { return m_SubmittedFrameCount - m_ExecutedFrameCount < m_FramesInFlight; });
+
+		// the slot was executed and cleared, swapping keeps both capacities so recording does not allocate
+		auto& frame = m_InFlightFrames[m_SubmittedFrameCount % m_FramesInFlight];
+		frame.DrawCommands.swap(m_DrawCommands);
+		frame.ComputeCommands.swap(m_ComputeCommands);
+		std::swap(frame.State, m_CapturedFrameState);
+		++m_SubmittedFrameCount;
+
+		lock.unlock();
+		m_FrameSubmitted.notify_one();
+	}
+
+	void Renderer::CaptureFrameState(const std::vector<DrawCommand>& draw_commands, FrameState& state) {
+		state.ViewHandles.clear();
+		state.DrawSurfaceHandles.clear();
+		state.MaterialHandles.clear();
+
+		// every command is visited, the mask keeps the handle lists at the few distinct handles of the frame
+		constexpr static SizeType handle_range = SizeType{std::numeric_limits<Handle>::max()} + 1;
+		if (m_CapturedHandles.empty()) {
+			m_CapturedHandles.resize(handle_range);
+		}
+		state.Indices.resize(handle_range);
+		auto capture = [this, &state](std::vector<Handle>& handles, Handle handle) {
+			if (!m_CapturedHandles[handle]) {
+				m_CapturedHandles[handle] = true;
+				state.Indices[handle] = static_cast<UInt16>(handles.size());
+				handles.push_back(handle);
+			}
+		};
+
+		Handle current_draw_handle{Map::NullHandle};
+		for (const auto& cmd : draw_commands) {
+			if (current_draw_handle != cmd.DrawHandle) {
+				current_draw_handle = cmd.DrawHandle;
+				capture(state.ViewHandles, m_DataMap.Is<Window>(cmd.DrawHandle) ? m_DataMap.Get<Window>(cmd.DrawHandle).DefaultViewHandle : cmd.DrawHandle);
+			}
+			if (GetSortingKeyViewLayer(cmd.Key) == ViewLayer::PostProcess) {
+				continue;
+			}
+
+			Handle cmd_draw_surface_handle{Map::NullHandle};
+			Blending::Enum cmd_blending{Blending::Count};
+			Handle cmd_material_handle{Map::NullHandle};
+			GetDrawKeyData(cmd.Key, cmd_draw_surface_handle, cmd_blending, cmd_material_handle);
+			capture(state.DrawSurfaceHandles, cmd_draw_surface_handle);
+			capture(state.MaterialHandles, cmd_material_handle);
+		}
+
+		state.Views.clear();
+		for (auto view_handle : state.ViewHandles) {
+			m_CapturedHandles[view_handle] = false;
+			state.Views.push_back(m_DataMap.Get<View>(view_handle));
+		}
+		state.DrawSurfaces.clear();
+		for (auto draw_surface_handle : state.DrawSurfaceHandles) {
+			m_CapturedHandles[draw_surface_handle] = false;
+			state.DrawSurfaces.push_back(m_DataMap.Get<DrawSurface>(draw_surface_handle));
+		}
+		state.Materials.clear();
+		for (auto material_handle : state.MaterialHandles) {
+			m_CapturedHandles[material_handle] = false;
+			state.Materials.push_back(m_DataMap.Get<Material>(material_handle));
+		}
+	}
+	const View& Renderer::GetFrameView(Handle view_handle) const {
+		if (m_ExecutingFrameState == nullptr) {
+			return m_DataMap.Get<View>(view_handle);
+		}
+		return FindFrameState(*m_ExecutingFrameState, m_ExecutingFrameState->ViewHandles, m_ExecutingFrameState->Views, view_handle);
+	}
+	const DrawSurface& Renderer::GetFrameDrawSurface(Handle draw_surface_handle) const {
+		if (m_ExecutingFrameState == nullptr) {
+			return m_DataMap.Get<DrawSurface>(draw_surface_handle);
+		}
+		return FindFrameState(*m_ExecutingFrameState, m_ExecutingFrameState->DrawSurfaceHandles, m_ExecutingFrameState->DrawSurfaces, draw_surface_handle);
+	}
+	const Material& Renderer::GetFrameMaterial(Handle material_handle) const {
+		if (m_ExecutingFrameState == nullptr) {
+			return m_DataMap.Get<Material>(material_handle);
+		}
+		return FindFrameState(*m_ExecutingFrameState, m_ExecutingFrameState->MaterialHandles, m_ExecutingFrameState->Materials, material_handle);
+	}
+
+	void Renderer::SetFramesInFlight(SizeType frames_in_flight) {
+		if (frames_in_flight == m_FramesInFlight) {
+			return;
+		}
+
+		if (m_RenderThread.joinable()) {
+			WaitIdle();
+			{
+				std::lock_guard<std::mutex> lock{m_FrameMutex};
+				m_StopRenderThread = true;
+			}
+			m_FrameSubmitted.notify_one();
+			m_RenderThread.join();
+		}
+
+		m_FramesInFlight = frames_in_flight;
+		m_InFlightFrames.clear();
+		m_InFlightFrames.resize(frames_in_flight);
+		m_SubmittedFrameCount = 0;
+		m_ExecutedFrameCount = 0;
+		m_StopRenderThread = false;
+
+		if (frames_in_flight > 0) {
+			m_RenderThread = std::thread{&Renderer::RenderThreadLoop, this};
+		}
+	}
+
+	void Renderer::WaitIdle() {
+		if (m_RenderThread.joinable()) {
+			std::unique_lock<std::mutex> lock{m_FrameMutex};
+			m_FrameExecuted.wait(lock, [this] { return m_ExecutedFrameCount == m_SubmittedFrameCount; });
+		}
+
+		if (m_ContextOnRenderThread) {
+			AcquireContext();
+			m_ContextOnRenderThread = false;
+		}
+	}
+
+	void Renderer::Subscribe(EventBus& event_bus) {
+		Unsubscribe();
+		m_EventBus = &event_bus;
+		m_WindowResizeSubscription = event_bus.Subscribe<&Renderer::OnWindowResize>(EventType::WindowResize, this);
+	}
+
+	void Renderer::Unsubscribe() {
+		if (m_EventBus != nullptr) {
+			m_EventBus->Unsubscribe(m_WindowResizeSubscription);
+			m_EventBus = nullptr;
+		}
+	}
+
+	void Renderer::OnWindowResize(const Event& event) {
+		if (!m_DataMap.Is<Window>(event.WindowResize.Handle)) {
+			return;
+		}
+
+		auto& window = m_DataMap.Get<Window>(event.WindowResize.Handle);
+		window.Resolution.Width = event.WindowResize.Size.x;
+		window.Resolution.Height = event.WindowResize.Size.y;
+
+		auto& view = m_DataMap.Get<View>(window.DefaultViewHandle);
+		view.ProjectionMatrix.SetOrthographic(
+			0.0f,
+			static_cast<float>(event.WindowResize.Size.x),
+			static_cast<float>(event.WindowResize.Size.y),
+			0.0f,
+			-1000.0f,
+			1000.0f
+		);
+		view.Viewport.width = event.WindowResize.Size.x;
+		view.Viewport.height = event.WindowResize.Size.y;
+	}
+
+	void Renderer::RenderThreadLoop() {
+		VORTEX_DEBUG_PROFILER_THREAD("Render")
+
+		std::unique_lock<std::mutex> lock{m_FrameMutex};
+		while (true) {
+			m_FrameSubmitted.wait(lock, [this] { return m_StopRenderThread || m_ExecutedFrameCount != m_SubmittedFrameCount; });
+			if (m_ExecutedFrameCount == m_SubmittedFrameCount) {
+				break; // stopped, WaitIdle drained every frame before
+			}
+
+			auto& frame = m_InFlightFrames[m_ExecutedFrameCount % m_FramesInFlight];
+			lock.unlock();
+
+			// the context is only held while executing, WaitIdle can hand it back to the calling thread
+			AcquireContext();
+			m_ExecutingFrameState = &frame.State;
+			ExecuteFrame(frame.DrawCommands, frame.ComputeCommands);
+			m_ExecutingFrameState = nullptr;
+			ReleaseContext();
+			frame.DrawCommands.clear();
+			frame.ComputeCommands.clear();
+
+			lock.lock();
+			++m_ExecutedFrameCount;
+			m_FrameExecuted.notify_one();
+		}
+	}
+}
@@ -0,0 +1,484 @@
+#include <cstring>
+
+#include "NullRenderer.h"
+
+#include "Vortex/Debug/Profiler.h"
+
+namespace Vortex::Graphics {
+	NullRenderer::~NullRenderer() {
+		SetFramesInFlight(0);
+	}
+
+	Handle NullRenderer::CreateWindow(const Resolution& resolution, const char* title) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateWindow called while frames are in flight, call WaitIdle first.")
+		Window window{};
+		window.Title.assign(title);
+		window.Resolution = resolution;
+
+		View default_view{};
+		default_view.FramebufferHandle = Map::NullHandle;
+		default_view.Viewport.x = 0;
+		default_view.Viewport.y = 0;
+		default_view.Viewport.width = resolution.Width;
+		default_view.Viewport.height = resolution.Height;
+		default_view.ProjectionMatrix.SetOrthographic(
+			0.0f,
+			static_cast<float>(resolution.Width),
+			static_cast<float>(resolution.Height),
+			0.0f,
+			-1000.0f,
+			1000.0f
+		);
+		default_view.ViewMatrix = Math::Matrix4::Identity();
+		default_view.DepthTest = DepthTesting::Disabled;
+		window.DefaultViewHandle = m_DataMap.Insert<View>(default_view);
+
+		return m_DataMap.Insert<Window>(window);
+	}
+	void NullRenderer::DestroyWindow(Handle window_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyWindow called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_WindowChecks(window_handle))
+
+		const auto& window = m_DataMap.Get<Window>(window_handle);
+		m_DataMap.Destroy(window.DefaultViewHandle);
+		m_DataMap.Destroy(window_handle);
+	}
+	void NullRenderer::SetWindowResolution(Handle window_handle, const Resolution& resolution) {
+		VORTEX_ASSERT(d_WindowChecks(window_handle))
+		m_DataMap.Get<Window>(window_handle).Resolution = resolution;
+	}
+	void NullRenderer::SetWindowTitle(Handle window_handle, const char* title) {
+		VORTEX_ASSERT(d_WindowChecks(window_handle))
+		m_DataMap.Get<Window>(window_handle).Title.assign(title);
+	}
+
+	Handle NullRenderer::CreateBuffer(BufferUsage::Enum buffer_usage, const BufferLayout& buffer_layout, SizeType count, const void* data) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateBuffer called while frames are in flight, call WaitIdle first.")
+		Buffer buffer{};
+		buffer.BufferUsage = buffer_usage;
+		buffer.Layout = buffer_layout;
+		buffer.Mutable = true;
+		buffer.Size = count * buffer_layout.Stride;
+
+		if (data != nullptr) {
+			m_FrameStats.UploadedBytes += buffer.Size;
+		}
+		return m_DataMap.Insert<Buffer>(buffer);
+	}
+	void NullRenderer::UpdateBuffer(Handle buffer_handle, [[maybe_unused]] SizeType offset, SizeType data_size, const void* /*data*/) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] UpdateBuffer called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_BufferChecks(buffer_handle))
+
+		[[maybe_unused]] const auto& buffer = m_DataMap.Get<Buffer>(buffer_handle);
+		VORTEX_ASSERT(buffer.Mutable)
+		VORTEX_ASSERT(offset + data_size <= buffer.Size)
+
+		m_FrameStats.UploadedBytes += data_size;
+	}
+	void NullRenderer::GetBuffer(Handle buffer_handle, [[maybe_unused]] SizeType offset, SizeType data_size, void* data) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] GetBuffer called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_BufferChecks(buffer_handle))
+
+		[[maybe_unused]] const auto& buffer = m_DataMap.Get<Buffer>(buffer_handle);
+		VORTEX_ASSERT(buffer.Mutable)
+		VORTEX_ASSERT(offset + data_size <= buffer.Size)
+
+		// contents are not kept
+		std::memset(data, 0, data_size);
+	}
+	void NullRenderer::DestroyBuffer(Handle buffer_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyBuffer called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_BufferChecks(buffer_handle))
+		m_DataMap.Destroy(buffer_handle);
+	}
+
+	Handle NullRenderer::CreateTexture2D(
+		const Vector2HalfInt& size,
+		PixelFormat::Enum format,
+		const void* pixels,
+		TextureLODFilter::Enum min_filter,
+		TextureLODFilter::Enum mag_filter,
+		TextureWrap::Enum wrap_s,
+		TextureWrap::Enum wrap_t,
+		bool create_mipmap
+	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateTexture2D called while frames are in flight, call WaitIdle first.")
+		Texture texture{};
+		texture.PixelFormat = format;
+		texture.MinificationFilter = min_filter;
+		texture.MagnificationFilter = mag_filter;
+		texture.WrapS = wrap_s;
+		texture.WrapT = wrap_t;
+		texture.WrapR = TextureWrap::Count;
+		texture.Size.x = size.x;
+		texture.Size.y = size.y;
+		texture.Size.z = 1;
+		texture.LayerCount = 1;
+		texture.BitsPerPixel = PixelFormat::BitsPerPixel[format];
+		texture.IsCubemap = false;
+		texture.Mipmapped = create_mipmap;
+		texture.DataSize = size.x * size.y * texture.BitsPerPixel;
+
+		if (pixels != nullptr) {
+			m_FrameStats.UploadedBytes += texture.DataSize;
+		}
+		return m_DataMap.Insert<Texture>(texture);
+	}
+	void NullRenderer::UpdateTexture2D(Handle texture_handle, [[maybe_unused]] const void* pixels) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] UpdateTexture2D called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_TextureChecks(texture_handle))
+		VORTEX_ASSERT(pixels != nullptr)
+
+		m_FrameStats.UploadedBytes += m_DataMap.Get<Texture>(texture_handle).DataSize;
+	}
+	void NullRenderer::GetTexture([[maybe_unused]] Handle texture_handle, UInt16 buffer_size, void* pixels) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] GetTexture called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_TextureChecks(texture_handle))
+		VORTEX_ASSERT(pixels != nullptr)
+
+		// contents are not kept
+		std::memset(pixels, 0, buffer_size);
+	}
+	void NullRenderer::DestroyTexture(Handle texture_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyTexture called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_TextureChecks(texture_handle))
+		m_DataMap.Destroy(texture_handle);
+	}
+
+	Handle NullRenderer::CreateShader(const char** /*sources*/, ShaderType::Enum* /*types*/, SizeType /*count*/, ShaderTags::Enum tags) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateShader called while frames are in flight, call WaitIdle first.")
+		// sources are not compiled, uniform locations stay unknown
+		Shader shader{};
+		shader.Tags = tags;
+		return m_DataMap.Insert<Shader>(shader);
+	}
+	bool NullRenderer::ReloadShader([[maybe_unused]] Handle shader_handle, const char** /*sources*/, ShaderType::Enum* /*types*/, SizeType /*count*/) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] ReloadShader called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_ShaderChecks(shader_handle))
+		return true;
+	}
+	void NullRenderer::SetUniform([[maybe_unused]] Handle shader_handle, HashedString /*name*/, const void* /*data*/, SizeType /*count*/) const {
+		VORTEX_ASSERT(d_ShaderChecks(shader_handle))
+		++m_FrameStats.UniformUploads;
+	}
+	void NullRenderer::DestroyShader(Handle shader_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyShader called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_ShaderChecks(shader_handle))
+		m_DataMap.Destroy(shader_handle);
+	}
+
+	Handle NullRenderer::CreateFrameBuffer(
+		const Vector2HalfInt& size,
+		const PixelFormat::Enum* attachment_formats,
+		SizeType count
+	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateFrameBuffer called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(attachment_formats != nullptr)
+		VORTEX_ASSERT(count > 0)
+
+		FrameBuffer frame_buffer{};
+		frame_buffer.Size = size;
+		for (SizeType i = 0; i < count; ++i) {
+			frame_buffer.TextureHandles.emplace_back(CreateTexture2D(
+				size,
+				attachment_formats[i],
+				nullptr,
+				TextureLODFilter::Linear,
+				TextureLODFilter::Linear,
+				TextureWrap::ClampEdge,
+				TextureWrap::ClampEdge,
+				true
+			));
+		}
+		return m_DataMap.Insert<FrameBuffer>(frame_buffer);
+	}
+	void NullRenderer::DestroyFrameBuffer(Handle framebuffer_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyFrameBuffer called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_FrameBufferChecks(framebuffer_handle))
+
+		const auto& framebuffer = m_DataMap.Get<FrameBuffer>(framebuffer_handle);
+		for (auto texture_handle : framebuffer.TextureHandles) {
+			DestroyTexture(texture_handle);
+		}
+		m_DataMap.Destroy(framebuffer_handle);
+	}
+
+	Handle NullRenderer::CreateComputeShader(const char* source, OnComputeShaderBindFn on_compute_shader_bind) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateComputeShader called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(on_compute_shader_bind != nullptr)
+		ShaderType::Enum type{ShaderType::Compute};
+
+		ComputeShader compute_shader{};
+		compute_shader.ShaderHandle = CreateShader(&source, &type, 1, ShaderTags::Undefined);
+		compute_shader.OnBind = on_compute_shader_bind;
+		return m_DataMap.Insert<ComputeShader>(compute_shader);
+	}
+	void NullRenderer::DestroyComputeShader(Handle compute_shader_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyComputeShader called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_ComputeShaderChecks(compute_shader_handle))
+
+		const auto& compute_shader = m_DataMap.Get<ComputeShader>(compute_shader_handle);
+		DestroyShader(compute_shader.ShaderHandle);
+		m_DataMap.Destroy(compute_shader_handle);
+	}
+
+	Handle NullRenderer::CreateMesh(
+		Topology::Enum topology,
+		BufferUsage::Enum usage,
+		const MeshLayout& layout,
+		SizeType vertex_capacity,
+		SizeType index_capacity
+	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateMesh called while frames are in flight, call WaitIdle first.")
+		Mesh mesh{};
+		mesh.IndexBufferHandle = CreateBuffer(usage, CreateBufferLayout(ElementType::UInt1), index_capacity, nullptr);
+		mesh.IndexCount = 0;
+		mesh.IndexCapacity = index_capacity;
+		mesh.Topology = topology;
+
+		for (SizeType i = 0; i < layout.Count; ++i) {
+			mesh.BufferHandles.emplace_back(CreateBuffer(usage, layout.BufferLayouts[i], vertex_capacity, nullptr));
+#ifdef VORTEX_DEBUG
+			mesh.d_BufferSizes.emplace_back(layout.BufferLayouts[i].Stride * vertex_capacity);
+#endif
+		}
+		return m_DataMap.Insert<Mesh>(mesh);
+	}
+	void NullRenderer::SetMeshIndexCount(Handle mesh_handle, SizeType count) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] SetMeshIndexCount called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
+		auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
+
+		VORTEX_ASSERT(count <= mesh.IndexCapacity)
+		mesh.IndexCount = count;
+	}
+	void NullRenderer::SetMeshIndices(Handle mesh_handle, const UInt32* data, SizeType count) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] SetMeshIndices called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
+		VORTEX_ASSERT(data != nullptr)
+		auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
+		VORTEX_ASSERT(count <= mesh.IndexCapacity)
+
+		UpdateBuffer(mesh.IndexBufferHandle, mesh.FirstIndex * sizeof(UInt32), count * sizeof(UInt32), data);
+		mesh.IndexCount = count;
+	}
+	void NullRenderer::SetMeshData(Handle mesh_handle, SizeType index, const void* data, SizeType size) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] SetMeshData called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
+		VORTEX_ASSERT(data != nullptr)
+		const auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
+
+		VORTEX_ASSERT(index < mesh.BufferHandles.size())
+		auto buffer_handle = mesh.BufferHandles[index];
+		UpdateBuffer(buffer_handle, mesh.BaseVertex * m_DataMap.Get<Buffer>(buffer_handle).Layout.Stride, size, data);
+	}
+	void NullRenderer::DestroyMesh(Handle mesh_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyMesh called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
+		const auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
+
+		// pooled meshes only release their handle, the buffers belong to the pool
+		if (mesh.PoolHandle == Map::NullHandle) {
+			for (auto buffer_handle : mesh.BufferHandles) {
+				DestroyBuffer(buffer_handle);
+			}
+			DestroyBuffer(mesh.IndexBufferHandle);
+		}
+		m_DataMap.Destroy(mesh_handle);
+	}
+	Handle NullRenderer::CreateMeshPool(
+		Topology::Enum topology,
+		BufferUsage::Enum usage,
+		const MeshLayout& layout,
+		SizeType vertex_capacity,
+		SizeType index_capacity
+	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateMeshPool called while frames are in flight, call WaitIdle first.")
+		MeshPool mesh_pool{};
+		mesh_pool.IndexBufferHandle = CreateBuffer(usage, CreateBufferLayout(ElementType::UInt1), index_capacity, nullptr);
+		mesh_pool.VertexCapacity = vertex_capacity;
+		mesh_pool.IndexCapacity = index_capacity;
+		mesh_pool.VertexCount = 0;
+		mesh_pool.IndexCount = 0;
+		mesh_pool.Topology = topology;
+
+		for (SizeType i = 0; i < layout.Count; ++i) {
+			mesh_pool.BufferHandles.emplace_back(CreateBuffer(usage, layout.BufferLayouts[i], vertex_capacity, nullptr));
+		}
+		return m_DataMap.Insert<MeshPool>(mesh_pool);
+	}
+	void NullRenderer::DestroyMeshPool(Handle mesh_pool_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyMeshPool called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MeshPoolChecks(mesh_pool_handle))
+		const auto& mesh_pool = m_DataMap.Get<MeshPool>(mesh_pool_handle);
+
+		for (auto buffer_handle : mesh_pool.BufferHandles) {
+			DestroyBuffer(buffer_handle);
+		}
+		DestroyBuffer(mesh_pool.IndexBufferHandle);
+		m_DataMap.Destroy(mesh_pool_handle);
+	}
+
+	Handle NullRenderer::CreateMaterial(Handle shader_handle, Blending::Enum blending, OnMaterialBindFn on_material_bind) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateMaterial called while frames are in flight, call WaitIdle first.")
+		Material material{};
+		material.ShaderHandle = shader_handle;
+		material.Blending = blending;
+		material.OnBind = on_material_bind;
+		return m_DataMap.Insert<Material>(material);
+	}
+	void NullRenderer::DestroyMaterial(Handle material_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyMaterial called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MaterialChecks(material_handle))
+		m_DataMap.Destroy(material_handle);
+	}
+
+	Handle NullRenderer::CreateView(
+		const Math::RectangleInt& viewport,
+		const Math::Matrix4& projection_matrix,
+		const Math::Matrix4& view_matrix,
+		DepthTesting::Enum depth_test,
+		Handle framebuffer_handle
+	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateView called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_FrameBufferChecks(framebuffer_handle))
+		View view{};
+		view.ProjectionMatrix = projection_matrix;
+		view.ViewMatrix = view_matrix;
+		view.FramebufferHandle = framebuffer_handle;
+		view.DepthTest = depth_test;
+		view.Viewport = viewport;
+		return m_DataMap.Insert<View>(view);
+	}
+	void NullRenderer::DestroyView(Handle view_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyView called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_ViewChecks(view_handle))
+		const auto& view = m_DataMap.Get<View>(view_handle);
+
+		DestroyFrameBuffer(view.FramebufferHandle);
+		m_DataMap.Destroy(view_handle);
+	}
+
+	Handle NullRenderer::CreateDrawSurface(
+		const Math::RectangleInt& area,
+		const Math::Color& clear_color,
+		float clear_depth,
+		Int32 clear_stencil
+	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateDrawSurface called while frames are in flight, call WaitIdle first.")
+		DrawSurface surface{};
+		surface.Area = area;
+		surface.ClearColor = clear_color;
+		surface.ClearDepth = clear_depth;
+		surface.ClearStencil = clear_stencil;
+		return m_DataMap.Insert<DrawSurface>(surface);
+	}
+	void NullRenderer::DestroyDrawSurface(Handle draw_surface_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyDrawSurface called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_DrawSurfaceChecks(draw_surface_handle))
+		m_DataMap.Destroy(draw_surface_handle);
+	}
+
+	void NullRenderer::ResetStats() {
+		m_FrameStats = FrameStats{};
+		m_LastFrameStats = FrameStats{};
+		m_TotalStats = FrameStats{};
+		m_FrameCount = 0;
+	}
+
+	void NullRenderer::ExecuteFrame(std::vector<DrawCommand>& draw_commands, std::vector<ComputeCommand>& compute_commands) {
+		// handles may have been destroyed and reused since the last frame
+		m_StateCache.Invalidate();
+		m_StateCache.ResetCounters();
+
+		if (!compute_commands.empty()) {
+			ProcessComputeCommands(compute_commands);
+		}
+		if (!draw_commands.empty()) {
+			SortDrawCommands(draw_commands);
+			VORTEX_ASSERT(d_DrawCommandChecks(draw_commands))
+			GatherInstanceTransforms(draw_commands, m_InstanceTransforms);
+			BuildMultiDraws(draw_commands, m_MultiDraws);
+			m_FrameStats.UploadedBytes += m_InstanceTransforms.size() * sizeof(Math::Matrix4);
+			m_FrameStats.UploadedBytes += m_MultiDraws.IndirectCommands.size() * sizeof(DrawIndirectCommand);
+			m_FrameStats.UploadedBytes += m_MultiDraws.DrawData.size() * sizeof(MultiDrawData);
+			m_FrameStats.UploadedBytes += m_MultiDraws.Materials.size() * sizeof(MaterialData);
+
+			auto stats = ProcessDrawCommands(draw_commands, m_MultiDraws, m_InstanceTransforms.size());
+			m_FrameStats.SubmittedDraws += draw_commands.size();
+			m_FrameStats.DrawCalls += stats.DrawCalls;
+			m_FrameStats.InstancedDrawCalls += stats.InstancedDrawCalls;
+			m_FrameStats.MultiDrawCalls += stats.MultiDrawCalls;
+			m_FrameStats.IndirectCommands += stats.IndirectCommands;
+			m_FrameStats.StateChanges += stats.ViewChanges + stats.DrawSurfaceChanges + stats.MaterialChanges;
+			m_FrameStats.ViewChanges += stats.ViewChanges;
+			m_FrameStats.DrawSurfaceChanges += stats.DrawSurfaceChanges;
+			m_FrameStats.MaterialChanges += stats.MaterialChanges;
+		}
+		m_FrameStats.StateCallsIssued += m_StateCache.GetCounters().Issued;
+		m_FrameStats.StateCallsFiltered += m_StateCache.GetCounters().Filtered;
+
+		m_LastFrameStats = m_FrameStats;
+		m_TotalStats.SubmittedDraws += m_FrameStats.SubmittedDraws;
+		m_TotalStats.DrawCalls += m_FrameStats.DrawCalls;
+		m_TotalStats.InstancedDrawCalls += m_FrameStats.InstancedDrawCalls;
+		m_TotalStats.MultiDrawCalls += m_FrameStats.MultiDrawCalls;
+		m_TotalStats.IndirectCommands += m_FrameStats.IndirectCommands;
+		m_TotalStats.StateChanges += m_FrameStats.StateChanges;
+		m_TotalStats.ViewChanges += m_FrameStats.ViewChanges;
+		m_TotalStats.DrawSurfaceChanges += m_FrameStats.DrawSurfaceChanges;
+		m_TotalStats.MaterialChanges += m_FrameStats.MaterialChanges;
+		m_TotalStats.StateCallsIssued += m_FrameStats.StateCallsIssued;
+		m_TotalStats.StateCallsFiltered += m_FrameStats.StateCallsFiltered;
+		m_TotalStats.ShaderBinds += m_FrameStats.ShaderBinds;
+		m_TotalStats.UniformUploads += m_FrameStats.UniformUploads;
+		m_TotalStats.ComputeDispatches += m_FrameStats.ComputeDispatches;
+		m_TotalStats.UploadedBytes += m_FrameStats.UploadedBytes;
+		m_FrameStats = FrameStats{};
+		++m_FrameCount;
+
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer State Calls Issued", m_LastFrameStats.StateCallsIssued)
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer State Calls Filtered", m_LastFrameStats.StateCallsFiltered)
+	}
+	void NullRenderer::ProcessComputeCommands(const std::vector<ComputeCommand>& compute_commands) {
+		for (const auto& cmd : compute_commands) {
+			const auto& compute_shader = m_DataMap.Get<ComputeShader>(cmd.ComputeShaderHandle);
+			++m_FrameStats.ShaderBinds;
+
+			if (compute_shader.OnBind != nullptr) {
+				compute_shader.OnBind(*this, compute_shader);
+			}
+			++m_FrameStats.ComputeDispatches;
+		}
+	}
+	void NullRenderer::OnBindView(Handle /*draw_handle*/, const View& view) {
+		// handles stand in for the API names
+		SetViewState(m_StateCache, view, view.FramebufferHandle);
+	}
+	void NullRenderer::OnBindDrawSurface(const DrawSurface& draw_surface, const View& view) {
+		SetDrawSurfaceState(m_StateCache, draw_surface, view);
+	}
+	void NullRenderer::OnBindMaterial(const Material& material, const Math::Matrix4& view_matrix, const Math::Matrix4& projection_matrix) {
+		SetMaterialState(m_StateCache, material);
+		if (m_StateCache.UseProgram(material.ShaderHandle)) {
+			++m_FrameStats.ShaderBinds;
+		}
+
+		SetUniform(material.ShaderHandle, ShaderConstants::ToHashedString[ShaderConstants::View], view_matrix.Data, 1);
+		SetUniform(material.ShaderHandle, ShaderConstants::ToHashedString[ShaderConstants::Projection], projection_matrix.Data, 1);
+
+		if (material.OnBind != nullptr) {
+			material.OnBind(*this, material);
+		}
+	}
+	void NullRenderer::OnDraw(const DrawCommand& draw_command, Handle shader_handle) {
+		SetUniform(shader_handle, ShaderConstants::ToHashedString[ShaderConstants::Transform], draw_command.TransformMatrix.Data, 1);
+		m_StateCache.BindVertexArray(draw_command.MeshHandle);
+	}
+	void NullRenderer::OnDrawInstanced(Handle mesh_handle, SizeType /*first_instance*/, SizeType /*instance_count*/) {
+		m_StateCache.BindVertexArray(mesh_handle);
+	}
+	void NullRenderer::OnDrawMultiDraw(const MultiDrawBatch& batch) {
+		m_StateCache.BindVertexArray(batch.MeshPoolHandle);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+#include "Vortex/Graphics/Renderer.h"
+#include "Vortex/Graphics/RenderStateCache.h"
+
+namespace Vortex::Graphics {
+	//	Renderer without a graphics API. Resources only live in m_DataMap and frames run the real sort, the shared
+	//	draw command walk and state filtering, but instead of issuing API calls the state changes and draw calls are counted.
+	//	Lets submission, sorting and batching run headless (build servers, benchmarks).
+	class NullRenderer: public Renderer {
+	public:
+		struct FrameStats {
+			SizeType SubmittedDraws; // draw commands, DrawCalls is lower by the draws merged into instanced draws
+			SizeType DrawCalls;
+			SizeType InstancedDrawCalls;
+			SizeType MultiDrawCalls;
+			SizeType IndirectCommands;
+			SizeType StateChanges; // view + draw surface + material changes
+			SizeType ViewChanges;
+			SizeType DrawSurfaceChanges;
+			SizeType MaterialChanges;
+			SizeType StateCallsIssued; // RenderStateCache setter calls that changed the shadowed state
+			SizeType StateCallsFiltered;
+			SizeType ShaderBinds;
+			SizeType UniformUploads;
+			SizeType ComputeDispatches;
+			SizeType UploadedBytes;
+		};
+
+	public:
+		NullRenderer() = default;
+		~NullRenderer() override;
+
+	public:
+		Handle CreateWindow(const Resolution& resolution, const char* title) override;
+		void DestroyWindow(Handle window_handle) override;
+		void SetWindowResolution(Handle window_handle, const Resolution& resolution) override;
+		void SetWindowTitle(Handle window_handle, const char* title) override;
+		void SetWindowIcon(Handle /*window_handle*/, UInt16 /*width*/, UInt16 /*height*/, void* /*pixels*/) override {}
+		void SetWindowFullscreen(Handle /*window_handle*/, Handle /*monitor_handle*/) override {}
+		void SetWindowEventCallback(Handle /*window_handle*/, EventCallbackFn /*event_fn*/) override {}
+		void SetCursorVisibility(Handle /*window_handle*/, bool /*value*/) override {}
+
+	public:
+		Handle CreateBuffer(BufferUsage::Enum buffer_usage, const BufferLayout& buffer_layout, SizeType count, const void* data) override;
+		void UpdateBuffer(Handle buffer_handle, SizeType offset, SizeType data_size, const void* data) override;
+		void GetBuffer(Handle buffer_handle, SizeType offset, SizeType data_size, void* data) override;
+		void DestroyBuffer(Handle buffer_handle) override;
+
+	public:
+		Handle CreateTexture2D(const Vector2HalfInt& size, PixelFormat::Enum format, const void* pixels, TextureLODFilter::Enum min_filter, TextureLODFilter::Enum mag_filter, TextureWrap::Enum wrap_s, TextureWrap::Enum wrap_t, bool create_mipmap) override;
+		void UpdateTexture2D(Handle texture_handle, const void* pixels) override;
+		void GetTexture(Handle texture_handle, UInt16 buffer_size, void* pixels) override;
+		void DestroyTexture(Handle texture_handle) override;
+
+	public:
+		Handle CreateShader(const char** sources, ShaderType::Enum* types, SizeType count, ShaderTags::Enum tags) override;
+		bool ReloadShader(Handle shader_handle, const char** sources, ShaderType::Enum* types, SizeType count) override;
+		void SetUniform(Handle shader_handle, HashedString name, const void* data, SizeType count) const override;
+		void DestroyShader(Handle shader_handle) override;
+
+	public:
+		Handle CreateFrameBuffer(
+			const Vector2HalfInt& size,
+			const PixelFormat::Enum* attachment_formats,
+			SizeType count
+		) override;
+		void DestroyFrameBuffer(Handle framebuffer_handle) override;
+
+	public:
+		Handle CreateComputeShader(const char* source, OnComputeShaderBindFn on_compute_shader_bind) override;
+		void DestroyComputeShader(Handle compute_shader_handle) override;
+
+	public:
+		using Renderer::CreateMesh;
+		Handle CreateMesh(
+			Topology::Enum topology,
+			BufferUsage::Enum usage,
+			const MeshLayout& layout,
+			SizeType vertex_capacity,
+			SizeType index_capacity
+		) override;
+		void SetMeshIndexCount(Handle mesh_handle, SizeType count) override;
+		void SetMeshIndices(Handle mesh_handle, const UInt32* data, SizeType count) override;
+		void SetMeshData(Handle mesh_handle, SizeType index, const void* data, SizeType size) override;
+		void DestroyMesh(Handle mesh_handle) override;
+		Handle CreateMeshPool(
+			Topology::Enum topology,
+			BufferUsage::Enum usage,
+			const MeshLayout& layout,
+			SizeType vertex_capacity,
+			SizeType index_capacity
+		) override;
+		void DestroyMeshPool(Handle mesh_pool_handle) override;
+
+	public:
+		Handle CreateMaterial(
+			Handle shader_handle,
+			Blending::Enum blending,
+			OnMaterialBindFn on_material_bind
+		) override;
+		void DestroyMaterial(Handle material_handle) override;
+
+	public:
+		using Renderer::CreateView;
+		Handle CreateView(
+			const Math::RectangleInt& viewport,
+			const Math::Matrix4& projection_matrix,
+			const Math::Matrix4& view_matrix,
+			DepthTesting::Enum depth_test,
+			Handle framebuffer_handle
+		) override;
+		void DestroyView(Handle view_handle) override;
+
+	public:
+		using Renderer::CreateDrawSurface;
+		Handle CreateDrawSurface(
+			const Math::RectangleInt& area,
+			const Math::Color& clear_color,
+			float clear_depth,
+			Int32 clear_stencil
+		) override;
+		void DestroyDrawSurface(Handle draw_surface_handle) override;
+
+	public:
+		inline Handle GetDefaultView(Handle window_handle) const { return m_DataMap.Get<Window>(window_handle).DefaultViewHandle; }
+
+		// Written by frame execution, read after WaitIdle when pipelined.
+		inline const FrameStats& GetLastFrameStats() const { return m_LastFrameStats; }
+		inline const FrameStats& GetTotalStats() const { return m_TotalStats; }
+		inline SizeType GetFrameCount() const { return m_FrameCount; }
+		void ResetStats();
+
+	protected:
+		void ExecuteFrame(std::vector<DrawCommand>& draw_commands, std::vector<ComputeCommand>& compute_commands) override;
+
+		void OnBindView(Handle draw_handle, const View& view) override;
+		void OnBindDrawSurface(const DrawSurface& draw_surface, const View& view) override;
+		void OnBindMaterial(const Material& material, const Math::Matrix4& view_matrix, const Math::Matrix4& projection_matrix) override;
+		void OnDraw(const DrawCommand& draw_command, Handle shader_handle) override;
+		void OnDrawInstanced(Handle mesh_handle, SizeType first_instance, SizeType instance_count) override;
+		void OnDrawMultiDraw(const MultiDrawBatch& batch) override;
+
+		void ProcessComputeCommands(const std::vector<ComputeCommand>& compute_commands);
+
+	protected:
+		// uniforms and uploads are counted as they are made, ExecuteFrame closes the frame
+		mutable FrameStats m_FrameStats{};
+		FrameStats m_LastFrameStats{};
+		FrameStats m_TotalStats{};
+		SizeType m_FrameCount{0};
+		RenderStateCache m_StateCache;
+
+		// instance and multi draw data of the frame, stand in for the uploaded buffers
+		std::vector<Math::Matrix4> m_InstanceTransforms;
+		MultiDrawList m_MultiDraws;
+	};
+}
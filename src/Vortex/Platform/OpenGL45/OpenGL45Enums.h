@@ -153,6 +153,19 @@ namespace Vortex::Graphics {
 		};
 	}
 
+	namespace Blending {
+		constexpr static GLenum ToGLSourceFactor[]{
+			GL_ONE, //Opaque
+			GL_SRC_ALPHA, //Additive
+			GL_DST_COLOR //Subtractive
+		};
+		constexpr static GLenum ToGLDestinationFactor[]{
+			GL_ZERO, //Opaque
+			GL_ONE_MINUS_SRC_ALPHA, //Additive
+			GL_ZERO //Subtractive
+		};
+	}
+
 	namespace ElementType {
 		constexpr static GLenum ToGLUniformType[]{
 			GL_FLOAT,        //Float1
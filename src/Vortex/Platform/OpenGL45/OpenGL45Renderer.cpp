@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <cstring>
+
 #include "OpenGL45Renderer.h"
 
 #include "Vortex/Common/Console.h"
+#include "Vortex/Debug/Profiler.h"
 
 constexpr static const char* TranslateErrorCode(GLenum error) {
 	switch (error) {
@@ -49,6 +53,11 @@ namespace Vortex::Graphics {
 
 	}
 	OpenGL45Renderer::~OpenGL45Renderer() {
+		SetFramesInFlight(0);
+		if (glfwGetCurrentContext() != nullptr) {
+			m_UploadRing.Destroy();
+			glDeleteBuffers(1, &m_DrawIndexBuffer);
+		}
 #ifdef VORTEX_DEBUG
 		if (!m_DataMap.d_ActiveIDs.empty()) {
 			Console::WriteDebug("[Renderer] following handles was active:");
@@ -67,6 +76,8 @@ namespace Vortex::Graphics {
 					Console::WriteDebug("[Renderer] ComputeShader %u", handle);
 				} else if (m_DataMap.Is<Mesh>(handle)) {
 					Console::WriteDebug("[Renderer] Mesh %u", handle);
+				} else if (m_DataMap.Is<MeshPool>(handle)) {
+					Console::WriteDebug("[Renderer] MeshPool %u", handle);
 				} else if (m_DataMap.Is<Material>(handle)) {
 					Console::WriteDebug("[Renderer] Material %u", handle);
 				} else if (m_DataMap.Is<DrawSurface>(handle)) {
@@ -81,6 +92,7 @@ namespace Vortex::Graphics {
 	}
 
 	Handle OpenGL45Renderer::CreateWindow(const Resolution& resolution, const char* title) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateWindow called while frames are in flight, call WaitIdle first.")
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
 		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -162,6 +174,7 @@ namespace Vortex::Graphics {
 		return handle;
 	}
 	void OpenGL45Renderer::DestroyWindow(Handle window_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyWindow called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_WindowChecks(window_handle))
 
 		const auto& window = m_DataMap.Get<Window>(window_handle);
@@ -224,18 +237,18 @@ namespace Vortex::Graphics {
 				auto* window_user_struct = static_cast<WindowDataStruct*>(glfwGetWindowUserPointer(nwin));
 
 				if (action == GLFW_PRESS) {
-					window_user_struct->event_callback_fn(Event::CreateKeyPress(static_cast<KeyCode::Enum>(key)));
+					window_user_struct->event_callback_fn(Event::CreateKeyPress(window_user_struct->window_handle, static_cast<KeyCode::Enum>(key)));
 				} else if (action == GLFW_RELEASE) {
-					window_user_struct->event_callback_fn(Event::CreateKeyRelease(static_cast<KeyCode::Enum>(key)));
+					window_user_struct->event_callback_fn(Event::CreateKeyRelease(window_user_struct->window_handle, static_cast<KeyCode::Enum>(key)));
 				} else if (action == GLFW_REPEAT) {
-					window_user_struct->event_callback_fn(Event::CreateKeyRepeat(static_cast<KeyCode::Enum>(key)));
+					window_user_struct->event_callback_fn(Event::CreateKeyRepeat(window_user_struct->window_handle, static_cast<KeyCode::Enum>(key)));
 				}
 			}
 		);
 		glfwSetCharCallback(
 			glfw_window_ptr, [](GLFWwindow* nwin, unsigned int c) {
 				auto* window_user_struct = static_cast<WindowDataStruct*>(glfwGetWindowUserPointer(nwin));
-				window_user_struct->event_callback_fn(Event::CreateCharInput(c));
+				window_user_struct->event_callback_fn(Event::CreateCharInput(window_user_struct->window_handle, c));
 			}
 		);
 
@@ -244,22 +257,22 @@ namespace Vortex::Graphics {
 				auto* window_user_struct = static_cast<WindowDataStruct*>(glfwGetWindowUserPointer(nwin));
 
 				if (action == GLFW_PRESS) {
-					window_user_struct->event_callback_fn(Event::CreateMousePress(static_cast<MouseButton::Enum>(button)));
+					window_user_struct->event_callback_fn(Event::CreateMousePress(window_user_struct->window_handle, static_cast<MouseButton::Enum>(button)));
 				} else if (action == GLFW_RELEASE) {
-					window_user_struct->event_callback_fn(Event::CreateMouseRelease(static_cast<MouseButton::Enum>(button)));
+					window_user_struct->event_callback_fn(Event::CreateMouseRelease(window_user_struct->window_handle, static_cast<MouseButton::Enum>(button)));
 				}
 			}
 		);
 		glfwSetCursorPosCallback(
 			glfw_window_ptr, [](GLFWwindow* nwin, double x, double y) {
 				auto* window_user_struct = static_cast<WindowDataStruct*>(glfwGetWindowUserPointer(nwin));
-				window_user_struct->event_callback_fn(Event::CreateMouseMove(static_cast<float>(x), static_cast<float>(y)));
+				window_user_struct->event_callback_fn(Event::CreateMouseMove(window_user_struct->window_handle, static_cast<float>(x), static_cast<float>(y)));
 			}
 		);
 		glfwSetScrollCallback(
 			glfw_window_ptr, [](GLFWwindow* nwin, double x, double y) {
 				auto* window_user_struct = static_cast<WindowDataStruct*>(glfwGetWindowUserPointer(nwin));
-				window_user_struct->event_callback_fn(Event::CreateScrollChange(static_cast<float>(x), static_cast<float>(y)));
+				window_user_struct->event_callback_fn(Event::CreateScrollChange(window_user_struct->window_handle, static_cast<float>(x), static_cast<float>(y)));
 			}
 		);
 
@@ -301,6 +314,7 @@ namespace Vortex::Graphics {
 	}
 
 	Handle OpenGL45Renderer::CreateBuffer(BufferUsage::Enum buffer_usage, const BufferLayout& buffer_layout, SizeType count, const void* data) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateBuffer called while frames are in flight, call WaitIdle first.")
 		GLuint id;
 		glCreateBuffers(1, &id);
 
@@ -317,38 +331,160 @@ namespace Vortex::Graphics {
 		return m_DataMap.Insert<Buffer>(buffer);
 	}
 	void OpenGL45Renderer::UpdateBuffer(Handle buffer_handle, SizeType offset, SizeType data_size, const void* data) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] UpdateBuffer called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_BufferChecks(buffer_handle))
 
 		const auto& buffer = m_DataMap.Get<Buffer>(buffer_handle);
 		VORTEX_ASSERT(buffer.Mutable)
 		VORTEX_ASSERT(offset + data_size <= buffer.Size)
 
-		auto id = buffer.AdditionalData.Layout<GLuint>();
-		auto gl_offs = static_cast<GLsizei>(offset);
-		auto gl_size = static_cast<GLsizei>(data_size);
-		glNamedBufferSubData(id, gl_offs, gl_size, data);
+		auto mapped_buffer_it = m_MappedBuffers.find(buffer_handle);
+		if (mapped_buffer_it != m_MappedBuffers.end()) {
+			WriteMappedBuffer(buffer_handle, mapped_buffer_it->second, offset, data_size, data);
+		} else {
+			auto id = buffer.AdditionalData.Layout<GLuint>();
+			auto gl_offs = static_cast<GLsizei>(offset);
+			auto gl_size = static_cast<GLsizei>(data_size);
+			glNamedBufferSubData(id, gl_offs, gl_size, data);
+		}
+
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer Uploaded Bytes", data_size)
 	}
 	void OpenGL45Renderer::GetBuffer(Handle buffer_handle, SizeType offset, SizeType data_size, void* data) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] GetBuffer called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_BufferChecks(buffer_handle))
 
 		const auto& buffer = m_DataMap.Get<Buffer>(buffer_handle);
 		VORTEX_ASSERT(buffer.Mutable)
 		VORTEX_ASSERT(offset + data_size <= buffer.Size)
 
+		// the current region is only complete after the fill
+		auto mapped_buffer_it = m_MappedBuffers.find(buffer_handle);
+		if (mapped_buffer_it != m_MappedBuffers.end() && mapped_buffer_it->second.FillPending) {
+			FillMappedBuffer(buffer, mapped_buffer_it->second);
+		}
+
 		auto id = buffer.AdditionalData.Layout<GLuint>();
-		auto gl_offs = static_cast<GLsizei>(offset);
+		auto gl_offs = static_cast<GLsizei>(buffer.Offset + offset);
 		auto gl_size = static_cast<GLsizei>(data_size);
 		glGetNamedBufferSubData(id, gl_offs, gl_size, data);
 	}
 	void OpenGL45Renderer::DestroyBuffer(Handle buffer_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyBuffer called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_BufferChecks(buffer_handle))
 		const auto& buffer = m_DataMap.Get<Buffer>(buffer_handle);
 
+		// deleting the buffer also unmaps it
+		m_MappedBuffers.erase(buffer_handle);
+
 		auto id = buffer.AdditionalData.Layout<GLuint>();
 		glDeleteBuffers(1, &id);
 		m_DataMap.Destroy(buffer_handle);
 	}
 
+	Handle OpenGL45Renderer::CreateMeshBuffer(BufferUsage::Enum buffer_usage, const BufferLayout& buffer_layout, SizeType count) {
+		if (buffer_usage != BufferUsage::DynamicDraw || count == 0) {
+			return CreateBuffer(buffer_usage, buffer_layout, count, nullptr);
+		}
+
+		GLuint id;
+		glCreateBuffers(1, &id);
+
+		auto size = count * buffer_layout.Stride;
+		auto gl_size = static_cast<GLsizeiptr>(size * OpenGL45UploadRing::RegionCount);
+		glNamedBufferStorage(id, gl_size, nullptr, OpenGL45UploadRing::MappingFlags);
+		auto* data = static_cast<Byte*>(glMapNamedBufferRange(id, 0, gl_size, OpenGL45UploadRing::MappingFlags));
+		if (data == nullptr) {
+			Console::WriteError("[OpenGL] Error mapping buffer of %zu bytes, updating it with glNamedBufferSubData.", size * OpenGL45UploadRing::RegionCount);
+			glDeleteBuffers(1, &id);
+			return CreateBuffer(buffer_usage, buffer_layout, count, nullptr);
+		}
+
+		Buffer buffer{};
+		buffer.BufferUsage = buffer_usage;
+		buffer.Layout = buffer_layout;
+		buffer.Mutable = true;
+		buffer.Size = size;
+		buffer.Offset = 0;
+		buffer.AdditionalData.Layout<GLuint>() = id;
+		auto handle = m_DataMap.Insert<Buffer>(buffer);
+
+		MappedBuffer mapped_buffer{};
+		mapped_buffer.Data = data;
+		mapped_buffer.Region = 0;
+		mapped_buffer.RegionFrame = m_UploadRing.GetFrame();
+		mapped_buffer.FillPending = false;
+		m_MappedBuffers.emplace(handle, std::move(mapped_buffer));
+
+		return handle;
+	}
+	void OpenGL45Renderer::WriteMappedBuffer(Handle buffer_handle, MappedBuffer& mapped_buffer, SizeType offset, SizeType data_size, const void* data) {
+		auto& buffer = m_DataMap.Get<Buffer>(buffer_handle);
+		auto frame = m_UploadRing.GetFrame();
+
+		// frames since the region was written may still read it, move on to the oldest region
+		if (mapped_buffer.RegionFrame != frame) {
+			mapped_buffer.LastReadFrames[mapped_buffer.Region] = frame - 1;
+			mapped_buffer.FillPending = true;
+			mapped_buffer.FillSourceOffset = buffer.Offset;
+			mapped_buffer.WrittenRanges.clear();
+
+			mapped_buffer.Region = (mapped_buffer.Region + 1) % OpenGL45UploadRing::RegionCount;
+			mapped_buffer.RegionFrame = frame;
+			m_UploadRing.WaitForFrame(mapped_buffer.LastReadFrames[mapped_buffer.Region]);
+
+			buffer.Offset = mapped_buffer.Region * buffer.Size;
+			auto id = buffer.AdditionalData.Layout<GLuint>();
+			for (const auto& binding : mapped_buffer.Bindings) {
+				glVertexArrayVertexBuffer(binding.VertexArrayID, binding.BindingIndex, id, static_cast<GLintptr>(buffer.Offset), binding.Stride);
+			}
+			m_PendingFills.push_back(buffer_handle);
+		}
+		if (mapped_buffer.FillPending) {
+			mapped_buffer.WrittenRanges.emplace_back(offset, offset + data_size);
+		}
+
+		std::memcpy(mapped_buffer.Data + buffer.Offset + offset, data, data_size);
+	}
+	void OpenGL45Renderer::FillMappedBuffer(const Buffer& buffer, MappedBuffer& mapped_buffer) {
+		auto id = buffer.AdditionalData.Layout<GLuint>();
+		auto copy_range = [&](SizeType begin, SizeType end) {
+			glCopyNamedBufferSubData(
+				id,
+				id,
+				static_cast<GLintptr>(mapped_buffer.FillSourceOffset + begin),
+				static_cast<GLintptr>(buffer.Offset + begin),
+				static_cast<GLsizeiptr>(end - begin)
+			);
+		};
+
+		// copy the gaps between the written ranges
+		auto& written_ranges = mapped_buffer.WrittenRanges;
+		std::sort(written_ranges.begin(), written_ranges.end());
+		SizeType cursor = 0;
+		for (const auto& range : written_ranges) {
+			if (range.first > cursor) {
+				copy_range(cursor, range.first);
+			}
+			cursor = std::max(cursor, range.second);
+		}
+		if (cursor < buffer.Size) {
+			copy_range(cursor, buffer.Size);
+		}
+
+		written_ranges.clear();
+		mapped_buffer.FillPending = false;
+	}
+	void OpenGL45Renderer::FillMappedBuffers() {
+		for (auto buffer_handle : m_PendingFills) {
+			auto mapped_buffer_it = m_MappedBuffers.find(buffer_handle);
+			if (mapped_buffer_it != m_MappedBuffers.end() && mapped_buffer_it->second.FillPending) {
+				FillMappedBuffer(m_DataMap.Get<Buffer>(buffer_handle), mapped_buffer_it->second);
+			}
+		}
+		m_PendingFills.clear();
+	}
+
 	Handle OpenGL45Renderer::CreateTexture2D(
 		const Vector2HalfInt& size,
 		PixelFormat::Enum format,
@@ -359,6 +495,7 @@ namespace Vortex::Graphics {
 		TextureWrap::Enum wrap_t,
 		bool create_mipmap
 	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateTexture2D called while frames are in flight, call WaitIdle first.")
 		//VORTEX_ASSERT(size[0] <= m_HardwareLimits[HardwareLimit::MaxTextureSize])
 		//VORTEX_ASSERT(size[1] <= m_HardwareLimits[HardwareLimit::MaxTextureSize])
 
@@ -430,6 +567,7 @@ namespace Vortex::Graphics {
 		return m_DataMap.Insert<Texture>(texture);
 	}
 	void OpenGL45Renderer::UpdateTexture2D(Handle texture_handle, const void* pixels) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] UpdateTexture2D called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_TextureChecks(texture_handle))
 		VORTEX_ASSERT(pixels != nullptr)
 
@@ -453,6 +591,7 @@ namespace Vortex::Graphics {
 		}
 	}
 	void OpenGL45Renderer::GetTexture(Handle texture_handle, UInt16 buffer_size, void* pixels) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] GetTexture called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_TextureChecks(texture_handle))
 		VORTEX_ASSERT(pixels != nullptr)
 
@@ -469,6 +608,7 @@ namespace Vortex::Graphics {
 		);
 	}
 	void OpenGL45Renderer::DestroyTexture(Handle texture_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyTexture called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_TextureChecks(texture_handle))
 		const auto& texture = m_DataMap.Get<Texture>(texture_handle);
 		auto id = texture.AdditionalData.Layout<GLuint>();
@@ -478,6 +618,7 @@ namespace Vortex::Graphics {
 	}
 
 	Handle OpenGL45Renderer::CreateShader(const char** sources, ShaderType::Enum* types, SizeType count, ShaderTags::Enum tags) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateShader called while frames are in flight, call WaitIdle first.")
 		std::vector<GLuint> shader_ids;
 
 		for (SizeType i = 0; i < count; ++i) {
@@ -496,13 +637,14 @@ namespace Vortex::Graphics {
 		}
 
 		Shader shader{};
+		shader.Tags = tags;
 		QueryShaderTypes(shader, gl_id);
 		shader.AdditionalData.Layout<GLuint>() = gl_id;
-		shader.Tags = tags;
 
 		return m_DataMap.Insert<Shader>(shader);
 	}
 	bool OpenGL45Renderer::ReloadShader(Handle shader_handle, const char** sources, ShaderType::Enum* types, SizeType count) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] ReloadShader called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_ShaderChecks(shader_handle))
 
 		std::vector<GLuint> shader_ids;
@@ -522,9 +664,7 @@ namespace Vortex::Graphics {
 		}
 
 		auto& shader = m_DataMap.Get<Shader>(shader_handle);
-		shader.BindingPositions.clear();
-		shader.Locations.clear();
-		shader.Types.clear();
+		shader.Tags = static_cast<ShaderTags::Enum>(shader.Tags & ~ShaderTags::MultiDraw);
 		QueryShaderTypes(shader, gl_new_id);
 		auto gl_shader_id = shader.AdditionalData.Layout<GLuint>();
 		glDeleteProgram(gl_shader_id);
@@ -536,34 +676,43 @@ namespace Vortex::Graphics {
 		VORTEX_ASSERT(d_ShaderChecks(shader_handle))
 		const auto& shader = m_DataMap.Get<Shader>(shader_handle);
 
-		auto gl_program_id = shader.AdditionalData.Layout<GLuint>();
-
-		GLint gl_location;
-		auto it = shader.Locations.find(name);
-
-		if (it == shader.Locations.end()) {
+		const auto* uniform = FindShaderUniform(shader, name);
+		if (uniform == nullptr) {
 			return;
 		}
+		UploadUniform(shader, *uniform, data, count);
+	}
+	void OpenGL45Renderer::SetConstantUniform(Handle shader_handle, ShaderConstants::Enum constant, const void* data) const {
+		VORTEX_ASSERT(d_ShaderChecks(shader_handle))
+		const auto& shader = m_DataMap.Get<Shader>(shader_handle);
 
-		gl_location = it->second;
-		ElementType::Enum type = shader.Types.at(name);
+		const auto& uniform = shader.ConstantUniforms[constant];
+		if (uniform.Location == -1) {
+			return;
+		}
+		UploadUniform(shader, uniform, data, 1);
+	}
+	void OpenGL45Renderer::UploadUniform(const Shader& shader, const ShaderUniform& uniform, const void* data, SizeType count) const {
+		auto gl_program_id = shader.AdditionalData.Layout<GLuint>();
+		GLint gl_location = uniform.Location;
+		ElementType::Enum type = uniform.Type;
 
 		if (type == ElementType::Sampler1D ||
 			type == ElementType::Sampler2D ||
 			type == ElementType::Sampler3D) {
-			auto binding = shader.BindingPositions.at(name);
+			auto binding = uniform.Binding;
 			auto texture_handle = *static_cast<const Handle*>(data);
 			VORTEX_ASSERT(d_TextureChecks(texture_handle))
 
 			const auto& texture = m_DataMap.Get<Texture>(texture_handle);
 
 			auto gl_texture_id = texture.AdditionalData.Layout<GLuint>();
-			glBindTextureUnit(binding, gl_texture_id);
+			m_StateCache.BindTextureUnit(binding, gl_texture_id);
 
 		} else if (type == ElementType::Image1D ||
 			type == ElementType::Image2D ||
 			type == ElementType::Image3D) {
-			auto binding = shader.BindingPositions.at(name);
+			auto binding = uniform.Binding;
 			auto texture_handle = *static_cast<const Handle*>(data);
 			VORTEX_ASSERT(d_TextureChecks(texture_handle))
 
@@ -580,7 +729,7 @@ namespace Vortex::Graphics {
 				PixelFormat::ToGLImageTexture[texture.PixelFormat]
 			);
 		} else if (type == ElementType::UniformBlock) {
-			auto binding = shader.BindingPositions.at(name);
+			auto binding = uniform.Binding;
 			auto buffer_handle = *static_cast<const Handle*>(data);
 			VORTEX_ASSERT(d_BufferChecks(buffer_handle))
 
@@ -591,7 +740,7 @@ namespace Vortex::Graphics {
 			glUniformBlockBinding(gl_program_id, gl_location, binding);
 			glBindBufferBase(GL_UNIFORM_BUFFER, binding, gl_buffer_id);
 		} else if (type == ElementType::StorageBlock) {
-			auto binding = shader.BindingPositions.at(name);
+			auto binding = uniform.Binding;
 			auto buffer_handle = *static_cast<const Handle*>(data);
 			VORTEX_ASSERT(d_BufferChecks(buffer_handle))
 
@@ -724,6 +873,7 @@ namespace Vortex::Graphics {
 		}
 	}
 	void OpenGL45Renderer::DestroyShader(Handle shader_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyShader called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_ShaderChecks(shader_handle))
 		const auto& shader = m_DataMap.Get<Shader>(shader_handle);
 
@@ -798,6 +948,7 @@ namespace Vortex::Graphics {
 		return ElementType::Count;
 	}
 	void OpenGL45Renderer::QueryShaderTypes(Shader& data, GLuint program_id) {
+		std::vector<ShaderUniform> uniforms;
 		{
 			//retrieve shader uniform count
 			GLsizei uniform_count;
@@ -816,17 +967,21 @@ namespace Vortex::Graphics {
 				HashedString hashed_str{name, static_cast<SizeType>(length) + 1};
 				ElementType::Enum type = FindType(gl_type);
 
-				data.Types.insert(std::pair(hashed_str, type));
-				data.Locations.insert(std::pair(hashed_str, location));
+				// members of uniform blocks have no location, they are set through their block
+				if (location == -1) {
+					continue;
+				}
 
+				ShaderUniform uniform{hashed_str, location, -1, type};
 				if (gl_type == GL_SAMPLER_1D || gl_type == GL_SAMPLER_2D || gl_type == GL_SAMPLER_3D
 					|| gl_type == GL_IMAGE_1D || gl_type == GL_IMAGE_2D || gl_type == GL_IMAGE_3D) {
-					data.BindingPositions.insert(std::pair(hashed_str, sampler_position));
+					uniform.Binding = sampler_position;
 					glProgramUniform1i(program_id, location, sampler_position);
 					++sampler_position;
 				}
+				uniforms.push_back(uniform);
 
-				Console::WriteDebug("[OpenGL] Cached shader uniform. Location: %i Type: %s Name: %s", location, ElementType::ToString[type], name);
+				VORTEX_LOG_CATEGORY_DEBUG(LogCategory::Shader, "Cached shader uniform. Location: %i Type: %s Name: %s", location, ElementType::ToString[type], name);
 			}
 		}
 		{
@@ -850,11 +1005,9 @@ namespace Vortex::Graphics {
 				ElementType::Enum type = ElementType::UniformBlock;
 				GLint location = glGetUniformBlockIndex(program_id, name);
 
-				data.Types.insert(std::pair(hashed_str, type));
-				data.Locations.insert(std::pair(hashed_str, location));
-				data.BindingPositions.insert(std::pair(hashed_str, binding_position));
+				uniforms.push_back(ShaderUniform{hashed_str, location, binding_position, type});
 				++binding_position;
-				Console::WriteDebug("[OpenGL] Cached shader uniform block. Location: %i Type: %s Name: %s", location, ElementType::ToString[type], name);
+				VORTEX_LOG_CATEGORY_DEBUG(LogCategory::Shader, "Cached shader uniform block. Location: %i Type: %s Name: %s", location, ElementType::ToString[type], name);
 			}
 		}
 		{
@@ -869,15 +1022,25 @@ namespace Vortex::Graphics {
 				glGetActiveAttrib(program_id, i, 128, &length, &size, &gl_type, name);
 				GLint location = glGetAttribLocation(program_id, name);
 
-				HashedString hashed_str{name, static_cast<SizeType>(length) + 1};
-
-				ElementType::Enum type = FindType(gl_type);
+				// attributes are bound by location through the mesh layout, SetUniform does not see them
+				VORTEX_LOG_CATEGORY_DEBUG(LogCategory::Shader, "Shader attribute: %i - %s", location, name);
+			}
+		}
+		{
+			// a DrawData storage block opts the shader into multi draw submission
+			GLuint block_index = glGetProgramResourceIndex(program_id, GL_SHADER_STORAGE_BLOCK, ShaderConstants::DrawDataBlockName);
+			if (block_index != GL_INVALID_INDEX) {
+				glShaderStorageBlockBinding(program_id, block_index, ShaderConstants::DrawDataBinding);
+				data.Tags = static_cast<ShaderTags::Enum>(data.Tags | ShaderTags::MultiDraw);
+				VORTEX_LOG_CATEGORY_DEBUG(LogCategory::Shader, "Shader storage block %s found, multi draw enabled.", ShaderConstants::DrawDataBlockName);
+			}
 
-				data.Types.insert(std::pair(hashed_str, type));
-				data.Locations.insert(std::pair(hashed_str, location));
-				Console::WriteDebug("[OpenGL] Cached shader attribute: %i - %s", location, name);
+			block_index = glGetProgramResourceIndex(program_id, GL_SHADER_STORAGE_BLOCK, ShaderConstants::MaterialDataBlockName);
+			if (block_index != GL_INVALID_INDEX) {
+				glShaderStorageBlockBinding(program_id, block_index, ShaderConstants::MaterialDataBinding);
 			}
 		}
+		BuildShaderUniforms(data, uniforms);
 	}
 
 	Handle OpenGL45Renderer::CreateFrameBuffer(
@@ -885,6 +1048,7 @@ namespace Vortex::Graphics {
 		const PixelFormat::Enum* attachment_formats,
 		SizeType count
 	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateFrameBuffer called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(attachment_formats != nullptr)
 		VORTEX_ASSERT(count > 0)
 
@@ -940,6 +1104,7 @@ namespace Vortex::Graphics {
 		return handle;
 	}
 	void OpenGL45Renderer::DestroyFrameBuffer(Handle framebuffer_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyFrameBuffer called while frames are in flight, call WaitIdle first.")
 		const auto& framebuffer = m_DataMap.Get<FrameBuffer>(framebuffer_handle);
 		for (auto texture_id : framebuffer.TextureHandles) {
 			DestroyTexture(texture_id);
@@ -951,6 +1116,7 @@ namespace Vortex::Graphics {
 	}
 
 	Handle OpenGL45Renderer::CreateComputeShader(const char* source, OnComputeShaderBindFn on_compute_shader_bind) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateComputeShader called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(on_compute_shader_bind != nullptr);
 		ShaderType::Enum type{ShaderType::Compute};
 		auto shader_handle = CreateShader(&source, &type, 1, ShaderTags::Undefined);
@@ -965,6 +1131,7 @@ namespace Vortex::Graphics {
 		return m_DataMap.Insert<ComputeShader>(compute_shader);
 	}
 	void OpenGL45Renderer::DestroyComputeShader(Handle compute_shader_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyComputeShader called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_ComputeShaderChecks(compute_shader_handle))
 		const auto& compute_shader = m_DataMap.Get<ComputeShader>(compute_shader_handle);
 
@@ -979,53 +1146,138 @@ namespace Vortex::Graphics {
 		SizeType vertex_capacity,
 		SizeType index_capacity
 	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateMesh called while frames are in flight, call WaitIdle first.")
+		Mesh mesh{};
+		mesh.IndexCount = 0;
+		mesh.IndexCapacity = index_capacity;
+		mesh.Topology = topology;
+		mesh.AdditionalData.Layout<GLuint>() = CreateVertexArray(
+			usage,
+			layout,
+			vertex_capacity,
+			index_capacity,
+			mesh.IndexBufferHandle,
+			mesh.BufferHandles
+		);
 
+#ifdef VORTEX_DEBUG
+		for (SizeType i = 0; i < layout.Count; ++i) {
+			mesh.d_BufferSizes.emplace_back(layout.BufferLayouts[i].Stride * vertex_capacity);
+		}
+#endif
+
+		auto handle = m_DataMap.Insert<Mesh>(mesh);
+
+		return handle;
+	}
+	Handle OpenGL45Renderer::CreateMeshPool(
+		Topology::Enum topology,
+		BufferUsage::Enum usage,
+		const MeshLayout& layout,
+		SizeType vertex_capacity,
+		SizeType index_capacity
+	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateMeshPool called while frames are in flight, call WaitIdle first.")
+		MeshPool mesh_pool{};
+		mesh_pool.VertexCapacity = vertex_capacity;
+		mesh_pool.IndexCapacity = index_capacity;
+		mesh_pool.VertexCount = 0;
+		mesh_pool.IndexCount = 0;
+		mesh_pool.Topology = topology;
+		mesh_pool.AdditionalData.Layout<GLuint>() = CreateVertexArray(
+			usage,
+			layout,
+			vertex_capacity,
+			index_capacity,
+			mesh_pool.IndexBufferHandle,
+			mesh_pool.BufferHandles
+		);
+
+		return m_DataMap.Insert<MeshPool>(mesh_pool);
+	}
+	void OpenGL45Renderer::DestroyMeshPool(Handle mesh_pool_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyMeshPool called while frames are in flight, call WaitIdle first.")
+		VORTEX_ASSERT(d_MeshPoolChecks(mesh_pool_handle))
+		const auto& mesh_pool = m_DataMap.Get<MeshPool>(mesh_pool_handle);
+
+		for (auto buffer_handle : mesh_pool.BufferHandles) {
+			DestroyBuffer(buffer_handle);
+		}
+
+		auto gl_mesh_pool_id = mesh_pool.AdditionalData.Layout<GLuint>();
+		glDeleteVertexArrays(1, &gl_mesh_pool_id);
+
+		DestroyBuffer(mesh_pool.IndexBufferHandle);
+		m_DataMap.Destroy(mesh_pool_handle);
+	}
+	GLuint OpenGL45Renderer::CreateVertexArray(
+		BufferUsage::Enum usage,
+		const MeshLayout& layout,
+		SizeType vertex_capacity,
+		SizeType index_capacity,
+		Handle& index_buffer_handle,
+		std::vector<Handle>& buffer_handles
+	) {
 		GLuint gl_mesh_id;
 		glCreateVertexArrays(1, &gl_mesh_id);
 
-		auto index_buffer_handle = CreateBuffer(usage, CreateBufferLayout(ElementType::UInt1), index_capacity, nullptr);
+		index_buffer_handle = CreateMeshBuffer(usage, CreateBufferLayout(ElementType::UInt1), index_capacity);
 		const auto& index_buffer = m_DataMap.Get<Buffer>(index_buffer_handle);
 		auto gl_index_buffer_id = index_buffer.AdditionalData.Layout<GLuint>();
 		glVertexArrayElementBuffer(gl_mesh_id, gl_index_buffer_id);
 
-		Mesh mesh{};
-		mesh.IndexBufferHandle = index_buffer_handle;
-		mesh.IndexCount = 0;
-		mesh.IndexCapacity = index_capacity;
-		mesh.Topology = topology;
-		mesh.AdditionalData.Layout<GLuint>() = gl_mesh_id;
-
 		SizeType buffer_binding_index = 0;
 		for (SizeType i = 0; i < layout.Count; ++i) {
 			const auto& buffer_layout = layout.BufferLayouts[i];
-			auto vertex_buffer_handle = CreateBuffer(
+			auto vertex_buffer_handle = CreateMeshBuffer(
 				usage,
 				buffer_layout,
-				vertex_capacity,
-				nullptr
+				vertex_capacity
 			);
 
 			const auto& buffer = m_DataMap.Get<Buffer>(vertex_buffer_handle);
 			auto gl_buffer_id = buffer.AdditionalData.Layout<GLuint>();
 
+			auto mapped_buffer_it = m_MappedBuffers.find(vertex_buffer_handle);
+			if (mapped_buffer_it != m_MappedBuffers.end()) {
+				mapped_buffer_it->second.Bindings.push_back({
+					gl_mesh_id,
+					static_cast<GLuint>(buffer_binding_index),
+					static_cast<GLsizei>(buffer.Layout.Stride)
+				});
+			}
+
 			AddVertexBuffer(
 				gl_mesh_id,
 				gl_buffer_id,
 				buffer.Layout,
 				buffer_binding_index
 			);
-			mesh.BufferHandles.emplace_back(vertex_buffer_handle);
+			buffer_handles.emplace_back(vertex_buffer_handle);
+		}
 
-#ifdef VORTEX_DEBUG
-			mesh.d_BufferSizes.emplace_back(buffer_layout.Stride * vertex_capacity);
-#endif
+		// per-instance attributes of ShaderTags::Instanced and ShaderTags::MultiDraw shaders,
+		// the instance transforms are bound per draw in DrawMeshInstanced
+		VORTEX_ASSERT_MSG(buffer_binding_index <= ShaderConstants::DrawIndexLocation, "Mesh attributes overlap the per-instance attribute locations.")
+		if (m_DrawIndexBuffer == 0) {
+			glCreateBuffers(1, &m_DrawIndexBuffer);
+			ReserveDrawIndices(InitialDrawIndexCapacity);
 		}
 
-		auto handle = m_DataMap.Insert<Mesh>(mesh);
+		auto draw_index_layout = CreateBufferLayout(ElementType::UInt1);
+		draw_index_layout.ElementPerInstance = 1;
+		SizeType draw_index_binding_index = ShaderConstants::DrawIndexLocation;
+		AddVertexBuffer(gl_mesh_id, m_DrawIndexBuffer, draw_index_layout, draw_index_binding_index);
 
-		return handle;
+		auto instance_layout = CreateBufferLayout(ElementType::Matrix4);
+		instance_layout.ElementPerInstance = 1;
+		SizeType instance_binding_index = ShaderConstants::InstanceTransformLocation;
+		AddVertexBuffer(gl_mesh_id, 0, instance_layout, instance_binding_index);
+
+		return gl_mesh_id;
 	}
 	void OpenGL45Renderer::SetMeshIndexCount(Handle mesh_handle, SizeType count) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] SetMeshIndexCount called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
 		auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
 
@@ -1033,15 +1285,17 @@ namespace Vortex::Graphics {
 		mesh.IndexCount = count;
 	}
 	void OpenGL45Renderer::SetMeshIndices(Handle mesh_handle, const UInt32* data, SizeType count) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] SetMeshIndices called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
 		VORTEX_ASSERT(data != nullptr)
 		auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
 		VORTEX_ASSERT(count <= mesh.IndexCapacity)
 
-		UpdateBuffer(mesh.IndexBufferHandle, 0, count * sizeof(UInt32), data);
+		UpdateBuffer(mesh.IndexBufferHandle, mesh.FirstIndex * sizeof(UInt32), count * sizeof(UInt32), data);
 		mesh.IndexCount = count;
 	}
 	void OpenGL45Renderer::SetMeshData(Handle mesh_handle, SizeType index, const void* data, SizeType size) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] SetMeshData called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
 		VORTEX_ASSERT(data != nullptr)
 		auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
@@ -1050,13 +1304,21 @@ namespace Vortex::Graphics {
 		VORTEX_ASSERT(size <= mesh.d_BufferSizes[index])
 
 		auto attribute_handle = mesh.BufferHandles[index];
+		auto offset = mesh.BaseVertex * m_DataMap.Get<Buffer>(attribute_handle).Layout.Stride;
 
-		UpdateBuffer(attribute_handle, 0, size, data);
+		UpdateBuffer(attribute_handle, offset, size, data);
 	}
 	void OpenGL45Renderer::DestroyMesh(Handle mesh_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyMesh called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
 		const auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
 
+		// pooled meshes only release their handle, the buffers and vertex array belong to the pool
+		if (mesh.PoolHandle != Map::NullHandle) {
+			m_DataMap.Destroy(mesh_handle);
+			return;
+		}
+
 		for (auto buffer_handle : mesh.BufferHandles) {
 			VORTEX_ASSERT(m_DataMap.Contains(buffer_handle))
 			DestroyBuffer(buffer_handle);
@@ -1092,7 +1354,7 @@ namespace Vortex::Graphics {
 							ElementType::ComponentCount[ElementType::Float2],
 							ElementType::ToGLBufferType[ElementType::Float2],
 							element_normalized,
-							element_offset
+							element_offset + k * ElementType::Size[ElementType::Float2]
 						);
 						++attribute_index;
 					}
@@ -1104,7 +1366,7 @@ namespace Vortex::Graphics {
 							ElementType::ComponentCount[ElementType::Float3],
 							ElementType::ToGLBufferType[ElementType::Float3],
 							element_normalized,
-							element_offset
+							element_offset + k * ElementType::Size[ElementType::Float3]
 						);
 						++attribute_index;
 					}
@@ -1116,7 +1378,7 @@ namespace Vortex::Graphics {
 							ElementType::ComponentCount[ElementType::Float4],
 							ElementType::ToGLBufferType[ElementType::Float4],
 							element_normalized,
-							element_offset
+							element_offset + k * ElementType::Size[ElementType::Float4]
 						);
 						++attribute_index;
 					}
@@ -1163,17 +1425,122 @@ namespace Vortex::Graphics {
 		const auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
 		auto gl_mesh_id = mesh.AdditionalData.Layout<GLuint>();
 		auto gl_mesh_topology = Topology::ToGLType[mesh.Topology];
+		auto index_offset = m_DataMap.Get<Buffer>(mesh.IndexBufferHandle).Offset + mesh.FirstIndex * sizeof(UInt32);
+
+		m_StateCache.BindVertexArray(gl_mesh_id);
+		glDrawElementsBaseVertex(
+			gl_mesh_topology,
+			mesh.IndexCount,
+			ElementType::ToGLBufferType[ElementType::UInt1],
+			reinterpret_cast<const void*>(index_offset),
+			static_cast<GLint>(mesh.BaseVertex)
+		);
+	}
+
+	void OpenGL45Renderer::DrawMeshInstanced(Handle mesh_handle, SizeType first_instance, SizeType instance_count) const {
+		VORTEX_ASSERT(d_MeshChecks(mesh_handle))
+		VORTEX_ASSERT(first_instance + instance_count <= m_InstanceTransforms.size())
+		const auto& mesh = m_DataMap.Get<Mesh>(mesh_handle);
+		auto gl_mesh_id = mesh.AdditionalData.Layout<GLuint>();
+		auto gl_mesh_topology = Topology::ToGLType[mesh.Topology];
+		auto index_offset = m_DataMap.Get<Buffer>(mesh.IndexBufferHandle).Offset + mesh.FirstIndex * sizeof(UInt32);
 
-		glBindVertexArray(gl_mesh_id);
-		glDrawElements(
+		glVertexArrayVertexBuffer(
+			gl_mesh_id,
+			ShaderConstants::InstanceTransformLocation,
+			m_UploadRing.GetBuffer(),
+			static_cast<GLintptr>(m_InstanceDataOffset + first_instance * sizeof(Math::Matrix4)),
+			sizeof(Math::Matrix4)
+		);
+		m_StateCache.BindVertexArray(gl_mesh_id);
+		glDrawElementsInstancedBaseVertex(
 			gl_mesh_topology,
 			mesh.IndexCount,
 			ElementType::ToGLBufferType[ElementType::UInt1],
-			nullptr
+			reinterpret_cast<const void*>(index_offset),
+			static_cast<GLsizei>(instance_count),
+			static_cast<GLint>(mesh.BaseVertex)
+		);
+	}
+	void OpenGL45Renderer::DrawMultiDrawBatch(const MultiDrawBatch& batch) const {
+		VORTEX_ASSERT(d_MeshPoolChecks(batch.MeshPoolHandle))
+		const auto& mesh_pool = m_DataMap.Get<MeshPool>(batch.MeshPoolHandle);
+		auto gl_mesh_pool_id = mesh_pool.AdditionalData.Layout<GLuint>();
+		auto gl_mesh_topology = Topology::ToGLType[mesh_pool.Topology];
+
+		m_StateCache.BindVertexArray(gl_mesh_pool_id);
+		glMultiDrawElementsIndirect(
+			gl_mesh_topology,
+			ElementType::ToGLBufferType[ElementType::UInt1],
+			reinterpret_cast<const void*>(m_IndirectDataOffset + batch.FirstIndirectCommand * sizeof(DrawIndirectCommand)),
+			static_cast<GLsizei>(batch.IndirectCommandCount),
+			0
+		);
+	}
+
+	void OpenGL45Renderer::ReserveDrawIndices(SizeType count) {
+		if (count <= m_DrawIndexCapacity) {
+			return;
+		}
+
+		// draw index i is at element i, instance attributes read it at BaseInstance + instance.
+		// the buffer keeps its name when it grows, so the vertex array bindings stay valid
+		std::vector<UInt32> draw_indices(std::max(count, m_DrawIndexCapacity * 2));
+		for (SizeType i = 0; i < draw_indices.size(); ++i) {
+			draw_indices[i] = static_cast<UInt32>(i);
+		}
+		m_DrawIndexCapacity = draw_indices.size();
+		glNamedBufferData(m_DrawIndexBuffer, m_DrawIndexCapacity * sizeof(UInt32), draw_indices.data(), GL_STATIC_DRAW);
+	}
+	void OpenGL45Renderer::UploadFrameData() {
+		auto instance_size = m_InstanceTransforms.size() * sizeof(Math::Matrix4);
+		auto draw_data_size = m_MultiDraws.DrawData.size() * sizeof(MultiDrawData);
+		auto material_data_size = m_MultiDraws.Materials.size() * sizeof(MaterialData);
+		auto indirect_size = m_MultiDraws.IndirectCommands.size() * sizeof(DrawIndirectCommand);
+
+		// each allocation loses at most MaxAlignment bytes to its alignment
+		m_UploadRing.BeginFrame(instance_size + draw_data_size + material_data_size + indirect_size + 4 * OpenGL45UploadRing::MaxAlignment);
+
+		if (instance_size > 0) {
+			auto instances = m_UploadRing.Allocate(instance_size, alignof(Math::Matrix4));
+			std::memcpy(instances.Data, m_InstanceTransforms.data(), instance_size);
+			m_InstanceDataOffset = instances.Offset;
+		}
+
+		if (m_MultiDraws.Batches.empty()) {
+			m_UploadRing.Flush();
+			return;
+		}
+		ReserveDrawIndices(m_MultiDraws.DrawData.size());
+
+		auto draw_data = m_UploadRing.Allocate(draw_data_size, OpenGL45UploadRing::MaxAlignment);
+		std::memcpy(draw_data.Data, m_MultiDraws.DrawData.data(), draw_data_size);
+		auto material_data = m_UploadRing.Allocate(material_data_size, OpenGL45UploadRing::MaxAlignment);
+		std::memcpy(material_data.Data, m_MultiDraws.Materials.data(), material_data_size);
+		auto indirect_commands = m_UploadRing.Allocate(indirect_size, alignof(DrawIndirectCommand));
+		std::memcpy(indirect_commands.Data, m_MultiDraws.IndirectCommands.data(), indirect_size);
+		m_IndirectDataOffset = indirect_commands.Offset;
+		m_UploadRing.Flush();
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_UploadRing.GetBuffer());
+		glBindBufferRange(
+			GL_SHADER_STORAGE_BUFFER,
+			ShaderConstants::DrawDataBinding,
+			m_UploadRing.GetBuffer(),
+			static_cast<GLintptr>(draw_data.Offset),
+			static_cast<GLsizeiptr>(draw_data_size)
+		);
+		glBindBufferRange(
+			GL_SHADER_STORAGE_BUFFER,
+			ShaderConstants::MaterialDataBinding,
+			m_UploadRing.GetBuffer(),
+			static_cast<GLintptr>(material_data.Offset),
+			static_cast<GLsizeiptr>(material_data_size)
 		);
 	}
 
 	Handle OpenGL45Renderer::CreateMaterial(Handle shader_handle, Vortex::Graphics::Blending::Enum blending, OnMaterialBindFn on_material_bind) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateMaterial called while frames are in flight, call WaitIdle first.")
 		Material material{};
 		material.ShaderHandle = shader_handle;
 		material.Blending = blending;
@@ -1182,6 +1549,7 @@ namespace Vortex::Graphics {
 		return handle;
 	}
 	void OpenGL45Renderer::DestroyMaterial(Handle material_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyMaterial called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_MaterialChecks(material_handle))
 
 		const auto& material = m_DataMap.Get<Material>(material_handle);
@@ -1195,6 +1563,7 @@ namespace Vortex::Graphics {
 		DepthTesting::Enum depth_test,
 		Handle framebuffer_handle
 	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateView called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_FrameBufferChecks(framebuffer_handle))
 		View view{};
 		view.ProjectionMatrix = projection_matrix;
@@ -1207,6 +1576,7 @@ namespace Vortex::Graphics {
 		return handle;
 	}
 	void OpenGL45Renderer::DestroyView(Handle view_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyView called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_ViewChecks(view_handle))
 		const auto& view = m_DataMap.Get<View>(view_handle);
 
@@ -1220,6 +1590,7 @@ namespace Vortex::Graphics {
 		float clear_depth,
 		Int32 clear_stencil
 	) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] CreateDrawSurface called while frames are in flight, call WaitIdle first.")
 		DrawSurface surface{};
 		surface.Area = area;
 		surface.ClearColor = clear_color;
@@ -1229,45 +1600,53 @@ namespace Vortex::Graphics {
 		return handle;
 	}
 	void OpenGL45Renderer::DestroyDrawSurface(Handle draw_surface_handle) {
+		VORTEX_ASSERT_MSG(d_ResourceThreadChecks(), "[Renderer] DestroyDrawSurface called while frames are in flight, call WaitIdle first.")
 		VORTEX_ASSERT(d_DrawSurfaceChecks(draw_surface_handle))
 		m_DataMap.Destroy(draw_surface_handle);
 	}
 
-	void OpenGL45Renderer::NextFrame() {
+	void OpenGL45Renderer::BeginFrame() {
+		// GLFW events are polled on the main thread, also when pipelined
 		glfwPollEvents();
-		if (!m_ComputeCommands.empty()) {
-			ProcessComputeCommands();
-			m_ComputeCommands.clear();
+
+		VORTEX_DEBUG_PROFILER_COUNTER_SET("Renderer Live Handles", m_DataMap.d_Size - 1) // minus NullHandle
+	}
+	void OpenGL45Renderer::ExecuteFrame(std::vector<DrawCommand>& draw_commands, std::vector<ComputeCommand>& compute_commands) {
+		// names may have been deleted and reused since the last frame
+		m_StateCache.Invalidate();
+		m_StateCache.ResetCounters();
+		FillMappedBuffers();
+
+		if (!compute_commands.empty()) {
+			ProcessComputeCommands(compute_commands);
 		}
-		if (!m_DrawCommands.empty()) {
-			SortDrawCommands();
-			VORTEX_ASSERT(d_DrawCommandChecks())
-			ProcessDrawCommands();
-			m_DrawCommands.clear();
+		if (!draw_commands.empty()) {
+			SortDrawCommands(draw_commands);
+			VORTEX_ASSERT(d_DrawCommandChecks(draw_commands))
+			GatherInstanceTransforms(draw_commands, m_InstanceTransforms);
+			BuildMultiDraws(draw_commands, m_MultiDraws);
+			UploadFrameData();
+			ProcessDrawCommands(draw_commands, m_MultiDraws, m_InstanceTransforms.size());
+			glfwSwapBuffers(m_CurentWindowContext);
+		} else {
+			m_UploadRing.BeginFrame(0);
 		}
+		m_UploadRing.EndFrame();
+
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer State Calls Issued", m_StateCache.GetCounters().Issued)
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer State Calls Filtered", m_StateCache.GetCounters().Filtered)
 	}
-	void OpenGL45Renderer::OnEvent(const Event& event) {
-		if (!EventType::IsWindow(event.Type)) {
-			if (event.Type == EventType::WindowResize) {
-				auto& view = m_DataMap.Get<View>(event.WindowResize.Handle);
-				view.ProjectionMatrix.SetOrthographic(
-					0.0f,
-					static_cast<float>(event.WindowResize.Size.x),
-					static_cast<float>(event.WindowResize.Size.y),
-					0.0f,
-					-1000.0f,
-					1000.0f
-				);
-				view.Viewport.width = event.WindowResize.Size.x;
-				view.Viewport.height = event.WindowResize.Size.y;
-			}
-		}
+	void OpenGL45Renderer::AcquireContext() {
+		glfwMakeContextCurrent(m_CurentWindowContext);
 	}
-	void OpenGL45Renderer::ProcessComputeCommands() {
-		for (const auto& cmd : m_ComputeCommands) {
+	void OpenGL45Renderer::ReleaseContext() {
+		glfwMakeContextCurrent(nullptr);
+	}
+	void OpenGL45Renderer::ProcessComputeCommands(const std::vector<ComputeCommand>& compute_commands) {
+		for (const auto& cmd : compute_commands) {
 			const auto& compute_shader = m_DataMap.Get<ComputeShader>(cmd.ComputeShaderHandle);
 			auto gl_shader_id = static_cast<GLuint>(0);// gl shader id;
-			glUseProgram(gl_shader_id);
+			m_StateCache.UseProgram(gl_shader_id);
 
 			if (compute_shader.OnBind != nullptr) {
 				compute_shader.OnBind(*this, compute_shader);
@@ -1276,237 +1655,58 @@ namespace Vortex::Graphics {
 		}
 		glMemoryBarrier(GL_ALL_BARRIER_BITS);
 	}
-	void OpenGL45Renderer::SortDrawCommands() {
-		for (auto& cmd :  m_DrawCommands) {
-			ViewLayer::Enum cmd_view_layer{GetSortingKeyViewLayer(cmd.Key)};
-
-			Handle cmd_draw_surface_handle{Map::NullHandle};
-			Blending::Enum cmd_blending{Blending::Count};
-			Handle cmd_material_handle{Map::NullHandle};
-			GetDrawKeyData(cmd.Key, cmd_draw_surface_handle, cmd_blending, cmd_material_handle);
-
-			//calculate depths
-			if (cmd_view_layer != ViewLayer::PostProcess && m_DataMap.Is<View>(cmd.DrawHandle)) {
-				Handle view_handle = cmd.DrawHandle;
-
-				Math::Vector3 view_position;
-				m_DataMap.Get<View>(view_handle).ViewMatrix.Extract3DTranslation(view_position);
-
-				Math::Vector3 mesh_position;
-				cmd.TransformMatrix.Extract3DTranslation(mesh_position);
-
-				float distance{Math::Vector3::Distance(mesh_position, view_position)};
-
-				SetDrawKeyDepth(cmd.Key, static_cast<UInt16>(distance));
-
-#ifdef VORTEX_DEBUG
-				cmd.d_Depth = static_cast<UInt16>(distance);
-#endif
+	void OpenGL45Renderer::OnBindView(Handle draw_handle, const View& view) {
+		// - Window
+		//		Set render context to window
+		if (m_DataMap.Is<Window>(draw_handle)) {
+			auto glfw_window_ptr = m_DataMap.Get<Window>(draw_handle).AdditionalData.Layout<GLFWwindow*>();
+			if (m_CurentWindowContext != glfw_window_ptr) {
+				glfwSwapBuffers(m_CurentWindowContext);
+				m_CurentWindowContext = glfw_window_ptr;
+				m_StateCache.Invalidate();
 			}
 		}
 
-		std::sort(
-			m_DrawCommands.begin(), m_DrawCommands.end(),
-			[](const DrawCommand& lhs, const DrawCommand& rhs) {
-				if (lhs.DrawHandle < rhs.DrawHandle) {
-					return false;
-				} else {
-					return lhs.Key < rhs.Key;
-				}
-			}
+		GLuint gl_framebuffer_id{0};
+		if (view.FramebufferHandle != Map::NullHandle) {
+			gl_framebuffer_id = m_DataMap.Get<FrameBuffer>(view.FramebufferHandle).AdditionalData.Layout<GLuint>();
+		}
+		SetViewState(m_StateCache, view, gl_framebuffer_id);
+	}
+	void OpenGL45Renderer::OnBindDrawSurface(const DrawSurface& draw_surface, const View& view) {
+		SetDrawSurfaceState(m_StateCache, draw_surface, view);
+		glClearColor(
+			draw_surface.ClearColor.r,
+			draw_surface.ClearColor.g,
+			draw_surface.ClearColor.b,
+			draw_surface.ClearColor.a
 		);
+		glClearDepthf(draw_surface.ClearDepth);
+		glClearStencil(draw_surface.ClearStencil);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 	}
+	void OpenGL45Renderer::OnBindMaterial(const Material& material, const Math::Matrix4& view_matrix, const Math::Matrix4& projection_matrix) {
+		SetMaterialState(m_StateCache, material);
 
-	void OpenGL45Renderer::ProcessDrawCommands() {
-		Handle current_draw_handle{Map::NullHandle};
-
-		Handle current_view_handle{Map::NullHandle};
-		Math::Matrix4 current_view_matrix = Math::Matrix4::Identity();
-		Math::Matrix4 current_projection_matrix = Math::Matrix4::Identity();
-		Math::RectangleInt current_viewport{0, 0, 0, 0};
-
-		Handle current_draw_surface_handle{Map::NullHandle};
-		ViewLayer::Enum current_view_layer{ViewLayer::Count};
-		Blending::Enum current_blending{Blending::Count};
-		Handle current_material_handle{Map::NullHandle};
-		Handle current_material_shader_handle{Map::NullHandle};
-
-		GLFWwindow* glfw_window_ptr;
-
-		for (const auto& cmd :  m_DrawCommands) {
-			//draw handle is either window or view
-			if (current_draw_handle != cmd.DrawHandle) {
-				current_draw_handle = cmd.DrawHandle;
-
-				// get view handle from window or command
-				if (m_DataMap.Is<Window>(cmd.DrawHandle)) {
-					// - Window
-					//		Set render context to window
-
-					const auto& window = m_DataMap.Get<Window>(cmd.DrawHandle);
-					glfw_window_ptr = window.AdditionalData.Layout<GLFWwindow*>();
-					if (m_CurentWindowContext != glfw_window_ptr) {
-						glfwSwapBuffers(m_CurentWindowContext);
-						m_CurentWindowContext = glfw_window_ptr;
-					}
-
-					current_view_handle = window.DefaultViewHandle;
-				} else {
-					current_view_handle = cmd.DrawHandle;
-				}
-
-				// - View
-				//		Bind Framebuffer
-				//		Store ProjectionMatrix
-				//		Store Viewport
-
-				const auto& view = m_DataMap.Get<View>(current_view_handle);
-				current_viewport = view.Viewport;
-				current_projection_matrix = view.ProjectionMatrix;
-
-				if (view.FramebufferHandle != Map::NullHandle) {
-					const auto& framebuffer = m_DataMap.Get<FrameBuffer>(view.FramebufferHandle);
-					auto gl_framebuffer_id = framebuffer.AdditionalData.Layout<GLuint>();
-					glBindFramebuffer(GL_FRAMEBUFFER, gl_framebuffer_id);
-					glDisable(GL_SCISSOR_TEST);
-				} else {
-					glBindFramebuffer(GL_FRAMEBUFFER, 0);
-					glEnable(GL_SCISSOR_TEST);
-				}
-
-				glViewport(
-					current_viewport.x,
-					current_viewport.y,
-					current_viewport.width,
-					current_viewport.height
-				);
-
-				//Set DepthTesting
-				if (view.DepthTest == DepthTesting::Disabled) {
-					glDisable(GL_DEPTH_TEST);
-				} else {
-					glEnable(GL_DEPTH_TEST);
-					glDepthMask(GL_TRUE);
-					glDepthFunc(DepthTesting::ToGLType[view.DepthTest]);
-				}
-			}
-
-			ViewLayer::Enum cmd_view_layer{GetSortingKeyViewLayer(cmd.Key)};
-
-			// - ViewLayer
-			//		Set View Matrix
-			//		Apply PostProcess
-			if (current_view_layer != cmd_view_layer) {
-				current_view_layer = cmd_view_layer;
-
-				if (current_view_layer == ViewLayer::HUD) {
-					current_view_matrix = Vortex::Math::Matrix4::Identity();
-
-				} else if (current_view_layer == ViewLayer::World) {
-					const auto& view = m_DataMap.Get<View>(current_view_handle);
-					current_view_matrix = view.ViewMatrix;
-					current_view_matrix.Invert();
-
-				} else if (current_view_layer == ViewLayer::PostProcess) {
-					Handle cmd_post_process_handle{Map::NullHandle};
-					GetPostProcessKeyData(cmd.Key, cmd_post_process_handle);
-					/*
-					const auto& post_process = m_DataMap.Get<PostProcess>(cmd_post_process_handle);
+		const auto& material_shader = m_DataMap.Get<Shader>(material.ShaderHandle);
+		m_StateCache.UseProgram(material_shader.AdditionalData.Layout<GLuint>());
 
-					auto gl_shader_id = *UnionCast<GLuint*>(post_process_shader.AdditionalData);
-					VORTEX_GL_CALL(glUseProgram(gl_shader_id));
+		SetConstantUniform(material.ShaderHandle, ShaderConstants::View, view_matrix.Data);
+		SetConstantUniform(material.ShaderHandle, ShaderConstants::Projection, projection_matrix.Data);
+		//SetUniform(material.ShaderHandle, ShaderConstants::ToHashedString[ShaderConstants::Resolution], res, 1);
 
-					PostProcessBinder post_process_binder{this, post_process};
-					post_process.OnBind(post_process_binder);*/
-
-					continue;
-				}
-			}
-
-			Handle cmd_draw_surface_handle{Map::NullHandle};
-			Blending::Enum cmd_blending{Blending::Count};
-			Handle cmd_material_handle{Map::NullHandle};
-			GetDrawKeyData(cmd.Key, cmd_draw_surface_handle, cmd_blending, cmd_material_handle);
-
-			// - DrawingSurface
-			//		Clear Color, Depth, Stencil
-			//		Set Draw area
-			if (current_draw_surface_handle != cmd_draw_surface_handle) {
-				current_draw_surface_handle = cmd_draw_surface_handle;
-
-				const auto& draw_surface = m_DataMap.Get<DrawSurface>(cmd_draw_surface_handle);
-				glColorMask(
-					GL_TRUE,
-					GL_TRUE,
-					GL_TRUE,
-					GL_TRUE
-				);
-				glClearColor(
-					draw_surface.ClearColor.r,
-					draw_surface.ClearColor.g,
-					draw_surface.ClearColor.b,
-					draw_surface.ClearColor.a
-				);
-
-				glScissor(
-					draw_surface.Area.x,
-					//translate scissor coordinates to top left origin
-					current_viewport.height - draw_surface.Area.height - draw_surface.Area.y,
-					draw_surface.Area.width,
-					draw_surface.Area.height
-				);
-
-				glDepthMask(GL_TRUE);
-				glClearDepthf(draw_surface.ClearDepth);
-
-				glStencilMask(GL_TRUE);
-				glClearStencil(draw_surface.ClearStencil);
-
-				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-			}
-
-			// - Material
-			//		Set Blending
-			//		SetUniform: ViewMatrix
-			//		SetUniform: ProjectionMatrix
-			if (current_material_handle != cmd_material_handle) {
-				current_material_handle = cmd_material_handle;
-				const auto& material = m_DataMap.Get<Material>(cmd_material_handle);
-
-				//Set Blending
-				if (material.Blending == Blending::Opaque) {
-					glDisable(GL_BLEND);
-					glDepthMask(GL_TRUE);
-				} else {
-					glEnable(GL_BLEND);
-					glDepthMask(GL_FALSE);
-
-					if (material.Blending == Blending::Additive) {
-						glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-					} else if (material.Blending == Blending::Subtractive) {
-						glBlendFunc(GL_DST_COLOR, GL_ZERO);
-					}
-				}
-
-				current_material_shader_handle = material.ShaderHandle;
-				const auto& material_shader = m_DataMap.Get<Shader>(current_material_shader_handle);
-				auto gl_shader_id = material_shader.AdditionalData.Layout<GLuint>();
-				glUseProgram(gl_shader_id);
-
-				SetUniform(material.ShaderHandle, ShaderConstants::ToHashedString[ShaderConstants::View], current_view_matrix.Data, 1);
-				SetUniform(material.ShaderHandle, ShaderConstants::ToHashedString[ShaderConstants::Projection], current_projection_matrix.Data, 1);
-				//SetUniform(material.ShaderHandle, ShaderConstants::ToHashedString[ShaderConstants::Resolution], res, 1);
-
-				if (material.OnBind != nullptr) {
-					material.OnBind(*this, material);
-				}
-			}
-
-			// - Draw Mesh
-			//		SetUniform: ModelMatrix
-			SetUniform(current_material_shader_handle, ShaderConstants::ToHashedString[ShaderConstants::Transform], cmd.TransformMatrix.Data, 1);
-			DrawMesh(cmd.MeshHandle);
+		if (material.OnBind != nullptr) {
+			material.OnBind(*this, material);
 		}
-		glfwSwapBuffers(m_CurentWindowContext);
+	}
+	void OpenGL45Renderer::OnDraw(const DrawCommand& draw_command, Handle shader_handle) {
+		SetConstantUniform(shader_handle, ShaderConstants::Transform, draw_command.TransformMatrix.Data);
+		DrawMesh(draw_command.MeshHandle);
+	}
+	void OpenGL45Renderer::OnDrawInstanced(Handle mesh_handle, SizeType first_instance, SizeType instance_count) {
+		DrawMeshInstanced(mesh_handle, first_instance, instance_count);
+	}
+	void OpenGL45Renderer::OnDrawMultiDraw(const MultiDrawBatch& batch) {
+		DrawMultiDrawBatch(batch);
 	}
 }
\ No newline at end of file
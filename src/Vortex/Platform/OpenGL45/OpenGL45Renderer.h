@@ -1,8 +1,12 @@
 #pragma once
+#include <unordered_map>
+
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include "OpenGL45/OpenGL45Enums.h"
+#include "OpenGL45/OpenGL45StateCache.h"
+#include "OpenGL45/OpenGL45UploadRing.h"
 #include "Vortex/Graphics/Renderer.h"
 
 namespace Vortex::Graphics {
@@ -31,6 +35,33 @@ namespace Vortex::Graphics {
 		void UpdateBuffer(Handle buffer_handle, SizeType offset, SizeType data_size, const void* data) override;
 		void GetBuffer(Handle buffer_handle, SizeType offset, SizeType data_size, void* data) override;
 		void DestroyBuffer(Handle buffer_handle) override;
+	protected:
+		//	DynamicDraw mesh buffers hold one copy of their contents per upload ring region. The first write of a
+		//	frame moves to the next region, so it never waits on draws still reading the previous contents, and
+		//	writes go straight into the persistent mapping. Whatever the frame did not write is copied over from
+		//	the previous region on the GPU before the frame is drawn.
+		struct MappedBuffer {
+			struct VertexBinding {
+				GLuint VertexArrayID;
+				GLuint BindingIndex;
+				GLsizei Stride;
+			};
+
+			Byte* Data; // mapping of all regions, Buffer::Offset is the current one
+			SizeType Region;
+			SizeType RegionFrame; // ring frame the current region was written in
+			SizeType LastReadFrames[OpenGL45UploadRing::RegionCount];
+
+			bool FillPending;
+			SizeType FillSourceOffset;
+			std::vector<std::pair<SizeType, SizeType>> WrittenRanges; // [begin, end) of the current region
+
+			std::vector<VertexBinding> Bindings; // rebound at the region offset when the region moves
+		};
+		Handle CreateMeshBuffer(BufferUsage::Enum buffer_usage, const BufferLayout& buffer_layout, SizeType count);
+		void WriteMappedBuffer(Handle buffer_handle, MappedBuffer& mapped_buffer, SizeType offset, SizeType data_size, const void* data);
+		void FillMappedBuffer(const Buffer& buffer, MappedBuffer& mapped_buffer);
+		void FillMappedBuffers();
 
 	public:
 		Handle CreateTexture2D(const Vector2HalfInt& size, PixelFormat::Enum format, const void* pixels, TextureLODFilter::Enum min_filter, TextureLODFilter::Enum mag_filter, TextureWrap::Enum wrap_s, TextureWrap::Enum wrap_t, bool create_mipmap) override;
@@ -44,6 +75,9 @@ namespace Vortex::Graphics {
 		void SetUniform(Handle shader_handle, HashedString name, const void* data, SizeType count) const override;
 		void DestroyShader(Handle shader_handle) override;
 	protected:
+		// engine uniform through Shader::ConstantUniforms, skipped when the shader does not use it
+		void SetConstantUniform(Handle shader_handle, ShaderConstants::Enum constant, const void* data) const;
+		void UploadUniform(const Shader& shader, const ShaderUniform& uniform, const void* data, SizeType count) const;
 		static GLuint CompileShaderSource(const char* source, ShaderType::Enum type);
 		static GLuint LinkShaderProgram(GLuint* shader_ids, SizeType count);
 		static ElementType::Enum FindType(GLenum gl_type);
@@ -62,6 +96,7 @@ namespace Vortex::Graphics {
 		void DestroyComputeShader(Handle handle) override;
 
 	public:
+		using Renderer::CreateMesh;
 		Handle CreateMesh(
 			Topology::Enum topology,
 			BufferUsage::Enum usage,
@@ -73,8 +108,26 @@ namespace Vortex::Graphics {
 		void SetMeshIndices(Handle mesh_handle, const UInt32* data, SizeType count) override;
 		void SetMeshData(Handle mesh_handle, SizeType index, const void* data, SizeType size) override;
 		void DrawMesh(Handle mesh_handle) const;
+		// draws instance_count instances reading transforms from first_instance on in the instance buffer
+		void DrawMeshInstanced(Handle mesh_handle, SizeType first_instance, SizeType instance_count) const;
 		void DestroyMesh(Handle mesh_handle) override;
+		Handle CreateMeshPool(
+			Topology::Enum topology,
+			BufferUsage::Enum usage,
+			const MeshLayout& layout,
+			SizeType vertex_capacity,
+			SizeType index_capacity
+		) override;
+		void DestroyMeshPool(Handle mesh_pool_handle) override;
 	protected:
+		GLuint CreateVertexArray(
+			BufferUsage::Enum usage,
+			const MeshLayout& layout,
+			SizeType vertex_capacity,
+			SizeType index_capacity,
+			Handle& index_buffer_handle,
+			std::vector<Handle>& buffer_handles
+		);
 		static void AddVertexBuffer(
 			GLuint gl_mesh_id,
 			GLuint gl_buffer_id,
@@ -106,16 +159,51 @@ namespace Vortex::Graphics {
 		void DestroyDrawSurface(Handle draw_surface_handle) override;
 
 	public:
-		void NextFrame() override;
-		void OnEvent(const Event& event) override;
+		// issued and filtered state calls of the last executed frame, read after WaitIdle when pipelined
+		inline const OpenGL45StateCache::Counters& GetStateCacheCounters() const { return m_StateCache.GetCounters(); }
 
 	protected:
-		void SortDrawCommands();
-		void ProcessDrawCommands();
-		void ProcessComputeCommands();
+		void BeginFrame() override;
+		void ExecuteFrame(std::vector<DrawCommand>& draw_commands, std::vector<ComputeCommand>& compute_commands) override;
+		void AcquireContext() override;
+		void ReleaseContext() override;
+
+		void OnBindView(Handle draw_handle, const View& view) override;
+		void OnBindDrawSurface(const DrawSurface& draw_surface, const View& view) override;
+		void OnBindMaterial(const Material& material, const Math::Matrix4& view_matrix, const Math::Matrix4& projection_matrix) override;
+		void OnDraw(const DrawCommand& draw_command, Handle shader_handle) override;
+		void OnDrawInstanced(Handle mesh_handle, SizeType first_instance, SizeType instance_count) override;
+		void OnDrawMultiDraw(const MultiDrawBatch& batch) override;
+
+		void ProcessComputeCommands(const std::vector<ComputeCommand>& compute_commands);
+
+		void DrawMultiDrawBatch(const MultiDrawBatch& batch) const;
+
+		void ReserveDrawIndices(SizeType count);
+		// writes the frame's instance and multi draw data into its upload ring region
+		void UploadFrameData();
 
 	protected:
 		GLFWwindow* m_CurentWindowContext;
 		bool m_FirstTime;
+
+		// const draw and uniform functions bind through it
+		mutable OpenGL45StateCache m_StateCache;
+
+		// per-frame data, fenced per frame, also paces the regions of the mapped buffers
+		OpenGL45UploadRing m_UploadRing;
+		std::unordered_map<Handle, MappedBuffer> m_MappedBuffers;
+		std::vector<Handle> m_PendingFills;
+
+		// per-instance transforms of the frame, DrawMeshInstanced binds them at ShaderConstants::InstanceTransformLocation
+		std::vector<Math::Matrix4> m_InstanceTransforms;
+		SizeType m_InstanceDataOffset{0};
+
+		// multi draw data of the frame, draw indices 0..n are bound to every vertex array at ShaderConstants::DrawIndexLocation
+		constexpr static SizeType InitialDrawIndexCapacity = 256;
+		GLuint m_DrawIndexBuffer{0};
+		SizeType m_DrawIndexCapacity{0};
+		MultiDrawList m_MultiDraws;
+		SizeType m_IndirectDataOffset{0};
 	};
 }
\ No newline at end of file
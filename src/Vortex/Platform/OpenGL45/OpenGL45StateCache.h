@@ -0,0 +1,109 @@
+#pragma once
+#include <glad/glad.h>
+
+#include "OpenGL45/OpenGL45Enums.h"
+#include "Vortex/Graphics/RenderStateCache.h"
+
+namespace Vortex::Graphics {
+	//	GL calls for the state RenderStateCache tracks, a setter only reaches the driver when the cache does not filter it.
+	//	Same setters as RenderStateCache, so the Renderer state helpers (SetViewState...) drive both.
+	class OpenGL45StateCache {
+	public:
+		using Counters = RenderStateCache::Counters;
+
+	public:
+		inline void Invalidate() { m_State.Invalidate(); }
+		inline void ResetCounters() { m_State.ResetCounters(); }
+		inline const Counters& GetCounters() const { return m_State.GetCounters(); }
+
+	public:
+		inline void SetBlend(bool enabled) {
+			if (m_State.SetBlend(enabled)) {
+				if (enabled) {
+					glEnable(GL_BLEND);
+				} else {
+					glDisable(GL_BLEND);
+				}
+			}
+		}
+		inline void SetBlendMode(Blending::Enum blending) {
+			if (m_State.SetBlendMode(blending)) {
+				glBlendFunc(Blending::ToGLSourceFactor[blending], Blending::ToGLDestinationFactor[blending]);
+			}
+		}
+		inline void SetDepthTest(bool enabled) {
+			if (m_State.SetDepthTest(enabled)) {
+				if (enabled) {
+					glEnable(GL_DEPTH_TEST);
+				} else {
+					glDisable(GL_DEPTH_TEST);
+				}
+			}
+		}
+		inline void SetDepthMask(bool enabled) {
+			if (m_State.SetDepthMask(enabled)) {
+				glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+			}
+		}
+		inline void SetDepthFunc(DepthTesting::Enum depth_test) {
+			if (m_State.SetDepthFunc(depth_test)) {
+				glDepthFunc(DepthTesting::ToGLType[depth_test]);
+			}
+		}
+		inline void SetStencilMask(GLuint mask) {
+			if (m_State.SetStencilMask(mask)) {
+				glStencilMask(mask);
+			}
+		}
+		inline void SetColorMask(bool enabled) {
+			if (m_State.SetColorMask(enabled)) {
+				auto gl_enabled = enabled ? GL_TRUE : GL_FALSE;
+				glColorMask(gl_enabled, gl_enabled, gl_enabled, gl_enabled);
+			}
+		}
+		inline void SetScissorTest(bool enabled) {
+			if (m_State.SetScissorTest(enabled)) {
+				if (enabled) {
+					glEnable(GL_SCISSOR_TEST);
+				} else {
+					glDisable(GL_SCISSOR_TEST);
+				}
+			}
+		}
+		inline void SetScissor(Int32 x, Int32 y, Int32 width, Int32 height) {
+			if (m_State.SetScissor(x, y, width, height)) {
+				glScissor(x, y, width, height);
+			}
+		}
+		inline void SetViewport(Int32 x, Int32 y, Int32 width, Int32 height) {
+			if (m_State.SetViewport(x, y, width, height)) {
+				glViewport(x, y, width, height);
+			}
+		}
+
+	public:
+		inline void UseProgram(GLuint program_id) {
+			if (m_State.UseProgram(program_id)) {
+				glUseProgram(program_id);
+			}
+		}
+		inline void BindVertexArray(GLuint vertex_array_id) {
+			if (m_State.BindVertexArray(vertex_array_id)) {
+				glBindVertexArray(vertex_array_id);
+			}
+		}
+		inline void BindFramebuffer(GLuint framebuffer_id) {
+			if (m_State.BindFramebuffer(framebuffer_id)) {
+				glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id);
+			}
+		}
+		inline void BindTextureUnit(GLuint unit, GLuint texture_id) {
+			if (m_State.BindTextureUnit(unit, texture_id)) {
+				glBindTextureUnit(unit, texture_id);
+			}
+		}
+
+	private:
+		RenderStateCache m_State;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <algorithm>
+
+#include "OpenGL45UploadRing.h"
+
+#include "Vortex/Common/Console.h"
+#include "Vortex/Debug/Profiler.h"
+
+namespace Vortex::Graphics {
+	void OpenGL45UploadRing::Create(SizeType region_size) {
+		VORTEX_ASSERT(m_Buffer == 0)
+
+		m_RegionSize = (region_size + MaxAlignment - 1) / MaxAlignment * MaxAlignment;
+		auto gl_size = static_cast<GLsizeiptr>(m_RegionSize * RegionCount);
+
+		glCreateBuffers(1, &m_Buffer);
+		glNamedBufferStorage(m_Buffer, gl_size, nullptr, MappingFlags);
+		m_Data = static_cast<Byte*>(glMapNamedBufferRange(m_Buffer, 0, gl_size, MappingFlags));
+		m_Mapped = m_Data != nullptr;
+		if (!m_Mapped) {
+			// storage flags are immutable, the fallback needs a buffer that accepts glNamedBufferSubData
+			Console::WriteError("[OpenGL] Error mapping upload ring of %zu bytes, uploading with glNamedBufferSubData.", m_RegionSize * RegionCount);
+			glDeleteBuffers(1, &m_Buffer);
+			glCreateBuffers(1, &m_Buffer);
+			glNamedBufferStorage(m_Buffer, gl_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+			m_Staging.resize(m_RegionSize * RegionCount);
+			m_Data = m_Staging.data();
+		}
+	}
+	void OpenGL45UploadRing::Destroy() {
+		for (auto& fence : m_Fences) {
+			if (fence != nullptr) {
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+		if (m_Buffer != 0) {
+			if (m_Mapped) {
+				glUnmapNamedBuffer(m_Buffer);
+			}
+			glDeleteBuffers(1, &m_Buffer);
+			m_Buffer = 0;
+			m_Data = nullptr;
+		}
+	}
+
+	void OpenGL45UploadRing::BeginFrame(SizeType region_size) {
+		auto region = m_Frame % RegionCount;
+		if (m_Fences[region] != nullptr) {
+			WaitForSync(m_Fences[region]);
+			glDeleteSync(m_Fences[region]);
+			m_Fences[region] = nullptr;
+		}
+
+		if (region_size > m_RegionSize) {
+			// the new buffer replaces every region, so all frames still reading the old one have to finish
+			for (auto& fence : m_Fences) {
+				if (fence != nullptr) {
+					WaitForSync(fence);
+					glDeleteSync(fence);
+					fence = nullptr;
+				}
+			}
+			auto new_region_size = std::max(region_size, m_RegionSize * 2);
+			Destroy();
+			Create(new_region_size);
+		}
+
+		m_RegionBegin = region * m_RegionSize;
+		m_Cursor = m_RegionBegin;
+		m_RegionEnd = m_RegionBegin + m_RegionSize;
+	}
+	OpenGL45UploadRing::Allocation OpenGL45UploadRing::Allocate(SizeType size, SizeType alignment) {
+		VORTEX_ASSERT(alignment > 0 && alignment <= MaxAlignment)
+		auto offset = (m_Cursor + alignment - 1) / alignment * alignment;
+		VORTEX_ASSERT_MSG(offset + size <= m_RegionEnd, "Upload ring region is smaller than announced in BeginFrame.")
+
+		m_Cursor = offset + size;
+		return Allocation{m_Data + offset, offset};
+	}
+	void OpenGL45UploadRing::Flush() {
+		if (m_Mapped || m_Cursor == m_RegionBegin) {
+			return;
+		}
+		glNamedBufferSubData(
+			m_Buffer,
+			static_cast<GLintptr>(m_RegionBegin),
+			static_cast<GLsizeiptr>(m_Cursor - m_RegionBegin),
+			m_Data + m_RegionBegin
+		);
+	}
+	void OpenGL45UploadRing::EndFrame() {
+		auto region = m_Frame % RegionCount;
+		VORTEX_ASSERT(m_Fences[region] == nullptr)
+
+		m_Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_FenceFrames[region] = m_Frame;
+		++m_Frame;
+	}
+
+	void OpenGL45UploadRing::WaitForFrame(SizeType frame) {
+		VORTEX_ASSERT(frame < m_Frame)
+		auto region = frame % RegionCount;
+
+		// a fence is only kept until its region is reused, older frames were waited on then
+		if (m_Fences[region] != nullptr && m_FenceFrames[region] == frame) {
+			WaitForSync(m_Fences[region]);
+			glDeleteSync(m_Fences[region]);
+			m_Fences[region] = nullptr;
+		}
+	}
+	void OpenGL45UploadRing::WaitForSync(GLsync sync) {
+		constexpr static GLuint64 timeout = 1000000000; // 1s, then log and keep waiting
+
+		auto result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+			return;
+		}
+
+		VORTEX_DEBUG_PROFILER_COUNTER("Renderer Upload Ring Stalls", 1)
+		while ((result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout)) == GL_TIMEOUT_EXPIRED) {
+			Console::WriteWarning("[OpenGL] Waiting for the GPU to release an upload region.");
+		}
+		if (result == GL_WAIT_FAILED) {
+			Console::WriteError("[OpenGL] Waiting for an upload fence failed.");
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "Vortex/Memory/Memory.h"
+
+namespace Vortex::Graphics {
+	//	Persistently mapped buffer for data written once per frame (instance transforms, multi draw data).
+	//	Split into RegionCount regions used round robin by consecutive frames, a frame sub-allocates linearly from
+	//	its region and writes straight into the mapping. Each region is fenced at the end of its frame and waited
+	//	on before it is reused, so the CPU runs at most RegionCount - 1 frames ahead of the GPU.
+	//	When the buffer can not be mapped the frame writes into a CPU copy instead and Flush uploads it.
+	//	GL calls need the context, the owner destroys the ring while it is current.
+	class OpenGL45UploadRing {
+	public:
+		constexpr static SizeType RegionCount = 3;
+		// largest offset alignment GL allows for buffer bindings, regions start at multiples of it
+		constexpr static SizeType MaxAlignment = 256;
+		constexpr static GLbitfield MappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		struct Allocation {
+			Byte* Data;
+			SizeType Offset; // in the GL buffer
+		};
+
+	public:
+		OpenGL45UploadRing() = default;
+		OpenGL45UploadRing(const OpenGL45UploadRing&) = delete;
+		OpenGL45UploadRing& operator=(const OpenGL45UploadRing&) = delete;
+
+	public:
+		void Create(SizeType region_size);
+		void Destroy();
+
+		// waits until the frame's region is free, creates or grows the buffer when region_size bytes do not fit
+		void BeginFrame(SizeType region_size);
+		Allocation Allocate(SizeType size, SizeType alignment);
+		// after writing the allocations and before the draws reading them, uploads them when the buffer is not mapped
+		void Flush();
+		void EndFrame();
+
+		// blocks until the GPU finished the frame, frames RegionCount behind the current one are finished already
+		void WaitForFrame(SizeType frame);
+
+		inline GLuint GetBuffer() const { return m_Buffer; }
+		// the frame being recorded, counts EndFrame calls
+		inline SizeType GetFrame() const { return m_Frame; }
+
+	private:
+		static void WaitForSync(GLsync sync);
+
+	private:
+		GLuint m_Buffer{0};
+		Byte* m_Data{nullptr};
+		bool m_Mapped{false};
+		std::vector<Byte> m_Staging; // stands in for the mapping when mapping failed
+		SizeType m_RegionSize{0};
+		SizeType m_RegionBegin{0};
+		SizeType m_Cursor{0};
+		SizeType m_RegionEnd{0};
+
+		SizeType m_Frame{0};
+		GLsync m_Fences[RegionCount]{};
+		SizeType m_FenceFrames[RegionCount]{};
+	};
+}
@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "Vortex/Common/Console.h"
+#include "Vortex/Common/FlightRecorder.h"
+
+//	Prints the records of a flight recorder file (Console::EnableFlightRecorder) in the console log format,
+//	prefixed with the seconds since the recorder was opened.
+int main(int argc, char** argv) {
+	using namespace Vortex;
+
+	std::filesystem::path input_path;
+	std::filesystem::path output_path;
+	for (int i = 1; i < argc; ++i) {
+		std::string argument{argv[i]};
+		if (argument == "--out" && i + 1 < argc) {
+			output_path = argv[++i];
+		} else if (input_path.empty() && argument[0] != '-') {
+			input_path = argument;
+		} else {
+			input_path.clear();
+			break;
+		}
+	}
+	if (input_path.empty()) {
+		std::cerr << "Usage: VortexFlightRecorderDecoder <file> [--out file]\n";
+		return 2;
+	}
+
+	std::ofstream output_file;
+	if (!output_path.empty()) {
+		output_file.open(output_path);
+		if (!output_file.is_open()) {
+			std::cerr << "Can not open " << output_path << "\n";
+			return 1;
+		}
+	}
+	std::ostream& output = output_path.empty() ? std::cout : output_file;
+
+	SizeType record_count{0};
+	char text[4096];
+	char prefix[128];
+	bool decoded = FlightRecorder::Decode(input_path, [&](const FlightRecorder::DecodedRecord& record) {
+		if (record.FormatID == FlightRecorder::TextFormatID) {
+			SizeType length = record.DataSize < sizeof(text) - 1 ? record.DataSize : sizeof(text) - 1;
+			std::memcpy(text, record.Data, length);
+			text[length] = '\0';
+		} else if (record.Format != nullptr) {
+			LogFormat::Format(text, sizeof(text), record.Format, record.Data, record.DataSize);
+		} else {
+			snprintf(text, sizeof(text), "<format %u missing from the recorder file>", record.FormatID);
+		}
+		++record_count;
+
+		if (record.Append) {
+			output << text;
+			return;
+		}
+
+		const char* type = record.Type <= EntryType::Error ? EntryType::ToString[record.Type] : "Unknown";
+		auto seconds = static_cast<double>(record.Timestamp) * 1e-9;
+		if (record.Category == LogCategory::General || record.Category >= LogCategory::Count) {
+			snprintf(prefix, sizeof(prefix), "\n[%12.6f] [%-7s] ", seconds, type);
+		} else {
+			snprintf(prefix, sizeof(prefix), "\n[%12.6f] [%-7s] [%s] ", seconds, type, LogCategory::ToString[record.Category]);
+		}
+		output << prefix << text;
+	});
+
+	if (!decoded) {
+		std::cerr << input_path << " is not a flight recorder file\n";
+		return 1;
+	}
+	output << "\n";
+	std::cerr << record_count << " records\n";
+	return 0;
+}